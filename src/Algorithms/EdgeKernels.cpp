@@ -0,0 +1,243 @@
+/*
+ *
+ *    MultiBoost - Multi-purpose boosting package
+ *
+ *    Copyright (C)        AppStat group
+ *                         Laboratoire de l'Accelerateur Lineaire
+ *                         Universite Paris-Sud, 11, CNRS
+ *
+ *    This file is part of the MultiBoost library
+ *
+ *    This library is free software; you can redistribute it 
+ *    and/or modify it under the terms of the GNU General Public
+ *    License as published by the Free Software Foundation
+ *    version 2.1 of the License.
+ *
+ *    This library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *    General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public
+ *    License along with this library; if not, write to the Free Software
+ *    Foundation, Inc., 51 Franklin St, 5th Floor, Boston, MA 02110-1301 USA
+ *
+ *    Contact: : multiboost@googlegroups.com
+ *
+ *    For more information and up-to-date version, please visit
+ *        
+ *                       http://www.multiboost.org/
+ *
+ */
+
+
+
+#include "EdgeKernels.h"
+
+#include <cmath> // for fabs
+
+// SIMD versions: gcc/clang on x86 only, with double precision edges
+#if ( defined(__GNUC__) && ( defined(__x86_64__) || defined(__i386__) ) && !defined(ALPHAREALFLOAT) )
+#define MB_EDGE_KERNELS_X86
+#include <immintrin.h>
+#endif
+
+namespace MultiBoost {
+
+    namespace EdgeKernels {
+
+        // ------------------------------------------------------------------------------
+        // the sum is done in four interleaved partial sums in every implementation:
+        // class l goes to sums[l % 4], and the result is (s0 + s1) + (s2 + s3)
+
+        static AlphaReal subtractAndSumAbsScalar( AlphaReal* edges, const AlphaReal* delta, 
+                                                  int numClasses, AlphaReal halfTheta )
+        {
+            AlphaReal sums[4] = { 0, 0, 0, 0 };
+            for (int l = 0; l < numClasses; ++l)
+            {
+                if ( delta )
+                    edges[l] -= delta[l];
+                const AlphaReal absEdge = fabs( edges[l] );
+                if ( absEdge > halfTheta )
+                    sums[l & 3] += absEdge;
+            }
+            return (sums[0] + sums[1]) + (sums[2] + sums[3]);
+        }
+
+        // ------------------------------------------------------------------------------
+
+        static void subtractScalar( AlphaReal* edges, const AlphaReal* delta, int numClasses )
+        {
+            for (int l = 0; l < numClasses; ++l)
+                edges[l] -= delta[l];
+        }
+
+#ifdef MB_EDGE_KERNELS_X86
+
+        // ------------------------------------------------------------------------------
+
+        __attribute__((target("sse2")))
+        static AlphaReal subtractAndSumAbsSSE2( AlphaReal* edges, const AlphaReal* delta, 
+                                                int numClasses, AlphaReal halfTheta )
+        {
+            const __m128d signMask = _mm_set1_pd( -0.0 );
+            const __m128d theta = _mm_set1_pd( halfTheta );
+            __m128d sums01 = _mm_setzero_pd();
+            __m128d sums23 = _mm_setzero_pd();
+
+            int l = 0;
+            for (; l + 4 <= numClasses; l += 4)
+            {
+                __m128d e01 = _mm_loadu_pd( edges + l );
+                __m128d e23 = _mm_loadu_pd( edges + l + 2 );
+                if ( delta )
+                {
+                    e01 = _mm_sub_pd( e01, _mm_loadu_pd( delta + l ) );
+                    e23 = _mm_sub_pd( e23, _mm_loadu_pd( delta + l + 2 ) );
+                    _mm_storeu_pd( edges + l, e01 );
+                    _mm_storeu_pd( edges + l + 2, e23 );
+                }
+                const __m128d a01 = _mm_andnot_pd( signMask, e01 );
+                const __m128d a23 = _mm_andnot_pd( signMask, e23 );
+                sums01 = _mm_add_pd( sums01, _mm_and_pd( a01, _mm_cmpgt_pd( a01, theta ) ) );
+                sums23 = _mm_add_pd( sums23, _mm_and_pd( a23, _mm_cmpgt_pd( a23, theta ) ) );
+            }
+
+            AlphaReal sums[4];
+            _mm_storeu_pd( sums, sums01 );
+            _mm_storeu_pd( sums + 2, sums23 );
+
+            for (; l < numClasses; ++l)
+            {
+                if ( delta )
+                    edges[l] -= delta[l];
+                const AlphaReal absEdge = fabs( edges[l] );
+                if ( absEdge > halfTheta )
+                    sums[l & 3] += absEdge;
+            }
+            return (sums[0] + sums[1]) + (sums[2] + sums[3]);
+        }
+
+        // ------------------------------------------------------------------------------
+
+        __attribute__((target("sse2")))
+        static void subtractSSE2( AlphaReal* edges, const AlphaReal* delta, int numClasses )
+        {
+            int l = 0;
+            for (; l + 2 <= numClasses; l += 2)
+                _mm_storeu_pd( edges + l, _mm_sub_pd( _mm_loadu_pd( edges + l ), _mm_loadu_pd( delta + l ) ) );
+            for (; l < numClasses; ++l)
+                edges[l] -= delta[l];
+        }
+
+        // ------------------------------------------------------------------------------
+
+        __attribute__((target("avx2")))
+        static AlphaReal subtractAndSumAbsAVX2( AlphaReal* edges, const AlphaReal* delta, 
+                                                int numClasses, AlphaReal halfTheta )
+        {
+            const __m256d signMask = _mm256_set1_pd( -0.0 );
+            const __m256d theta = _mm256_set1_pd( halfTheta );
+            __m256d sums0123 = _mm256_setzero_pd();
+
+            int l = 0;
+            for (; l + 4 <= numClasses; l += 4)
+            {
+                __m256d e = _mm256_loadu_pd( edges + l );
+                if ( delta )
+                {
+                    e = _mm256_sub_pd( e, _mm256_loadu_pd( delta + l ) );
+                    _mm256_storeu_pd( edges + l, e );
+                }
+                const __m256d a = _mm256_andnot_pd( signMask, e );
+                sums0123 = _mm256_add_pd( sums0123, _mm256_and_pd( a, _mm256_cmp_pd( a, theta, _CMP_GT_OQ ) ) );
+            }
+
+            AlphaReal sums[4];
+            _mm256_storeu_pd( sums, sums0123 );
+
+            for (; l < numClasses; ++l)
+            {
+                if ( delta )
+                    edges[l] -= delta[l];
+                const AlphaReal absEdge = fabs( edges[l] );
+                if ( absEdge > halfTheta )
+                    sums[l & 3] += absEdge;
+            }
+            return (sums[0] + sums[1]) + (sums[2] + sums[3]);
+        }
+
+        // ------------------------------------------------------------------------------
+
+        __attribute__((target("avx2")))
+        static void subtractAVX2( AlphaReal* edges, const AlphaReal* delta, int numClasses )
+        {
+            int l = 0;
+            for (; l + 4 <= numClasses; l += 4)
+                _mm256_storeu_pd( edges + l, _mm256_sub_pd( _mm256_loadu_pd( edges + l ), _mm256_loadu_pd( delta + l ) ) );
+            for (; l < numClasses; ++l)
+                edges[l] -= delta[l];
+        }
+
+#endif // MB_EDGE_KERNELS_X86
+
+        // ------------------------------------------------------------------------------
+        // runtime dispatch
+
+        struct Implementation
+        {
+            const char* name;
+            AlphaReal (*subtractAndSumAbs)( AlphaReal*, const AlphaReal*, int, AlphaReal );
+            void (*subtract)( AlphaReal*, const AlphaReal*, int );
+        };
+
+        static Implementation selectImplementation()
+        {
+            Implementation impl = { "scalar", subtractAndSumAbsScalar, subtractScalar };
+#ifdef MB_EDGE_KERNELS_X86
+            __builtin_cpu_init();
+            if ( __builtin_cpu_supports("avx2") )
+            {
+                impl.name = "avx2";
+                impl.subtractAndSumAbs = subtractAndSumAbsAVX2;
+                impl.subtract = subtractAVX2;
+            }
+            else if ( __builtin_cpu_supports("sse2") )
+            {
+                impl.name = "sse2";
+                impl.subtractAndSumAbs = subtractAndSumAbsSSE2;
+                impl.subtract = subtractSSE2;
+            }
+#endif
+            return impl;
+        }
+
+        // selected once, when the program starts
+        static const Implementation implementation = selectImplementation();
+
+        // ------------------------------------------------------------------------------
+
+        void subtract( AlphaReal* edges, const AlphaReal* delta, int numClasses )
+        {
+            implementation.subtract( edges, delta, numClasses );
+        }
+
+        // ------------------------------------------------------------------------------
+
+        AlphaReal subtractAndSumAbs( AlphaReal* edges, const AlphaReal* delta, 
+                                     int numClasses, AlphaReal halfTheta )
+        {
+            return implementation.subtractAndSumAbs( edges, delta, numClasses, halfTheta );
+        }
+
+        // ------------------------------------------------------------------------------
+
+        const char* getImplementationName()
+        {
+            return implementation.name;
+        }
+
+    } // end of namespace EdgeKernels
+
+} // end of namespace MultiBoost
@@ -0,0 +1,97 @@
+/*
+ *
+ *    MultiBoost - Multi-purpose boosting package
+ *
+ *    Copyright (C)        AppStat group
+ *                         Laboratoire de l'Accelerateur Lineaire
+ *                         Universite Paris-Sud, 11, CNRS
+ *
+ *    This file is part of the MultiBoost library
+ *
+ *    This library is free software; you can redistribute it 
+ *    and/or modify it under the terms of the GNU General Public
+ *    License as published by the Free Software Foundation
+ *    version 2.1 of the License.
+ *
+ *    This library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *    General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public
+ *    License along with this library; if not, write to the Free Software
+ *    Foundation, Inc., 51 Franklin St, 5th Floor, Boston, MA 02110-1301 USA
+ *
+ *    Contact: : multiboost@googlegroups.com
+ *
+ *    For more information and up-to-date version, please visit
+ *        
+ *                       http://www.multiboost.org/
+ *
+ */
+
+
+
+/**
+ * \file EdgeKernels.h The vectorized inner loops of the stump algorithms.
+ */
+
+#ifndef __EDGE_KERNELS_H
+#define __EDGE_KERNELS_H
+
+#include "Defaults.h" // for AlphaReal
+
+namespace MultiBoost {
+
+//////////////////////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////////////////////
+
+    /**
+     * The class-wise edge kernels of the threshold search loops. The implementation
+     * (AVX2, SSE2 or scalar) is selected at runtime, depending on the CPU.
+     * All the implementations sum the classes in the same order (four interleaved
+     * partial sums), so the edges, and thus the selected stumps, do not depend on 
+     * the machine.
+     * \date 16/10/2026
+     */
+    namespace EdgeKernels {
+
+        /**
+         * Subtract \a delta from \a edges, class by class.
+         * \param edges The class-wise edges to update.
+         * \param delta The values to subtract (e.g. a row of the y * weight matrix).
+         * \param numClasses The number of classes.
+         * \date 16/10/2026
+         */
+        void subtract( AlphaReal* edges, const AlphaReal* delta, int numClasses );
+
+        /**
+         * Compute the edge of the stump from the class-wise edges: the sum of the 
+         * absolute values of the edges that are larger than \a halfTheta (all of them
+         * if \a halfTheta is zero).
+         * \param edges The class-wise edges. If \a delta is not NULL, it is subtracted
+         * from \a edges in the same pass.
+         * \param delta The values to subtract before the sum, or NULL.
+         * \param numClasses The number of classes.
+         * \param halfTheta The half of the edge offset.
+         * \return The sum of the absolute edges.
+         * \date 16/10/2026
+         */
+        AlphaReal subtractAndSumAbs( AlphaReal* edges, const AlphaReal* delta, 
+                                     int numClasses, AlphaReal halfTheta = 0 );
+
+        //! The sum of the absolute values of the edges (no update).
+        inline AlphaReal sumAbs( const AlphaReal* edges, int numClasses, AlphaReal halfTheta = 0 )
+        { return subtractAndSumAbs( const_cast<AlphaReal*>(edges), 0, numClasses, halfTheta ); }
+
+        /**
+         * The name of the implementation in use ("avx2", "sse2" or "scalar").
+         * \date 16/10/2026
+         */
+        const char* getImplementationName();
+
+    } // end of namespace EdgeKernels
+
+} // end of namespace MultiBoost
+
+#endif // __EDGE_KERNELS_H
@@ -42,6 +42,7 @@
 #include <cassert>
 
 #include "IO/InputData.h"
+#include "Algorithms/EdgeKernels.h"
 #include "Others/Rates.h"
 #include "IO/NameMap.h"
 #include "Algorithms/ConstantAlgorithm.h"
@@ -144,6 +145,24 @@ namespace MultiBoost {
 
     private:
 
+        /**
+         * Move the example \a idx to the other side of the threshold, i.e. remove its
+         * y * weight from \a edges.
+         * \date 16/10/2026
+         */
+        inline void updateEdges(InputData* pData, int idx, vector<AlphaReal>& edges)
+        {
+            const AlphaReal* weightedLabels = pData->getWeightedLabels(idx);
+            if ( weightedLabels )
+                EdgeKernels::subtract( &edges[0], weightedLabels, static_cast<int>(edges.size()) );
+            else
+            {
+                const vector<Label>& labels = pData->getLabels(idx);
+                for (vector<Label>::const_iterator lIt = labels.begin(); lIt != labels.end(); ++lIt )
+                    edges[ lIt->idx ] -= lIt->weight * lIt->y;
+            }
+        }
+
         vector<AlphaReal> _edges; //!< half of the class-wise edges
         vector<AlphaReal> _constantEdges; //!< half of the class-wise edges of the constant classifier
         vector<AlphaReal> _bestEdges; //!< half of the edges of the best found threshold.
@@ -222,7 +241,6 @@ namespace MultiBoost {
 
         AlphaReal currEdge = 0;
         AlphaReal bestEdge = -numeric_limits<AlphaReal>::max();
-        vector<Label>::const_iterator lIt;
         vector<AlphaReal> tmpEdges(numClasses);
 
         // find the best threshold (cutting point)
@@ -233,12 +251,9 @@ namespace MultiBoost {
              currentSplitPos1 != dataEnd; 
              previousSplitPos1 = currentSplitPos1, ++currentSplitPos1)
         {
-            vector<Label>& labels1 = pData->getLabels(previousSplitPos1->first);
-
             // recompute edges at the next point
             ////// Bottleneck BEGIN
-            for (lIt = labels1.begin(); lIt != labels1.end(); ++lIt )
-                _edges[ lIt->idx ] -= lIt->weight * lIt->y;
+            updateEdges(pData, previousSplitPos1->first, _edges);
             ////// Bottleneck END
 
             copy(_edges.begin(), _edges.end(), tmpEdges.begin());
@@ -251,27 +266,17 @@ namespace MultiBoost {
                      currentSplitPos2 != dataEnd; 
                      previousSplitPos2 = currentSplitPos2, ++currentSplitPos2)                               
                 {
-                    vector<Label>& labels2 = pData->getLabels(previousSplitPos2->first);
-
                     // recompute edges at the next point
                     ////// Bottleneck BEGIN
-                    for (lIt = labels2.begin(); lIt != labels2.end(); ++lIt )
-                        tmpEdges[ lIt->idx ] -= lIt->weight * lIt->y;
+                    updateEdges(pData, previousSplitPos2->first, tmpEdges);
                     ////// Bottleneck END
 
                     if ( previousSplitPos2->second != currentSplitPos2->second ) 
                     {
-                        currEdge = 0;
-
                         ////// Bottleneck BEGIN
-                        for (int l = 0; l < numClasses; ++l) { 
-                            // flip the class-wise edge if it is negative
-                            // but store the flipping bit only at the end (below**)
-                            if ( tmpEdges[l] > 0 )
-                                currEdge += tmpEdges[l];
-                            else
-                                currEdge -= tmpEdges[l];
-                        }
+                        // flip the class-wise edges if they are negative
+                        // but store the flipping bit only at the end (below**)
+                        currEdge = EdgeKernels::sumAbs( &tmpEdges[0], numClasses );
                         ////// Bottleneck END
 
                         // the current edge is the new maximum
@@ -283,8 +288,7 @@ namespace MultiBoost {
                             bestSplitPos2 = currentSplitPos2; 
                             bestPreviousSplitPos2 = previousSplitPos2; 
 
-                            for (int l = 0; l < numClasses; ++l)
-                                _bestEdges[l] = tmpEdges[l];
+                            copy(tmpEdges.begin(), tmpEdges.end(), _bestEdges.begin());
                         }
                     } //endif
                 } // endfor
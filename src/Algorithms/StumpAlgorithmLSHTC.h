@@ -42,6 +42,7 @@
 #include <cassert>
 
 #include "IO/InputData.h"
+#include "Algorithms/EdgeKernels.h"
 #include "Others/Rates.h"
 #include "IO/NameMap.h"
 #include "Algorithms/ConstantAlgorithmLSHTC.h"
@@ -303,14 +304,9 @@ namespace MultiBoost {
 
                 ////// Bottleneck BEGIN
                 if ( nor_utils::is_zero(halfTheta) ) { // we save an "if" in the loop, 20% faster
-                    for (int l = 0; l < numClasses; ++l) { 
-                        // flip the class-wise edge if it is negative
-                        // but store the flipping bit only at the end (below**)
-                        if ( _halfEdges[l] < 0 )
-                            currHalfEdge -= _halfEdges[l];
-                        else
-                            currHalfEdge += _halfEdges[l];
-                    }
+                    // flip the class-wise edges if they are negative
+                    // but store the flipping bit only at the end (below**)
+                    currHalfEdge = EdgeKernels::sumAbs( &_halfEdges[0], numClasses );
                 }
                 else {
                     for (int l = 0; l < numClasses; ++l) { 
@@ -331,8 +327,7 @@ namespace MultiBoost {
                     bestSplitPos = currentSplitPos; 
                     bestPreviousSplitPos = previousSplitPos; 
 
-                    for (int l = 0; l < numClasses; ++l)
-                        _bestHalfEdges[l] = _halfEdges[l];
+                    copy(_halfEdges.begin(), _halfEdges.end(), _bestHalfEdges.begin());
                                         
                     FeatureReal threshold = ( previousSplitPos->second + currentSplitPos->second ) / 2;
                     //cout << "Current threshold: " << threshold;
@@ -371,14 +366,9 @@ namespace MultiBoost {
 
         ////// Bottleneck BEGIN
         if ( nor_utils::is_zero(halfTheta) ) { // we save an "if" in the loop, 20% faster
-            for (int l = 0; l < numClasses; ++l) { 
-                // flip the class-wise edge if it is negative
-                // but store the flipping bit only at the end (below**)
-                if ( _halfEdges[l] > 0 )
-                    currHalfEdge -= _halfEdges[l];
-                else
-                    currHalfEdge += _halfEdges[l];
-            }
+            // flip the class-wise edges if they are positive
+            // but store the flipping bit only at the end (below**)
+            currHalfEdge = -EdgeKernels::sumAbs( &_halfEdges[0], numClasses );
         }
         else {
             for (int l = 0; l < numClasses; ++l) { 
@@ -399,8 +389,7 @@ namespace MultiBoost {
             bestPreviousSplitPosFloat = currentDataValue;
             bestSplitPosFloat = 0.0; 
                         
-            for (int l = 0; l < numClasses; ++l)
-                _bestHalfEdges[l] = _halfEdges[l];
+            copy(_halfEdges.begin(), _halfEdges.end(), _bestHalfEdges.begin());
         }
         //end of the investigation of the last non-zero elements                
 
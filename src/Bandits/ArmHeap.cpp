@@ -0,0 +1,145 @@
+/*
+ *
+ *    MultiBoost - Multi-purpose boosting package
+ *
+ *    Copyright (C)        AppStat group
+ *                         Laboratoire de l'Accelerateur Lineaire
+ *                         Universite Paris-Sud, 11, CNRS
+ *
+ *    This file is part of the MultiBoost library
+ *
+ *    This library is free software; you can redistribute it
+ *    and/or modify it under the terms of the GNU General Public
+ *    License as published by the Free Software Foundation
+ *    version 2.1 of the License.
+ *
+ *    This library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *    General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public
+ *    License along with this library; if not, write to the Free Software
+ *    Foundation, Inc., 51 Franklin St, 5th Floor, Boston, MA 02110-1301 USA
+ *
+ *    Contact: : multiboost@googlegroups.com
+ *
+ *    For more information and up-to-date version, please visit
+ *
+ *                       http://www.multiboost.org/
+ *
+ */
+
+
+#include "ArmHeap.h"
+#include <queue>
+
+namespace MultiBoost {
+//----------------------------------------------------------------
+//----------------------------------------------------------------
+
+    void ArmHeap::init( const vector< AlphaReal >& values )
+    {
+        const int numOfArms = (int)values.size();
+
+        _values = values;
+        _heap.resize( numOfArms );
+        _positions.resize( numOfArms );
+
+        for( int i=0; i < numOfArms; i++ ) place( i, i );
+
+        for( int pos = numOfArms / 2 - 1; pos >= 0; pos-- ) siftDown( pos );
+    }
+
+//----------------------------------------------------------------
+//----------------------------------------------------------------
+
+    void ArmHeap::update( int arm, AlphaReal value )
+    {
+        _values[arm] = value;
+
+        const int pos = _positions[arm];
+        siftUp( pos );
+        if ( _heap[pos] == arm ) siftDown( pos );
+    }
+
+//----------------------------------------------------------------
+//----------------------------------------------------------------
+
+    void ArmHeap::siftUp( int pos )
+    {
+        const int arm = _heap[pos];
+        while ( pos > 0 )
+        {
+            const int parent = ( pos - 1 ) / 2;
+            if ( ! isBefore( arm, _heap[parent] ) ) break;
+            place( pos, _heap[parent] );
+            pos = parent;
+        }
+        place( pos, arm );
+    }
+
+//----------------------------------------------------------------
+//----------------------------------------------------------------
+
+    void ArmHeap::siftDown( int pos )
+    {
+        const int size = (int)_heap.size();
+        const int arm = _heap[pos];
+        for( ;; )
+        {
+            int child = 2 * pos + 1;
+            if ( child >= size ) break;
+            if ( child + 1 < size && isBefore( _heap[child+1], _heap[child] ) ) child++;
+            if ( ! isBefore( _heap[child], arm ) ) break;
+            place( pos, _heap[child] );
+            pos = child;
+        }
+        place( pos, arm );
+    }
+
+//----------------------------------------------------------------
+//----------------------------------------------------------------
+
+    namespace {
+        // orders the heap positions of the frontier, the best arm on top
+        struct FrontierOrder
+        {
+            FrontierOrder( const vector< AlphaReal >& values, const vector< int >& heap ) 
+                : _values( values ), _heap( heap ) {}
+
+            bool operator()( int pos1, int pos2 ) const
+            {
+                const int a = _heap[pos1], b = _heap[pos2];
+                return _values[b] > _values[a] || ( _values[b] == _values[a] && b < a );
+            }
+
+            const vector< AlphaReal >& _values;
+            const vector< int >& _heap;
+        };
+    }
+
+    void ArmHeap::getKBestArms( int k, vector<int>& bestArms ) const
+    {
+        const int size = (int)_heap.size();
+        if ( k > size ) k = size;
+
+        bestArms.clear();
+        if ( k <= 0 ) return;
+
+        // the next best arm is always on the frontier of the already listed ones
+        priority_queue< int, vector< int >, FrontierOrder > frontier( FrontierOrder( _values, _heap ) );
+        frontier.push( 0 );
+
+        while ( (int)bestArms.size() < k )
+        {
+            const int pos = frontier.top();
+            frontier.pop();
+            bestArms.push_back( _heap[pos] );
+
+            if ( 2 * pos + 1 < size ) frontier.push( 2 * pos + 1 );
+            if ( 2 * pos + 2 < size ) frontier.push( 2 * pos + 2 );
+        }
+    }
+
+} // end namespace MultiBoost
@@ -0,0 +1,125 @@
+/*
+ *
+ *    MultiBoost - Multi-purpose boosting package
+ *
+ *    Copyright (C)        AppStat group
+ *                         Laboratoire de l'Accelerateur Lineaire
+ *                         Universite Paris-Sud, 11, CNRS
+ *
+ *    This file is part of the MultiBoost library
+ *
+ *    This library is free software; you can redistribute it
+ *    and/or modify it under the terms of the GNU General Public
+ *    License as published by the Free Software Foundation
+ *    version 2.1 of the License.
+ *
+ *    This library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *    General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public
+ *    License along with this library; if not, write to the Free Software
+ *    Foundation, Inc., 51 Franklin St, 5th Floor, Boston, MA 02110-1301 USA
+ *
+ *    Contact: : multiboost@googlegroups.com
+ *
+ *    For more information and up-to-date version, please visit
+ *
+ *                       http://www.multiboost.org/
+ *
+ */
+
+/**
+   \file ArmHeap.h An indexed binary heap over the values of the arms of the
+   UCB bandit algorithms.
+*/
+
+#ifndef _ARMHEAP_H
+#define _ARMHEAP_H
+
+#include <vector>
+#include "Defaults.h"
+
+using namespace std;
+
+//////////////////////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace MultiBoost {
+
+    /**
+     * An indexed binary max-heap over the values (the upper confidence bounds) of the 
+     * arms, stored in contiguous arrays: the heap of arm indices and the position of each 
+     * arm in it. Changing the value of an arm costs O(log N), and the k best arms are 
+     * listed in O(k log k) without touching the heap. The arms with the highest value come
+     * first, and equal values are ordered by increasing arm index.
+     * \date 16/10/2026
+     */
+    class ArmHeap
+    {
+    public:
+        ArmHeap( void ) {}
+
+        /**
+         * Build the heap. O(N).
+         * \param values The values of the arms.
+         * \date 16/10/2026
+         */
+        void init( const vector< AlphaReal >& values );
+
+        /**
+         * Change the value of an arm. O(log N).
+         * \param arm The index of the arm.
+         * \param value The new value.
+         * \date 16/10/2026
+         */
+        void update( int arm, AlphaReal value );
+
+        /**
+         * The value of an arm.
+         * \date 16/10/2026
+         */
+        AlphaReal getValue( int arm ) const { return _values[arm]; }
+
+        /**
+         * The values of the arms, in the order of the arm indices.
+         * \date 16/10/2026
+         */
+        const vector< AlphaReal >& getValues( void ) const { return _values; }
+
+        /**
+         * The arm with the highest value. O(1).
+         * \date 16/10/2026
+         */
+        int getBestArm( void ) const { return _heap[0]; }
+
+        /**
+         * The \a k arms with the highest values, best first. O(k log k).
+         * \param k The number of arms (at most the number of arms is returned).
+         * \param bestArms The indices of the arms.
+         * \date 16/10/2026
+         */
+        void getKBestArms( int k, vector<int>& bestArms ) const;
+
+    protected:
+        /**
+         * The order of the heap: true if arm \a a comes before arm \a b.
+         * \date 16/10/2026
+         */
+        bool isBefore( int a, int b ) const
+        { return _values[a] > _values[b] || ( _values[a] == _values[b] && a < b ); }
+
+        void siftUp( int pos );
+        void siftDown( int pos );
+
+        void place( int pos, int arm ) { _heap[pos] = arm; _positions[arm] = pos; }
+
+        vector< AlphaReal > _values;    // the value of each arm
+        vector< int >       _heap;      // the arms, the children of position i are 2i+1 and 2i+2
+        vector< int >       _positions; // the position of each arm in _heap
+    };
+
+} // end of namespace MultiBoost
+
+#endif
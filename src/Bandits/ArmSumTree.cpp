@@ -0,0 +1,197 @@
+/*
+ *
+ *    MultiBoost - Multi-purpose boosting package
+ *
+ *    Copyright (C)        AppStat group
+ *                         Laboratoire de l'Accelerateur Lineaire
+ *                         Universite Paris-Sud, 11, CNRS
+ *
+ *    This file is part of the MultiBoost library
+ *
+ *    This library is free software; you can redistribute it
+ *    and/or modify it under the terms of the GNU General Public
+ *    License as published by the Free Software Foundation
+ *    version 2.1 of the License.
+ *
+ *    This library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *    General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public
+ *    License along with this library; if not, write to the Free Software
+ *    Foundation, Inc., 51 Franklin St, 5th Floor, Boston, MA 02110-1301 USA
+ *
+ *    Contact: : multiboost@googlegroups.com
+ *
+ *    For more information and up-to-date version, please visit
+ *
+ *                       http://www.multiboost.org/
+ *
+ */
+
+
+#include "ArmSumTree.h"
+#include <algorithm> // for max_element, sort, copy, fill
+#include <stdlib.h> // for rand
+#include <math.h>
+
+namespace MultiBoost {
+//----------------------------------------------------------------
+//----------------------------------------------------------------
+
+    void ArmSumTree::init( const vector< AlphaReal >& logWeights )
+    {
+        resize( (int)logWeights.size() );
+
+        _shift = _numOfArms > 0 ? *max_element( logWeights.begin(), logWeights.end() ) : 0.0;
+
+        for( int i=0; i < _numOfArms; i++ )
+        {
+            _weights[ _size + i ] = exp( logWeights[i] - _shift );
+        }
+
+        buildSums();
+    }
+
+//----------------------------------------------------------------
+//----------------------------------------------------------------
+
+    void ArmSumTree::initWeights( const vector< AlphaReal >& weights )
+    {
+        resize( (int)weights.size() );
+
+        _shift = 0.0;
+        copy( weights.begin(), weights.end(), _weights.begin() + _size );
+
+        buildSums();
+    }
+
+//----------------------------------------------------------------
+//----------------------------------------------------------------
+
+    void ArmSumTree::resize( int numOfArms )
+    {
+        _numOfArms = numOfArms;
+
+        _size = 1;
+        while ( _size < _numOfArms ) _size <<= 1;
+
+        _weights.assign( 2 * _size, 0.0 );
+        _counts.assign( 2 * _size, 0 );
+
+        fill( _counts.begin() + _size, _counts.begin() + _size + _numOfArms, 1 );
+    }
+
+//----------------------------------------------------------------
+//----------------------------------------------------------------
+
+    void ArmSumTree::buildSums( void )
+    {
+        for( int node = _size - 1; node >= 1; node-- )
+        {
+            _weights[node] = _weights[ 2 * node ] + _weights[ 2 * node + 1 ];
+            _counts[node] = _counts[ 2 * node ] + _counts[ 2 * node + 1 ];
+        }
+    }
+
+//----------------------------------------------------------------
+//----------------------------------------------------------------
+
+    void ArmSumTree::update( const vector< AlphaReal >& logWeights, int arm )
+    {
+        const AlphaReal logWeight = logWeights[arm] - _shift;
+
+        if ( logWeight > MAX_LOG_WEIGHT )
+        {
+            init( logWeights );
+            return;
+        }
+
+        setLeaf( arm, exp( logWeight ), 1 );
+
+        // all the weights went far below the shift
+        if ( getWeightSum() < exp( -(AlphaReal)MAX_LOG_WEIGHT ) )
+            init( logWeights );
+    }
+
+//----------------------------------------------------------------
+//----------------------------------------------------------------
+
+    void ArmSumTree::setLeaf( int arm, AlphaReal weight, int count )
+    {
+        int node = _size + arm;
+        _weights[node] = weight;
+        _counts[node] = count;
+
+        // the sums are recomputed from the children, so no rounding error accumulates
+        for( node >>= 1; node >= 1; node >>= 1 )
+        {
+            _weights[node] = _weights[ 2 * node ] + _weights[ 2 * node + 1 ];
+            _counts[node] = _counts[ 2 * node ] + _counts[ 2 * node + 1 ];
+        }
+    }
+
+//----------------------------------------------------------------
+//----------------------------------------------------------------
+
+    int ArmSumTree::sample( AlphaReal r, AlphaReal weightCoef, AlphaReal uniformCoef ) const
+    {
+        if ( _numOfArms == 0 ) return -1;
+
+        const AlphaReal totalMass = weightCoef * _weights[1] + uniformCoef * _counts[1];
+        if ( ! ( totalMass > 0.0 ) ) return -1;
+
+        AlphaReal target = r * totalMass;
+        int node = 1;
+
+        while ( node < _size )
+        {
+            const int left = 2 * node;
+            const AlphaReal leftMass = weightCoef * _weights[left] + uniformCoef * _counts[left];
+            const AlphaReal rightMass = weightCoef * _weights[left+1] + uniformCoef * _counts[left+1];
+
+            // an empty subtree is never entered, even if rounding pushes the target out
+            if ( leftMass > 0.0 && ( target <= leftMass || ! ( rightMass > 0.0 ) ) )
+            {
+                node = left;
+            }
+            else
+            {
+                target -= leftMass;
+                node = left + 1;
+            }
+        }
+
+        return node - _size;
+    }
+
+//----------------------------------------------------------------
+//----------------------------------------------------------------
+
+    void ArmSumTree::sampleWithoutReplacement( int k, AlphaReal weightCoef, AlphaReal uniformCoef, vector<int>& arms )
+    {
+        arms.clear();
+        vector< AlphaReal > takenWeights;
+
+        while ( (int)arms.size() < k )
+        {
+            AlphaReal r = rand() / (AlphaReal) RAND_MAX;
+            const int arm = sample( r, weightCoef, uniformCoef );
+            if ( arm < 0 ) break;
+
+            arms.push_back( arm );
+            takenWeights.push_back( getWeight( arm ) );
+            setLeaf( arm, 0.0, 0 );
+        }
+
+        // put the arms back
+        for( int i=0; i < (int)arms.size(); i++ )
+        {
+            setLeaf( arms[i], takenWeights[i], 1 );
+        }
+
+        sort( arms.begin(), arms.end() );
+    }
+
+} // end namespace MultiBoost
@@ -0,0 +1,171 @@
+/*
+ *
+ *    MultiBoost - Multi-purpose boosting package
+ *
+ *    Copyright (C)        AppStat group
+ *                         Laboratoire de l'Accelerateur Lineaire
+ *                         Universite Paris-Sud, 11, CNRS
+ *
+ *    This file is part of the MultiBoost library
+ *
+ *    This library is free software; you can redistribute it
+ *    and/or modify it under the terms of the GNU General Public
+ *    License as published by the Free Software Foundation
+ *    version 2.1 of the License.
+ *
+ *    This library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *    General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public
+ *    License along with this library; if not, write to the Free Software
+ *    Foundation, Inc., 51 Franklin St, 5th Floor, Boston, MA 02110-1301 USA
+ *
+ *    Contact: : multiboost@googlegroups.com
+ *
+ *    For more information and up-to-date version, please visit
+ *
+ *                       http://www.multiboost.org/
+ *
+ */
+
+/**
+   \file ArmSumTree.h A sum tree over the arms of the exponential weighting
+   bandit algorithms.
+*/
+
+#ifndef _ARMSUMTREE_H
+#define _ARMSUMTREE_H
+
+#include <vector>
+#include "Defaults.h"
+
+using namespace std;
+
+//////////////////////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace MultiBoost {
+
+    /**
+     * A complete binary sum tree over the exponential weights \f$e^{w_i}\f$ of the arms, 
+     * used by the Exp3 family. The arms are drawn with the mixture 
+     * \f$ p_i \propto c_w e^{w_i} + c_u \f$, that is an exponential weighting plus
+     * a uniform exploration term, as the Exp3 algorithms define their probabilities.
+     * Changing the weight of an arm and drawing an arm cost O(log N) instead of the 
+     * O(N) of renormalizing and scanning the whole probability vector. The arms are laid 
+     * out in index order, so a random number gives the same arm as the linear scan of the 
+     * cumulative sums. The weights are stored relative to a shift (the largest log weight 
+     * at the last rebuild) that is moved when they would overflow or underflow.
+     * The tree can also hold plain weights, see initWeights().
+     * \date 16/10/2026
+     */
+    class ArmSumTree
+    {
+    public:
+        ArmSumTree( void ) : _numOfArms( 0 ), _size( 0 ), _shift( 0.0 ) {}
+
+        /**
+         * Build the tree. O(N).
+         * \param logWeights The log weights of the arms.
+         * \date 16/10/2026
+         */
+        void init( const vector< AlphaReal >& logWeights );
+
+        /**
+         * Build the tree from plain, non-negative weights instead of log weights: they 
+         * are stored as they are, and must then be changed with setWeight(). O(N).
+         * \param weights The weights of the arms.
+         * \date 16/10/2026
+         */
+        void initWeights( const vector< AlphaReal >& weights );
+
+        /**
+         * Set the plain weight of an arm. O(log N).
+         * \see initWeights
+         * \date 16/10/2026
+         */
+        void setWeight( int arm, AlphaReal weight ) { setLeaf( arm, weight, 1 ); }
+
+        /**
+         * Update the weight of an arm. O(log N), unless the weights have to be
+         * shifted, in which case the tree is rebuilt.
+         * \param logWeights The log weights of the arms, where only \a arm has changed
+         * since the last update.
+         * \param arm The arm whose log weight has changed.
+         * \date 16/10/2026
+         */
+        void update( const vector< AlphaReal >& logWeights, int arm );
+
+        /**
+         * The exponential weight of an arm, relative to the shift.
+         * \date 16/10/2026
+         */
+        AlphaReal getWeight( int arm ) const { return _weights[ _size + arm ]; }
+
+        /**
+         * The sum of the weights of the arms. O(1).
+         * \date 16/10/2026
+         */
+        AlphaReal getWeightSum( void ) const { return _weights[ 1 ]; }
+
+        /**
+         * Draw an arm: it returns the first arm whose cumulative mass reaches the
+         * fraction \a r of the total mass. O(log N).
+         * \param r A number in [0,1].
+         * \param weightCoef The coefficient \f$c_w\f$ of the weights.
+         * \param uniformCoef The uniform mass \f$c_u\f$ of every arm.
+         * \return The index of the arm, or -1 if the total mass is zero.
+         * \date 16/10/2026
+         */
+        int sample( AlphaReal r, AlphaReal weightCoef, AlphaReal uniformCoef ) const;
+
+        /**
+         * Draw \a k distinct arms: after each draw the arm is taken out of the tree, 
+         * and the next arm is drawn from the remaining ones. The arms are put back 
+         * at the end. O(k log N). The random numbers are given by rand().
+         * \param k The number of arms. Less arms are returned if there are not 
+         * enough arms with a positive mass.
+         * \param weightCoef The coefficient \f$c_w\f$ of the weights.
+         * \param uniformCoef The uniform mass \f$c_u\f$ of every arm.
+         * \param arms The indices of the arms, in increasing order.
+         * \date 16/10/2026
+         */
+        void sampleWithoutReplacement( int k, AlphaReal weightCoef, AlphaReal uniformCoef, vector<int>& arms );
+
+    protected:
+        /**
+         * Allocate the tree for \a numOfArms arms, the leaves being set to zero.
+         * \date 16/10/2026
+         */
+        void resize( int numOfArms );
+
+        /**
+         * Compute the sums of the internal nodes from the leaves.
+         * \date 16/10/2026
+         */
+        void buildSums( void );
+
+        /**
+         * Set the weight and the count of a leaf, and update its ancestors.
+         * \date 16/10/2026
+         */
+        void setLeaf( int arm, AlphaReal weight, int count );
+
+        /**
+         * The largest log weight relative to the shift before the tree is rebuilt.
+         * It keeps the sums far from overflow, even with AlphaReal as float.
+         */
+        static const int MAX_LOG_WEIGHT = 60;
+
+        int                 _numOfArms;
+        int                 _size;          // the number of leaves, a power of two
+        AlphaReal           _shift;         // the log weights are stored as exp( w_i - _shift )
+        vector< AlphaReal > _weights;       // node i has the children 2i and 2i+1, the leaves start at _size
+        vector< int >       _counts;        // the number of arms (not taken out) under each node
+    };
+
+} // end of namespace MultiBoost
+
+#endif
@@ -42,7 +42,7 @@ namespace MultiBoost {
 //----------------------------------------------------------------
 
 
-    Exp3::Exp3( void ) : GenericBanditAlgorithm()
+    Exp3::Exp3( void ) : GenericBanditAlgorithm(), _isUniform( true )
     {
         _gamma = 0.01;
         //_eta = 0.05;
@@ -65,28 +65,51 @@ namespace MultiBoost {
 //----------------------------------------------------------------
     int Exp3::getNextAction()
     {
-        vector< AlphaReal > cumsum( getArmNumber()+1 );
-        int i;
+        AlphaReal weightCoef, uniformCoef;
+        getMixture( weightCoef, uniformCoef );
 
-        cumsum[0] = 0.0;
-        for( int i=0; i < getArmNumber(); i++ )
-        {
-            cumsum[i+1] = cumsum[i] + _pHat[i];
-        }
+        AlphaReal r = rand() / (AlphaReal) RAND_MAX;
 
-        for( i=0; i < getArmNumber(); i++ )
-        {
-            cumsum[i+1] /= cumsum[  getArmNumber() ];
-        }
+        return _armTree.sample( r, weightCoef, uniformCoef );
+    }
 
-        AlphaReal r = rand() / (AlphaReal) RAND_MAX;
+//----------------------------------------------------------------
+//----------------------------------------------------------------
+
+    void Exp3::getKBestAction( const int k, vector<int>& bestArms )
+    {
+        AlphaReal weightCoef, uniformCoef;
+        getMixture( weightCoef, uniformCoef );
+
+        _armTree.sampleWithoutReplacement( k, weightCoef, uniformCoef, bestArms );
+    }
+
+//----------------------------------------------------------------
+//----------------------------------------------------------------
 
-        for( i=0; i < getArmNumber(); i++ )
+    void Exp3::getMixture( AlphaReal& weightCoef, AlphaReal& uniformCoef )
+    {
+        if ( _isUniform )
         {
-            if ( (cumsum[i] <= r) && ( r<=cumsum[i+1] )  ) break;
+            weightCoef = 0.0;
+            uniformCoef = 1.0 / _numOfArms;
+        } 
+        else 
+        {
+            weightCoef = ( 1 - _gamma ) / _armTree.getWeightSum();
+            uniformCoef = _gamma / _numOfArms;
         }
+    }
 
-        return i;
+//----------------------------------------------------------------
+//----------------------------------------------------------------
+
+    AlphaReal Exp3::getProbability( int i )
+    {
+        AlphaReal weightCoef, uniformCoef;
+        getMixture( weightCoef, uniformCoef );
+
+        return weightCoef * _armTree.getWeight( i ) + uniformCoef;
     }
 
 //----------------------------------------------------------------
@@ -94,11 +117,8 @@ namespace MultiBoost {
 
     void Exp3::initialize( vector< AlphaReal >& vals )
     {
-        _p.resize( _numOfArms );
-        _pHat.resize( _numOfArms );
-
-        fill( _p.begin(), _p.end(), 1.0 / _numOfArms );
-        fill( _pHat.begin(), _pHat.end(), 1.0 / _numOfArms );
+        // uniform probabilities until the first reward
+        _isUniform = true;
 
         //_alpha = pow( 4*_numOfArms*log((double)_numOfArms) * ( 1.0 / 100000 ), 1.0/3.0);
         //_gamma = pow( (_numOfArms*log((double)_numOfArms))/( 2.0 * 100000 ) , 0.5);
@@ -113,6 +133,7 @@ namespace MultiBoost {
         //one pull for all arm
         fill( _T.begin(), _T.end(), 1 );
 
+        _armTree.init( _X );
 
         setInitializedFlagToTrue();
     }
@@ -122,34 +143,9 @@ namespace MultiBoost {
 
     void Exp3::updateithValue( int i )
     {
-        AlphaReal sumexp = 0.0;
-
-        AlphaReal max = -numeric_limits<AlphaReal>::max();
-        for( int i=0; i<_numOfArms; i++ ) 
-        {
-            if ( max < _X[i] ) max = _X[i];
-        }
-
-        for( int i=0; i<_numOfArms; i++ ) 
-        {
-            _p[i] = exp( _X[i]-max);// * log( 1.0 + _alpha ); 
-            sumexp += _p[i];
-        }
-        
-        for( int i=0; i<_numOfArms; i++ ) 
-        {
-            _p[i] /= sumexp;
-            //_p[i] = exp( _p[i] );
-        
-            //sum += _p[i];
-        }
-
-
-        for( int i=0; i<_numOfArms; i++ ) 
-        {
-            _pHat[i] = (1-_gamma)*_p[i] + _gamma / _numOfArms;
-        }
-
+        // p is the softmax of X, only X[i] has changed
+        _armTree.update( _X, i );
+        _isUniform = false;
     }
 
 //----------------------------------------------------------------
@@ -157,7 +153,7 @@ namespace MultiBoost {
     void Exp3::receiveReward( int armNum, AlphaReal reward )
     {
         _T[ armNum ]++;
-        AlphaReal xHat = reward / _pHat[armNum];
+        AlphaReal xHat = reward / getProbability( armNum );
         _X[ armNum ] += ( ( _gamma  * xHat )/ _numOfArms );
         incIter();
         updateithValue( armNum );               
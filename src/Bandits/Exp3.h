@@ -41,6 +41,7 @@
 #include <functional>
 #include <math.h> //for pow
 #include "GenericBanditAlgorithm.h"
+#include "ArmSumTree.h"
 #include "Utils/Utils.h"
 
 using namespace std;
@@ -131,8 +132,8 @@ namespace MultiBoost {
     protected:
         //double _alpha;
         AlphaReal _gamma;
-        vector< AlphaReal > _p;
-        vector< AlphaReal > _pHat;
+        ArmSumTree _armTree; // the exponential weights of the arms
+        bool _isUniform; // the arms are drawn uniformly until the first reward
 
         //Hedge _hedge;
     public:
@@ -157,9 +158,29 @@ namespace MultiBoost {
 
         virtual int getNextAction();
 
+        /**
+         * Draw \a k distinct arms, successively from the remaining arms. O(k log N).
+         * \see ArmSumTree::sampleWithoutReplacement
+         * \date 16/10/2026
+         */
+        virtual void getKBestAction( const int k, vector<int>& bestArms );
+
         virtual void initLearningOptions(const nor_utils::Args& args);
     protected:
         virtual void updateithValue( int i );   
+
+        /**
+         * The probability \f$\hat{p}_i = (1-\gamma) p_i + \gamma / N\f$ of an arm.
+         * \date 16/10/2026
+         */
+        AlphaReal getProbability( int i );
+
+        /**
+         * The coefficients of the weights and the uniform mass of the arms in the 
+         * tree giving the probabilities \f$\hat{p}_i\f$.
+         * \date 16/10/2026
+         */
+        void getMixture( AlphaReal& weightCoef, AlphaReal& uniformCoef );
     };
 
 
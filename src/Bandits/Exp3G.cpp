@@ -41,7 +41,7 @@ namespace MultiBoost {
 //----------------------------------------------------------------
 
 
-    Exp3G::Exp3G( void ) : GenericBanditAlgorithm(), _actions(0)
+    Exp3G::Exp3G( void ) : GenericBanditAlgorithm(), _isUniform( true ), _actions(0)
     {
         _gamma = 0.05;
         _eta = 0.5;
@@ -67,28 +67,51 @@ namespace MultiBoost {
 
     int Exp3G::getNextAction()
     {
-        vector< AlphaReal > cumsum( getArmNumber()+1 );
-        int i;
+        AlphaReal weightCoef, uniformCoef;
+        getMixture( weightCoef, uniformCoef );
 
-        cumsum[0] = 0.0;
-        for( int i=0; i < getArmNumber(); i++ )
-        {
-            cumsum[i+1] = cumsum[i] + _p[i];
-        }
+        AlphaReal r = rand() / (AlphaReal) RAND_MAX;
 
-        for( i=0; i < getArmNumber(); i++ )
-        {
-            cumsum[i+1] /= cumsum[  getArmNumber() ];
-        }
+        return _armTree.sample( r, weightCoef, uniformCoef );
+    }
 
-        AlphaReal r = rand() / (AlphaReal) RAND_MAX;
+//----------------------------------------------------------------
+//----------------------------------------------------------------
+
+    void Exp3G::getKBestAction( const int k, vector<int>& bestArms )
+    {
+        AlphaReal weightCoef, uniformCoef;
+        getMixture( weightCoef, uniformCoef );
 
-        for( i=0; i < getArmNumber(); i++ )
+        _armTree.sampleWithoutReplacement( k, weightCoef, uniformCoef, bestArms );
+    }
+
+//----------------------------------------------------------------
+//----------------------------------------------------------------
+
+    void Exp3G::getMixture( AlphaReal& weightCoef, AlphaReal& uniformCoef )
+    {
+        if ( _isUniform )
         {
-            if ( (cumsum[i] <= r) && ( r<=cumsum[i+1] )  ) break;
+            weightCoef = 0.0;
+            uniformCoef = 1.0 / _numOfArms;
+        } 
+        else 
+        {
+            weightCoef = ( 1 - _gamma ) / _armTree.getWeightSum();
+            uniformCoef = _gamma / (AlphaReal)getIterNum();
         }
+    }
 
-        return i;
+//----------------------------------------------------------------
+//----------------------------------------------------------------
+
+    AlphaReal Exp3G::getProbability( int arm )
+    {
+        AlphaReal weightCoef, uniformCoef;
+        getMixture( weightCoef, uniformCoef );
+
+        return weightCoef * _armTree.getWeight( arm ) + uniformCoef;
     }
 
 //----------------------------------------------------------------
@@ -96,11 +119,10 @@ namespace MultiBoost {
 
     void Exp3G::initialize( vector< AlphaReal >& vals )
     {
-        _p.resize( _numOfArms );
         _w.resize( _numOfArms );
-        _tmpW.resize( _numOfArms );
 
-        fill( _p.begin(), _p.end(), 1.0 / _numOfArms );
+        // uniform probabilities until the first reward
+        _isUniform = true;
         fill( _w.begin(), _w.end(), 1.0 );
 
         //_eta = pow( log((double)_numOfArms)/ (4.0 * 2.0) , 0.5);
@@ -113,18 +135,16 @@ namespace MultiBoost {
         //one pull for all arm
         fill( _T.begin(), _T.end(), 1 );
         
+        _sideInformation.clear();
         _sideInformation.resize( _numOfArms );
-        for( int i=0; i < _numOfArms; i++ ) 
-        {
-            _sideInformation[i].resize( _numOfArms );
-            fill( _sideInformation[i].begin(), _sideInformation[i].end(), 0 );
-        }
         
         for( int i=0; i < _numOfArms; i++ ) 
         {
             _w[i] = _eta * _X[i];
         }
 
+        _armTree.init( _w );
+
         setInitializedFlagToTrue();
     }
 
@@ -149,29 +169,19 @@ namespace MultiBoost {
 
     void Exp3G::updateithValue( int arm )
     {
-        //double sum = 0.0;
-        AlphaReal max = -numeric_limits<AlphaReal>::max();
-        for( int i=0; i<_numOfArms; i++ ) 
-        {
-            //sum += _w[i];
-            if ( max < _w[i] ) max = _w[i];
-        }
-        //double mean = sum / ( double ) _numOfArms;
-        AlphaReal expSum = 0.0;
-        
-        for( int i=0; i<_numOfArms; i++ ) 
-        {
-            _tmpW[i] = _w[i] - max;
-            expSum += exp( _tmpW[i] );
-        }
-        
+        // p is the softmax of w mixed with gamma / t, only w[arm] has changed 
+        // and t is taken when the arms are drawn
+        _armTree.update( _w, arm );
+        _isUniform = false;
+    }
 
+//----------------------------------------------------------------
+//----------------------------------------------------------------
 
-        for( int i=0; i<_numOfArms; i++ ) 
-        {
-            //_p[i] = ( 1 - _gamma ) * exp( _w[i] / sum ) + ( _gamma / (double)getIterNum() );
-            _p[i] = ( 1 - _gamma ) * ( exp( _tmpW[i] ) / expSum ) + ( _gamma / (AlphaReal)getIterNum() );
-        }
+    void Exp3G::updateAllValues( void )
+    {
+        _armTree.init( _w );
+        _isUniform = false;
     }
 
 //----------------------------------------------------------------
@@ -186,7 +196,7 @@ namespace MultiBoost {
         {
             prevArm = _actions.back();
             _actions.push_back( armNum );
-            _sideInformation[armNum][prevArm]++;
+            _sideInformation[prevArm][armNum]++;
         } else {
             _sideInformation[armNum][armNum]++;
             _actions.push_back( armNum );
@@ -194,15 +204,16 @@ namespace MultiBoost {
         }
         incIter();
          
-        //update 
-        for( int i=0; i < _numOfArms; i++ ) 
+        //update, only the arms pulled after prevArm have a non-zero side information
+        const map< int, int >& followers = _sideInformation[prevArm];
+        const AlphaReal armCount = (AlphaReal)followers.find( armNum )->second;
+        for( map< int, int >::const_iterator it = followers.begin(); it != followers.end(); ++it ) 
         {
-            _w[i] += ( ( ( (AlphaReal)_sideInformation[i][prevArm] ) / ( (AlphaReal)_sideInformation[armNum][prevArm] ) ) * ( _eta * reward ) );
+            _w[it->first] += ( ( ( (AlphaReal)it->second ) / armCount ) * ( _eta * reward ) );
+            updateithValue( it->first );
         }
 
         //_w[armNum] += ( _eta * reward );
-
-        updateithValue( armNum );               
     }
 
 
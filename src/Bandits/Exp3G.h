@@ -38,7 +38,9 @@
 #include <list> 
 #include <functional>
 #include <math.h> //for pow
+#include <map>
 #include "GenericBanditAlgorithm.h"
+#include "ArmSumTree.h"
 #include "Utils/Utils.h"
 
 /*
@@ -61,10 +63,12 @@ namespace MultiBoost {
     protected:
         AlphaReal _eta;
         AlphaReal _gamma;
-        vector< AlphaReal > _p;
         vector< AlphaReal > _w;
-        vector< AlphaReal > _tmpW;
-        vector< vector< int > > _sideInformation;
+        ArmSumTree _armTree; // the exponential weights exp( _w ) of the arms
+        bool _isUniform; // the arms are drawn uniformly until the first reward
+        // _sideInformation[j][i] is the number of times arm i has been pulled after arm j, 
+        // only the non-zero counts are stored
+        vector< map< int, int > > _sideInformation;
         vector< int > _actions;
         //Hedge _hedge;
     public:
@@ -88,9 +92,36 @@ namespace MultiBoost {
         virtual void initialize( vector< AlphaReal >& vals );
         virtual int getNextAction();
 
+        /**
+         * Draw \a k distinct arms, successively from the remaining arms. O(k log N).
+         * \see ArmSumTree::sampleWithoutReplacement
+         * \date 16/10/2026
+         */
+        virtual void getKBestAction( const int k, vector<int>& bestArms );
+
         virtual void initLearningOptions(const nor_utils::Args& args );
     protected:
         virtual void updateithValue( int arm ); 
+
+        /**
+         * Rebuild the tree after all the weights have changed. O(N).
+         * \date 16/10/2026
+         */
+        void updateAllValues( void );
+
+        /**
+         * The probability \f$p_i = (1-\gamma) e^{w_i} / \sum_j e^{w_j} + \gamma / t\f$ 
+         * of an arm, where t is the iteration number.
+         * \date 16/10/2026
+         */
+        AlphaReal getProbability( int arm );
+
+        /**
+         * The coefficients of the weights and the uniform mass of the arms in the 
+         * tree giving the probabilities \f$p_i\f$.
+         * \date 16/10/2026
+         */
+        void getMixture( AlphaReal& weightCoef, AlphaReal& uniformCoef );
     };
 
 
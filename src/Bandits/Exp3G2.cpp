@@ -53,11 +53,10 @@ namespace MultiBoost {
 
     void Exp3G2::initialize( vector< AlphaReal >& vals )
     {
-        _p.resize( _numOfArms );
         _w.resize( _numOfArms );
-        _tmpW.resize( _numOfArms );
 
-        fill( _p.begin(), _p.end(), 1.0 / _numOfArms );
+        // uniform probabilities until the first reward
+        _isUniform = true;
         fill( _w.begin(), _w.end(), 1.0 );
 
 
@@ -71,6 +70,8 @@ namespace MultiBoost {
             _w[i] = _eta * _X[i];
         }
 
+        _armTree.init( _w );
+
         setInitializedFlagToTrue();
     }
 
@@ -94,7 +95,7 @@ namespace MultiBoost {
 
         //_w[armNum] += ( _eta * reward );
 
-        updateithValue( armNum );               
+        updateAllValues();               
     }
 
 //----------------------------------------------------------------
@@ -111,7 +112,7 @@ namespace MultiBoost {
 
         //_w[armNum] += ( _eta * reward );
 
-        updateithValue( 0 );            
+        updateAllValues();            
     }
 
 
@@ -56,11 +56,10 @@ namespace MultiBoost {
 
     void Exp3P::initialize( vector< AlphaReal >& vals )
     {
-        _p.resize( _numOfArms );
         _w.resize( _numOfArms );
-        _tmpW.resize( _numOfArms );
 
-        fill( _p.begin(), _p.end(), 1.0 / _numOfArms );
+        // uniform probabilities until the first reward
+        _isUniform = true;
         fill( _w.begin(), _w.end(), 1.0 );
 
         copy( vals.begin(), vals.end(), _X.begin() );
@@ -78,6 +77,8 @@ namespace MultiBoost {
             }
         }
 
+        _armTree.init( _w );
+
         setInitializedFlagToTrue();
     }
 //----------------------------------------------------------------
@@ -89,11 +90,14 @@ namespace MultiBoost {
         _T[ armNum ]++;
         // calculate the feedback value
 
+        // the probability the arm has been drawn with, before the iteration is incremented
+        const AlphaReal p = getProbability( armNum );
+
         incIter();
          
         //update 
-        AlphaReal xHat = reward / _p[armNum]; 
-        _w[armNum] +=  (_gamma / (3 * (AlphaReal)_numOfArms )) * ( xHat + ( _eta / ( _p[armNum] * pow( (AlphaReal)_numOfArms * _horizon,0.5 )) ) );
+        AlphaReal xHat = reward / p; 
+        _w[armNum] +=  (_gamma / (3 * (AlphaReal)_numOfArms )) * ( xHat + ( _eta / ( p * pow( (AlphaReal)_numOfArms * _horizon,0.5 )) ) );
 
         /*
           double wsum = 0.0;
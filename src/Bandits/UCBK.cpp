@@ -40,7 +40,7 @@ namespace MultiBoost {
 //----------------------------------------------------------------
 
 
-    UCBK::UCBK( void ) : GenericBanditAlgorithm(), _valuesList(0)
+    UCBK::UCBK( void ) : GenericBanditAlgorithm()
     {
     }
 
@@ -51,19 +51,14 @@ namespace MultiBoost {
 
     void UCBK::getKBestAction( const int k, vector<int>& bestArms )
     {
-        bestArms.resize(k);
-        int i=0; 
-        for( list< pair<AlphaReal,int>* >::iterator it = _valuesList.begin(); i<k; it++, i++ )
-        {
-            bestArms[i] = (**it).second;
-        }
+        _armHeap.getKBestArms( k, bestArms );
     }
 //----------------------------------------------------------------
 //----------------------------------------------------------------
 
     int UCBK::getNextAction()
     {
-        return _valuesList.front()->second;
+        return _armHeap.getBestArm();
     }
 
 //----------------------------------------------------------------
@@ -71,28 +66,19 @@ namespace MultiBoost {
 
     void UCBK::initialize( vector< AlphaReal >& vals )
     {
-        _valueRecord.resize( _numOfArms );
-                
-        for( int i=0; i < _numOfArms; i++ ) {
-            pair< AlphaReal, int >* tmpPair = new pair< AlphaReal, int >(0.0,i);
-
-            _valuesList.push_back( tmpPair );
-            _valueRecord[i] = tmpPair;
-        }
-
-
         //copy the initial values to X
         copy( vals.begin(), vals.end(), _X.begin() );
         //one pull for all arm
         fill( _T.begin(), _T.end(), 1 );
         
         //update the values
+        vector< AlphaReal > values( _numOfArms );
         for( int i = 0; i < _numOfArms; i++ )
         {
-            _valueRecord[i]->first = _X[i] / (AlphaReal) _T[i] + sqrt( ( 2 * log( (AlphaReal)getIterNum() ) ) / _T[i] );
+            values[i] = _X[i] / (AlphaReal) _T[i] + sqrt( ( 2 * log( (AlphaReal)getIterNum() ) ) / _T[i] );
         }
-        //sort them according to the values the arms
-        _valuesList.sort( nor_utils::comparePairP< 1, AlphaReal, int, greater<AlphaReal> >() );
+        //order the arms according to their values
+        _armHeap.init( values );
 
         setInitializedFlagToTrue();
     }
@@ -102,10 +88,8 @@ namespace MultiBoost {
 
     void UCBK::updateithValue( int i )
     {
-        //update the value
-        _valueRecord[i]->first = _X[i] / (AlphaReal) _T[i] + sqrt( ( 2 * log( (AlphaReal)getIterNum() ) ) / _T[i] );
-        //sort them according to the values the arms
-        _valuesList.sort( nor_utils::comparePairP< 1, AlphaReal, int, greater<AlphaReal> >() );
+        //update the value, and move the arm in the heap
+        _armHeap.update( i, _X[i] / (AlphaReal) _T[i] + sqrt( ( 2 * log( (AlphaReal)getIterNum() ) ) / _T[i] ) );
     }
 
 //----------------------------------------------------------------
@@ -39,6 +39,7 @@
 #include <functional>
 #include <math.h> //for log
 #include "GenericBanditAlgorithm.h"
+#include "ArmHeap.h"
 #include "Utils/Utils.h"
 //////////////////////////////////////////////////////////////////////////////////////////////
 //////////////////////////////////////////////////////////////////////////////////////////////
@@ -60,21 +61,14 @@ namespace MultiBoost {
     class UCBK : public GenericBanditAlgorithm
     {
     protected:
-        list< pair<AlphaReal, int >* > _valuesList;
-        vector< pair<AlphaReal, int >* > _valueRecord;
+        // the B-values of the arms, the exploration term of an arm is computed 
+        // when the arm is updated
+        ArmHeap _armHeap;
+
     public:
         UCBK(void);
         virtual ~UCBK(void) 
         {
-            list< pair< AlphaReal, int >* >::iterator it;
-                
-            for( it = _valuesList.begin(); it != _valuesList.end(); it ++ )
-            {
-                delete *it;
-            }
-
-            _valuesList.clear();
-            _valueRecord.clear();
         }
 
         virtual void initialize( vector< AlphaReal >& vals );
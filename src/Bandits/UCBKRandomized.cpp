@@ -68,28 +68,19 @@ namespace MultiBoost {
 
     int UCBKRandomized::getNextAction()
     {
-        vector< AlphaReal > cumsum( getArmNumber()+1 );
-        int i;
-
-        cumsum[0] = 0.0;
-        for( int i=0; i < getArmNumber(); i++ )
-        {
-            cumsum[i+1] = cumsum[i] + _valueRecord[i]->first;
-        }
+        AlphaReal r = rand() / (AlphaReal) RAND_MAX;
 
-        for( i=0; i < getArmNumber(); i++ )
-        {
-            cumsum[i+1] /= cumsum[  getArmNumber() ];
-        }
+        return _valueTree.sample( r, 1.0, 0.0 );
+    }
 
-        AlphaReal r = rand() / (AlphaReal) RAND_MAX;
+//----------------------------------------------------------------
+//----------------------------------------------------------------
 
-        for( i=0; i < getArmNumber(); i++ )
-        {
-            if ( (cumsum[i] <= r) && ( r<=cumsum[i+1] )  ) break;
-        }
+    void UCBKRandomized::initialize( vector< AlphaReal >& vals )
+    {
+        UCBK::initialize( vals );
 
-        return i;
+        _valueTree.initWeights( _armHeap.getValues() );
     }
 
 //----------------------------------------------------------------
@@ -98,11 +89,11 @@ namespace MultiBoost {
     void UCBKRandomized::updateithValue( int i )
     {
         //update the value
-        //_valueRecord[i]->first = _X[i] / (double) _T[i] + sqrt( ( 2 * log( (double)getIterNum() ) ) / _T[i] );
-        _valueRecord[i]->first = _X[i] / (AlphaReal) _T[i];// + sqrt( ( 2 * log( (double)getIterNum() ) ) / _T[i] );
-        //_valueRecord[i]->first = exp( _valueRecord[i]->first );
-        //sort them according to the values the arms
-        _valuesList.sort( nor_utils::comparePairP< 1, AlphaReal, int, greater<AlphaReal> >() );
+        //value = _X[i] / (double) _T[i] + sqrt( ( 2 * log( (double)getIterNum() ) ) / _T[i] );
+        const AlphaReal value = _X[i] / (AlphaReal) _T[i];// + sqrt( ( 2 * log( (double)getIterNum() ) ) / _T[i] );
+        //value = exp( value );
+        _armHeap.update( i, value );
+        _valueTree.setWeight( i, value );
     }
 //----------------------------------------------------------------
 //----------------------------------------------------------------
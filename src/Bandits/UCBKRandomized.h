@@ -41,6 +41,7 @@
 #include "GenericBanditAlgorithm.h"
 #include "Utils/Utils.h"
 #include "UCBK.h"
+#include "ArmSumTree.h"
 //////////////////////////////////////////////////////////////////////////////////////////////
 //////////////////////////////////////////////////////////////////////////////////////////////
 
@@ -60,11 +61,18 @@ namespace MultiBoost {
 
     class UCBKRandomized : public UCBK
     {
+    protected:
+        // the arms are drawn proportionally to their values
+        ArmSumTree _valueTree;
+
     public:
         UCBKRandomized(void);
 
+        virtual void initialize( vector< AlphaReal >& vals );
+
         virtual void getKBestAction( const int k, vector<int>& bestArms );
         virtual int getNextAction();
+
     protected:
         virtual void updateithValue( int i );
     };
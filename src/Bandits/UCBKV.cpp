@@ -39,7 +39,7 @@ namespace MultiBoost {
 //----------------------------------------------------------------
 
 
-    UCBKV::UCBKV( void ) : GenericBanditAlgorithm(), _valuesList(0), _table( 0 ), _kszi( 1.0 ), _c(1.0/3.0), _b(1)
+    UCBKV::UCBKV( void ) : GenericBanditAlgorithm(), _table( 0 ), _kszi( 1.0 ), _c(1.0/3.0), _b(1)
     {
     }
 
@@ -50,19 +50,14 @@ namespace MultiBoost {
 
     void UCBKV::getKBestAction( const int k, vector<int>& bestArms )
     {
-        bestArms.resize(k);
-        int i=0; 
-        for( list< pair< AlphaReal,int>* >::iterator it = _valuesList.begin(); i<k; it++, i++ )
-        {
-            bestArms[i] = (**it).second;
-        }
+        _armHeap.getKBestArms( k, bestArms );
     }
 //----------------------------------------------------------------
 //----------------------------------------------------------------
 
     int UCBKV::getNextAction()
     {
-        return _valuesList.front()->second;
+        return _armHeap.getBestArm();
     }
 
 //----------------------------------------------------------------
@@ -72,16 +67,6 @@ namespace MultiBoost {
     {
         int i;
 
-        _valueRecord.resize( _numOfArms );
-                
-        for( i=0; i < _numOfArms; i++ ) {
-            pair< AlphaReal, int >* tmpPair = new pair< AlphaReal, int >(0.0,i);
-
-            _valuesList.push_back( tmpPair );
-            _valueRecord[i] = tmpPair;
-        }
-
-
         //copy the initial values to X
         copy( vals.begin(), vals.end(), _X.begin() );
         
@@ -97,13 +82,14 @@ namespace MultiBoost {
         fill( _T.begin(), _T.end(), 1 );
         
         //update the values
+        vector< AlphaReal > values( _numOfArms );
         for( i = 0; i < _numOfArms; i++ )
         {
-            //_valueRecord[i]->first = _X[i] / (double) _T[i] + sqrt( ( 2 * log( (double)getIterNum() ) ) / _T[i] );
-            _valueRecord[i]->first = _X[i] / (AlphaReal) _T[i] + _c * ( ( 3 * _b * _kszi *  log( (AlphaReal)getIterNum() ) )/ _T[i]); //second term is zero because of the variance is eqaul to zero
+            //values[i] = _X[i] / (double) _T[i] + sqrt( ( 2 * log( (double)getIterNum() ) ) / _T[i] );
+            values[i] = _X[i] / (AlphaReal) _T[i] + _c * ( ( 3 * _b * _kszi *  log( (AlphaReal)getIterNum() ) )/ _T[i]); //second term is zero because of the variance is eqaul to zero
         }
-        //sort them according to the values the arms
-        _valuesList.sort( nor_utils::comparePairP< 1, AlphaReal, int, greater<AlphaReal> >() );
+        //order the arms according to their values
+        _armHeap.init( values );
 
         setInitializedFlagToTrue();
     }
@@ -123,11 +109,11 @@ namespace MultiBoost {
         }
         variance /= _T[i];
 
-        _valueRecord[i]->first = mean + sqrt( ( 2.0 * _kszi * variance * log( (AlphaReal)getIterNum() ) ) / _T[i] ) + 
+        const AlphaReal value = mean + sqrt( ( 2.0 * _kszi * variance * log( (AlphaReal)getIterNum() ) ) / _T[i] ) + 
             _c * ( ( 3 * _b * _kszi *  log( (AlphaReal)getIterNum() ) )/ _T[i]) ;
         
-        //sort them according to the values the arms
-        _valuesList.sort( nor_utils::comparePairP< 1, AlphaReal, int, greater<AlphaReal> >() );
+        //move the arm in the heap
+        _armHeap.update( i, value );
     }
 
 //----------------------------------------------------------------
@@ -39,6 +39,7 @@
 #include <functional>
 #include <math.h> //for log
 #include "GenericBanditAlgorithm.h"
+#include "ArmHeap.h"
 #include "Utils/Utils.h"
 //////////////////////////////////////////////////////////////////////////////////////////////
 //////////////////////////////////////////////////////////////////////////////////////////////
@@ -60,8 +61,9 @@ namespace MultiBoost {
     class UCBKV : public GenericBanditAlgorithm
     {
     protected:
-        list< pair< AlphaReal, int >* > _valuesList;
-        vector< pair< AlphaReal, int >* > _valueRecord;
+        // the B-values of the arms, the exploration term of an arm is computed 
+        // when the arm is updated
+        ArmHeap _armHeap;
         vector< vector< AlphaReal > > _table;
         AlphaReal _kszi; //exploaration paramerter
         AlphaReal _c; //trade-off parameter
@@ -71,15 +73,6 @@ namespace MultiBoost {
         UCBKV(void);
         virtual ~UCBKV(void) 
         {
-            list< pair< AlphaReal, int >* >::iterator it;
-                
-            for( it = _valuesList.begin(); it != _valuesList.end(); it ++ )
-            {
-                delete *it;
-            }
-
-            _valuesList.clear();
-            _valueRecord.clear();
         }
         
         virtual void receiveReward( int armNum, AlphaReal reward );
@@ -1,5 +1,7 @@
 #include "Bzip2Wrapper.h"
 
+#include <algorithm>
+
 Bzip2WrapperWriter::Bzip2WrapperWriter(void)
 {
 }
@@ -12,4 +14,470 @@ Bzip2WrapperWriter::~Bzip2WrapperWriter(void)
 
 Bzip2WrapperReader::~Bzip2WrapperReader(void)
 {
+    close();
+}
+
+/////////////////////////////////////////////////////////////////////
+// helpers of the parallel decompression
+
+namespace {
+
+    // the magic numbers starting a block and the end of a stream
+    const unsigned long long BLOCK_MAGIC = 0x314159265359ULL;
+    const unsigned long long EOS_MAGIC   = 0x177245385090ULL;
+    const unsigned long long MAGIC_MASK  = 0xffffffffffffULL;
+
+    // writes a bit stream, most significant bit first
+    class BitWriter
+    {
+    public:
+        BitWriter( vector<unsigned char>& out ) : _out(out), _bits(0), _numBits(0) {}
+
+        void put( unsigned int value, int numBits ) {
+            for ( int i = numBits - 1; i >= 0; --i ) {
+                _bits = (_bits << 1) | ((value >> i) & 1);
+                if ( ++_numBits == 8 ) {
+                    _out.push_back( (unsigned char) _bits );
+                    _bits = 0;
+                    _numBits = 0;
+                }
+            }
+        }
+
+        // copy the bits [from, to) of src
+        void copy( const unsigned char* src, size_t from, size_t to ) {
+            size_t bit = from;
+            if ( _numBits == 0 ) {
+                const int shift = (int) ( bit & 7 );
+                for ( ; to - bit >= 8; bit += 8 ) {
+                    const size_t byte = bit >> 3;
+                    if ( shift == 0 )
+                        _out.push_back( src[byte] );
+                    else
+                        _out.push_back( (unsigned char) ( (src[byte] << shift) | (src[byte + 1] >> (8 - shift)) ) );
+                }
+            }
+            for ( ; bit < to; ++bit )
+                put( (src[bit >> 3] >> (7 - (bit & 7))) & 1, 1 );
+        }
+
+        void flush() {
+            if ( _numBits > 0 ) put( 0, 8 - _numBits );
+        }
+
+    private:
+        vector<unsigned char>& _out;
+        unsigned int _bits;
+        int _numBits;
+    };
+
+    // decompress the block of src starting at bit \a from and ending at bit \a to
+    // by wrapping it into a stream of its own
+    bool decompressBlock( const vector<unsigned char>& src, size_t from, size_t to, vector<char>& out )
+    {
+        // the combined crc of a single block stream is the crc of the block,
+        // stored right after the block magic number
+        unsigned int crc = 0;
+        for ( size_t bit = from + 48; bit < from + 80; ++bit )
+            crc = (crc << 1) | ( (src[bit >> 3] >> (7 - (bit & 7))) & 1 );
+
+        vector<unsigned char> stream;
+        stream.reserve( (to - from) / 8 + 16 );
+        BitWriter writer( stream );
+        writer.put( 'B', 8 );
+        writer.put( 'Z', 8 );
+        writer.put( 'h', 8 );
+        writer.put( '9', 8 );
+        writer.copy( &src[0], from, to );
+        writer.put( (unsigned int) (EOS_MAGIC >> 24), 24 );
+        writer.put( (unsigned int) (EOS_MAGIC & 0xffffff), 24 );
+        writer.put( crc, 32 );
+        writer.flush();
+
+        bz_stream strm;
+        memset( &strm, 0, sizeof(strm) );
+        if ( BZ2_bzDecompressInit( &strm, 0, 0 ) != BZ_OK )
+            return false;
+
+        strm.next_in = (char*) &stream[0];
+        strm.avail_in = (unsigned int) stream.size();
+
+        out.resize( BZ_READER_BLOCKLEN );
+        size_t produced = 0;
+        int ret;
+        for (;;) {
+            if ( produced == out.size() ) out.resize( out.size() * 2 );
+            strm.next_out = &out[produced];
+            strm.avail_out = (unsigned int) ( out.size() - produced );
+            ret = BZ2_bzDecompress( &strm );
+            produced = out.size() - strm.avail_out;
+            if ( ret != BZ_OK ) break;
+            // the input is exhausted but the stream is not complete
+            if ( strm.avail_in == 0 && strm.avail_out > 0 ) break;
+        }
+        BZ2_bzDecompressEnd( &strm );
+
+        out.resize( produced );
+        return ( ret == BZ_STREAM_END );
+    }
+
+} // end of anonymous namespace
+
+/////////////////////////////////////////////////////////////////////
+
+void Bzip2WrapperReader::init( int numThreads )
+{
+    f = NULL;
+    b = NULL;
+    bzerror = BZ_OK;
+    filePos = 0;
+    _numThreads = numThreads;
+    _parallel = false;
+    _window.resize( BZ_READER_PUTBACKLEN + BZ_READER_BLOCKLEN );
+    _pos = _end = BZ_READER_PUTBACKLEN;
+    _delivered = 0;
+    setDelim( ", " );
+}
+
+/////////////////////////////////////////////////////////////////////
+
+void Bzip2WrapperReader::open( const char* fname )
+{
+    filePos = 0;
+    bzerror = BZ_OK;
+    _pos = _end = BZ_READER_PUTBACKLEN;
+    _delivered = 0;
+    _parallel = false;
+    _fname = fname;
+
+    if ( _numThreads > 1 ) {
+        f = fopen( fname, "rb" );
+        if ( f ) {
+            _compressed.clear();
+            char tmpBuf[ BUFLEN ];
+            size_t n;
+            while ( (n = fread( tmpBuf, 1, BUFLEN, f )) > 0 )
+                _compressed.insert( _compressed.end(), tmpBuf, tmpBuf + n );
+            fclose( f );
+            f = NULL;
+
+            _parallel = findBlocks();
+            if ( _parallel ) {
+                _nextBlock = 0;
+                _decoded.clear();
+                _decodedIdx = _decodedPos = 0;
+                return;
+            }
+            vector<unsigned char>().swap( _compressed );
+        }
+    }
+
+    openSerial( 0 );
+}
+
+/////////////////////////////////////////////////////////////////////
+
+void Bzip2WrapperReader::openSerial( size_t skipBytes )
+{
+    int err;
+    _unused.clear();
+
+    f = fopen( _fname.c_str(), "rb" );
+    if ( !f ) {
+        cout << "cannot open bz2 file!!!!" << endl;
+        b = NULL;
+        return;
+    }
+
+    b = BZ2_bzReadOpen( &err, f, 0, 0, NULL, 0 );
+    if ( err != BZ_OK ) {
+        BZ2_bzReadClose( &err, b );
+        b = NULL;
+        cout << "error code " << err << endl;
+        return;
+    }
+
+    // skip the data that has already been delivered
+    vector<char> tmpBuf( skipBytes > 0 ? BZ_READER_BLOCKLEN : 0 );
+    while ( skipBytes > 0 ) {
+        const size_t n = decompressSerial( &tmpBuf[0], min( skipBytes, (size_t) BZ_READER_BLOCKLEN ) );
+        if ( n == 0 ) break;
+        skipBytes -= n;
+    }
+}
+
+/////////////////////////////////////////////////////////////////////
+
+void Bzip2WrapperReader::close( void )
+{
+    int err;
+    if ( b ) BZ2_bzReadClose( &err, b );
+    b = NULL;
+    if ( f ) fclose( f );
+    f = NULL;
+
+    _parallel = false;
+    vector<unsigned char>().swap( _compressed );
+    _blocks.clear();
+    _decoded.clear();
+}
+
+/////////////////////////////////////////////////////////////////////
+
+void Bzip2WrapperReader::setDelim( const string s )
+{
+    delim = s;
+    memset( _isDelim, 0, sizeof(_isDelim) );
+    for ( size_t i = 0; i < delim.size(); ++i )
+        _isDelim[ (unsigned char) delim[i] ] = true;
+}
+
+/////////////////////////////////////////////////////////////////////
+
+bool Bzip2WrapperReader::fill()
+{
+    // keep the last characters for putback()
+    const size_t keep = min( _end, (size_t) BZ_READER_PUTBACKLEN );
+    memmove( &_window[BZ_READER_PUTBACKLEN - keep], &_window[_end - keep], keep );
+    _pos = _end = BZ_READER_PUTBACKLEN;
+
+    const size_t n = decompress( &_window[_end], BZ_READER_BLOCKLEN );
+    _end += n;
+    _delivered += n;
+    return ( n > 0 );
+}
+
+/////////////////////////////////////////////////////////////////////
+
+size_t Bzip2WrapperReader::decompress( char* dest, size_t size )
+{
+    if ( !_parallel )
+        return decompressSerial( dest, size );
+
+    size_t produced = 0;
+    while ( produced < size ) {
+        if ( _decodedIdx == _decoded.size() ) {
+            if ( _nextBlock == _blocks.size() ) break;
+
+            if ( !decompressNextBlocks() ) {
+                // a false block boundary: go on with the serial decompression
+                close();
+                openSerial( _delivered + produced );
+                return produced + decompressSerial( dest + produced, size - produced );
+            }
+            continue;
+        }
+
+        const vector<char>& block = _decoded[_decodedIdx];
+        const size_t n = min( size - produced, block.size() - _decodedPos );
+        if ( n > 0 ) memcpy( dest + produced, &block[_decodedPos], n );
+        produced += n;
+        _decodedPos += n;
+        if ( _decodedPos == block.size() ) {
+            ++_decodedIdx;
+            _decodedPos = 0;
+        }
+    }
+    return produced;
+}
+
+/////////////////////////////////////////////////////////////////////
+
+size_t Bzip2WrapperReader::decompressSerial( char* dest, size_t size )
+{
+    int err;
+    while ( b ) {
+        const int n = BZ2_bzRead( &err, b, dest, (int) size );
+
+        if ( err == BZ_STREAM_END ) {
+            // there might be another stream after this one
+            void* unused;
+            int numUnused;
+            BZ2_bzReadGetUnused( &err, b, &unused, &numUnused );
+            _unused.assign( (char*) unused, (char*) unused + numUnused );
+            BZ2_bzReadClose( &err, b );
+            b = NULL;
+
+            int c = fgetc( f );
+            if ( numUnused > 0 || c != EOF ) {
+                if ( c != EOF ) ungetc( c, f );
+                b = BZ2_bzReadOpen( &err, f, 0, 0, _unused.empty() ? NULL : &_unused[0], (int) _unused.size() );
+                if ( err != BZ_OK ) {
+                    BZ2_bzReadClose( &err, b );
+                    b = NULL;
+                }
+            }
+        }
+        else if ( err != BZ_OK ) {
+            BZ2_bzReadClose( &err, b );
+            b = NULL;
+        }
+
+        if ( n > 0 ) return n;
+    }
+    return 0;
+}
+
+/////////////////////////////////////////////////////////////////////
+
+bool Bzip2WrapperReader::findBlocks()
+{
+    _blocks.clear();
+    if ( _compressed.size() < 4 || memcmp( &_compressed[0], "BZh", 3 ) != 0 )
+        return false;
+
+    // the bit positions of the magic numbers; a block ends where the next
+    // block or the end of its stream starts
+    unsigned long long bits = 0;
+    size_t blockStart = 0;
+    bool inBlock = false;
+    const size_t numBytes = _compressed.size();
+    for ( size_t i = 0; i < numBytes; ++i ) {
+        bits = (bits << 8) | _compressed[i];
+        // the first magic number ends after the 32 bits of the stream header
+        if ( i < 9 ) continue;
+        for ( int shift = 7; shift >= 0; --shift ) {
+            const unsigned long long word = (bits >> shift) & MAGIC_MASK;
+            if ( word != BLOCK_MAGIC && word != EOS_MAGIC ) continue;
+
+            const size_t start = (i + 1) * 8 - shift - 48;
+            if ( inBlock ) _blocks.push_back( make_pair( blockStart, start ) );
+            inBlock = ( word == BLOCK_MAGIC );
+            blockStart = start;
+        }
+    }
+
+    // a block without its end: the file is truncated
+    if ( inBlock ) {
+        _blocks.clear();
+        return false;
+    }
+    return !_blocks.empty();
+}
+
+/////////////////////////////////////////////////////////////////////
+
+bool Bzip2WrapperReader::decompressNextBlocks()
+{
+    const int numThreads = _numThreads;
+    const size_t numBlocks = min( _blocks.size() - _nextBlock, (size_t) ( 2 * numThreads ) );
+
+    _decoded.resize( numBlocks );
+    vector<char> isOk( numBlocks, 0 );
+
+#pragma omp parallel for num_threads(numThreads) if (numThreads > 1) schedule(dynamic, 1)
+    for ( int i = 0; i < (int) numBlocks; ++i ) {
+        const pair<size_t, size_t>& block = _blocks[_nextBlock + i];
+        isOk[i] = decompressBlock( _compressed, block.first, block.second, _decoded[i] );
+    }
+
+    _nextBlock += numBlocks;
+    _decodedIdx = _decodedPos = 0;
+    return ( find( isOk.begin(), isOk.end(), 0 ) == isOk.end() );
+}
+
+/////////////////////////////////////////////////////////////////////
+
+int Bzip2WrapperReader::getLine( string& str, char delim )
+{
+    str.clear();
+    for (;;) {
+        const char* p = &_window[0] + _pos;
+        const char* end = &_window[0] + _end;
+        const char* q = p;
+        if ( delim == '\n' )
+            q = (const char*) memchr( p, '\n', end - p );
+        else
+            while ( q != end && *q != delim && *q != '\n' ) ++q;
+        if ( q == NULL ) q = end;
+
+        str.append( p, q );
+        _pos += q - p;
+        filePos += q - p;
+        if ( q != end ) {
+            // consume the delimiter
+            ++_pos;
+            ++filePos;
+            return 1;
+        }
+        if ( !fill() ) {
+            ++filePos;
+            setError( BZ_STREAM_END );
+            return 1;
+        }
+    }
+}
+
+/////////////////////////////////////////////////////////////////////
+
+int Bzip2WrapperReader::getStringNextDelimiter( string& str )
+{
+    str.clear();
+
+    // skip the leading spaces
+    for (;;) {
+        if ( _pos == _end && !fill() ) {
+            ++filePos;
+            setError( BZ_STREAM_END );
+            return 1;
+        }
+        if ( _window[_pos] != ' ' ) break;
+        ++_pos;
+        ++filePos;
+    }
+
+    for (;;) {
+        const char* p = &_window[0] + _pos;
+        const char* end = &_window[0] + _end;
+        const char* q = p;
+        while ( q != end && !_isDelim[ (unsigned char) *q ] ) ++q;
+
+        str.append( p, q );
+        _pos += q - p;
+        filePos += q - p;
+        if ( q != end ) {
+            // consume the delimiter
+            ++_pos;
+            ++filePos;
+            return 1;
+        }
+        if ( !fill() ) {
+            ++filePos;
+            setError( BZ_STREAM_END );
+            return 1;
+        }
+    }
+}
+
+/////////////////////////////////////////////////////////////////////
+
+void Bzip2WrapperReader::skip( long int numChars )
+{
+    while ( numChars > 0 ) {
+        if ( _pos == _end && !fill() ) break;
+        const size_t n = min( (size_t) numChars, _end - _pos );
+        _pos += n;
+        filePos += n;
+        numChars -= n;
+    }
+}
+
+/////////////////////////////////////////////////////////////////////
+
+int Bzip2WrapperReader::remainingRowNum()
+{
+    int rowCount = 1;
+
+    // the rows in the window
+    rowCount += (int) count( _window.begin() + _pos, _window.begin() + _end, '\n' );
+
+    // and after it
+    Bzip2WrapperReader counter( _fname.c_str(), _numThreads );
+    counter.skip( _delivered );
+    do {
+        rowCount += (int) count( counter._window.begin() + counter._pos,
+                                 counter._window.begin() + counter._end, '\n' );
+    } while ( counter.fill() );
+
+    return rowCount;
 }
@@ -4,114 +4,98 @@
 #include "bzlib.h"
 #include <fstream>
 #include <iostream>
+#include <string>
+#include <vector>
 #include <string.h>
 #include <stdlib.h>
 
 #define BUFLEN 32768
 
+// the size of the decompressed blocks the reader works on
+#define BZ_READER_BLOCKLEN (1 << 20)
+// the number of characters that can always be put back
+#define BZ_READER_PUTBACKLEN 64
+
 using namespace std;
 
+/**
+ * A buffered reader of bzip2 files.
+ * The data is decompressed BZ_READER_BLOCKLEN bytes at a time into a window,
+ * and the characters, lines and tokens are read directly from the window. When
+ * the window is exhausted, its last BZ_READER_PUTBACKLEN characters are moved
+ * to the front, so putback() works across the refills.
+ * With more than one thread the whole compressed file is loaded, the bzip2 blocks
+ * are located by their magic numbers, and they are decompressed in batches in
+ * parallel, each as a stand-alone stream. If a block cannot be decompressed this
+ * way (a false magic number in the data), the reader falls back to the serial
+ * decompression.
+ */
 class Bzip2WrapperReader
 {
 private:
     FILE* f;
     BZFILE* b;
-    int bzerror;
-    unsigned int bytesOut, bytesIn;
-    char buf[ BUFLEN ];
-    int bufPos;
+    int bzerror; //!< BZ_STREAM_END once a read was attempted past the end of the data
     string delim;
+    bool _isDelim[256];
     long int filePos;
     string _fname; 
 
+    vector<char> _window; //!< the decompressed data, with BZ_READER_PUTBACKLEN characters in front
+    size_t _pos; //!< the position of the next character in the window
+    size_t _end; //!< the end of the decompressed data in the window
+    size_t _delivered; //!< the number of decompressed bytes moved into the window
+    vector<char> _unused; //!< the bytes read after the end of a stream (concatenated streams)
+
+    int _numThreads;
+    bool _parallel; //!< the blocks are decompressed in parallel
+    vector<unsigned char> _compressed; //!< the whole compressed file (parallel mode)
+    vector< pair<size_t, size_t> > _blocks; //!< the bit ranges of the blocks (parallel mode)
+    size_t _nextBlock;
+    vector< vector<char> > _decoded; //!< the last decompressed batch of blocks
+    size_t _decodedIdx, _decodedPos;
+
+    void init( int numThreads );
+    bool fill();
+    size_t decompress( char* dest, size_t size );
+    size_t decompressSerial( char* dest, size_t size );
+    bool decompressNextBlocks();
+    bool findBlocks();
+    void openSerial( size_t skipBytes );
+
 public:
     /////////////////////////////////////////////////////////////////
     // constructors
-    Bzip2WrapperReader(void){ 
-        sprintf( buf, ", " );
-        setDelim( buf ); 
-        bufPos = 0;
-        filePos = 0;
+    Bzip2WrapperReader( void ) { 
+        init( 1 );
     }
 
-    Bzip2WrapperReader( const char* fname ) {
-        sprintf( buf, ", " );
-        setDelim( buf ); 
-        bufPos = 0;
-        filePos = 0;
-
+    /**
+     * Open the file.
+     * \param fname The name of the file.
+     * \param numThreads The number of threads decompressing the blocks.
+     */
+    Bzip2WrapperReader( const char* fname, int numThreads = 1 ) {
+        init( numThreads );
         open( fname );
-        _fname = fname;
     }
 
 
     /////////////////////////////////////////////////////////////////
     // open&close
-    void open( const char* fname ) {
-        bufPos = 0;
-        filePos = 0;
-
-        f = fopen ( fname, "rb" );
-        if ( !f ) {
-            cout << "cannot open bz2 file!!!!" << endl;
-        }
-
-        b = BZ2_bzReadOpen ( &bzerror, f, 0, 0, NULL, 0 );
-        if ( bzerror != BZ_OK ) {
-            BZ2_bzReadClose ( &bzerror, b );
-            cout << "error code " << bzerror << endl;
-        }
+    void open( const char* fname );
 
-        _fname = fname;
-    }
-
-    void close( void ) {
-        if ( bzerror != BZ_STREAM_END ) {
-            BZ2_bzReadClose ( &bzerror, b );
-        } else {
-            BZ2_bzReadClose ( &bzerror, b );
-        }
-        if ( f ) fclose( f );
-    }
+    void close( void );
 
     ///////////////////////////////////////////////////////////////
     // read data
     void putback( const char c ) {
-        buf[bufPos++] = c;
+        if ( _pos > 0 ) _window[--_pos] = c;
         filePos--;
     }
         
     friend int getline( Bzip2WrapperReader& bzr, string& str, char delim = 10 ) {
-        int i = 0;
-        int bzerror = 0;
-        char tmpBuf[ 65536 ];
-        BZFILE* b = bzr.getBzFilePointer();
-        char* buf = bzr.getBuffer();
-        int nbuf = 0;
-
-        while ( 1 ) {
-            int intChar = (char) bzr.get();
-            //nbuf = BZ2_bzRead ( &bzerror, b, tmpBuf, 1 );
-            //bzerror = BZ2_bzread( b, tmpBuf, 10 );
-            if ( intChar != -1 ) {
-                tmpBuf[ i ] = (char) intChar;
-                if ( ( tmpBuf[ i ] == delim ) || ( tmpBuf[ i ] == 10 ) ) {
-                    tmpBuf[i] = '\0';
-                    break;
-                }                               
-            } else {
-                bzr.setError( BZ_STREAM_END );
-                tmpBuf[i] = '\0';
-                break;
-            }
-
-            i++;
-        }
-                
-        str.clear();
-        str = tmpBuf;
-                
-        return 1;
+        return bzr.getLine( str, delim );
     }
 
          
@@ -154,65 +138,24 @@ public:
     }
         
     int get( void ) {
-        int bzerror = 0;
-        char tmpBuf[ 8 ];
-        int nbuf = 0;
-        int retval = -1;
-                
-        if ( bufPos > 0 ) {
-            retval = (int) buf[0];
-            for( int i = 0; i < bufPos-1; i++ ) buf[i] = buf[i+1];
-            bufPos--;
-        } else {
-            nbuf = BZ2_bzRead ( &bzerror, b, tmpBuf, 1 );
-            if ( bzerror == BZ_OK ) {
-                retval = (int) tmpBuf[0];
-            } else if ( bzerror == BZ_STREAM_END ) { 
-                setError( BZ_STREAM_END );
-            } else {
-                setError( BZ_STREAM_END );
-            }
-        }
         filePos++;
-
-        return retval;
+        if ( _pos == _end && !fill() ) {
+            setError( BZ_STREAM_END );
+            return -1;
+        }
+        return (int) _window[_pos++];
     }
-        
-
 
-    int getStringNextDelimiter( string& str ) {
-        int i = 0;
-        int bzerror = 0;
-        char tmpBuf[ 65536 ];
-        int nbuf = 0;
-        int retval = 1;
-                
-
-        while ( 1 ) {
-            int intChar = (char) get();
-            //nbuf = BZ2_bzRead ( &bzerror, b, tmpBuf, 1 );
-            //bzerror = BZ2_bzread( b, tmpBuf, 10 );
-            if ( ( intChar == 32 ) && ( i == 0 ) ) continue;
-            if ( intChar != -1 ) {
-                tmpBuf[ i ] = (char) intChar;
-                size_t t = delim.find( tmpBuf[i] );
-                if ( t != string::npos ) {
-                    tmpBuf[i] = '\0';
-                    break;
-                }                               
-            } else {
-                setError( BZ_STREAM_END );
-                tmpBuf[i] = '\0';
-                break;
-            }
-            i++;
-        }
+    /**
+     * Read the characters up to \a delim or the end of the line. Neither is stored.
+     */
+    int getLine( string& str, char delim );
 
-        str.clear();
-        str = tmpBuf;
-                
-        return retval;
-    }
+    /**
+     * Skip the leading spaces, then read the characters up to the next delimiter,
+     * which is consumed but not stored.
+     */
+    int getStringNextDelimiter( string& str );
 
     /////////////////////////////////////////////////////////////////////
     // destructors
@@ -220,8 +163,7 @@ public:
 
 
     bool is_open() {
-        if ( b ) return true;
-        else return false;
+        return ( b != NULL || _parallel );
     }
 
     bool eof() {
@@ -232,66 +174,34 @@ public:
 
     /////////////////////////////////////////////////////////////////////
     // getters and setters
-    char* getBuffer() {
-        return buf;
-    }
-
-    BZFILE * getBzFilePointer() {
-        if ( is_open() ) {
-            return b;
-        } else {
-            return 0;
-        }
-    }
-
     void setError( const int code ) {
         bzerror = code;
     }
         
-    void setDelim( const string s ) {
-        char tmpBuf[1024];
-        sprintf( tmpBuf, "%s\n", s.c_str() );
-        delim = s;
-    }
+    void setDelim( const string s );
 
     void setDelim( const char* s ) {
-        char tmpBuf[1024];
-        sprintf( tmpBuf, "%s\n", s );
-        delim = tmpBuf;
+        setDelim( string( s ) + "\n" );
     }
         
-    int getBufPos() { return bufPos; }
-    void setBufPos( int b ) { bufPos = b; }
-    void incrementBufPos() { bufPos++; }
-
     int getFilePos() { return filePos; }
     void setFilePos( int b ) { filePos = b; }
 
+    /**
+     * The number of rows from the current position: the number of newlines plus one.
+     * The rows are counted by a second reader, so the position of this one is kept.
+     */
+    int remainingRowNum();
 
-    int remainingRowNum() {
-        int rowCount = 0;
-        string tmpString;
-
-        int tmpFilePos = filePos;
-
-        getline( *this, tmpString );    
-        while( ! eof() ) {
-            rowCount++;
-            getline( *this, tmpString );    
-        }
-
-        setPos( tmpFilePos );
-        //getline( *this, tmpString );
-        rowCount++;
-
-        return rowCount;
-    }
-
+    /**
+     * Skip \a numChars characters.
+     */
+    void skip( long int numChars );
 
     void setPos( long int pos ) {
         close();
         open( _fname.c_str() );
-        for( int i = 0; i < pos; i++ ) get();
+        skip( pos );
     }
 };
 
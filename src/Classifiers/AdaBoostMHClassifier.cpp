@@ -38,12 +38,14 @@
 #include "IO/OutputInfo.h"
 #include "Classifiers/AdaBoostMHClassifier.h"
 #include "Classifiers/ExampleResults.h"
+#include "Classifiers/CompiledStumpModel.h"
 
 #include "WeakLearners/SingleStumpLearner.h" // for saveSingleStumpFeatureData
 
 #include <iomanip> // for setw
 #include <cmath> // for setw
 #include <functional>
+#include <algorithm> // for min
 
 namespace MultiBoost {
 
@@ -78,13 +80,13 @@ namespace MultiBoost {
         us.loadHypotheses(shypFileName, weakHypotheses, pData);
 
         // where the results go
-        vector< ExampleResults* > results;
+        VotesMatrix votes;
 
         if (_verbose > 0)
             cout << "Classifying..." << flush;
 
         // get the results
-        computeResults( pData, weakHypotheses, results, numIterations );
+        computeResults( pData, weakHypotheses, votes, numIterations );
 
         const int numClasses = pData->getNumClasses();
 
@@ -97,7 +99,7 @@ namespace MultiBoost {
 
             // Get the per-class error for the numRanksEnclosed-th ranks
             for (int i = 0; i < numRanksEnclosed; ++i)
-                getClassError( pData, results, rankedError[i], i );
+                getClassError( pData, votes, rankedError[i], i );
 
             // output it
             cout << endl;
@@ -124,14 +126,14 @@ namespace MultiBoost {
 
             // the overall error
             cout << "\n--> Overall Error: " 
-                 << setprecision(4) << getOverallError(pData, results, 0) * 100 << "%";
+                 << setprecision(4) << getOverallError(pData, votes, 0) * 100 << "%";
 
             // output the others on its side
             if (numRanksEnclosed > 1 && _verbose > 1)
             {
                 cout << " (";
                 for (int i = 1; i < numRanksEnclosed; ++i)
-                    cout << " " << i+1 << ":[" << setprecision(4) << getOverallError(pData, results, i) * 100 << "%]";
+                    cout << " " << i+1 << ":[" << setprecision(4) << getOverallError(pData, votes, i) * 100 << "%]";
                 cout << " )";
             }
 
@@ -146,6 +148,9 @@ namespace MultiBoost {
             const int numExamples = pData->getNumExamples();
             ofstream outRes(outResFileName.c_str());
 
+            vector<int> winners;
+            getWinners( votes, winners );
+
             outRes << "Instance" << '\t' << "Forecast" << '\t' << "Labels" << '\n';
                         
             string exampleName;
@@ -161,7 +166,7 @@ namespace MultiBoost {
                     outRes << exampleName << '\t';
                                 
                 // output the predicted class
-                outRes << pData->getClassMap().getNameFromIdx( results[i]->getWinner().first ) << '\t';
+                outRes << pData->getClassMap().getNameFromIdx( winners[i] ) << '\t';
                                 
                 outRes << '|';
                                 
@@ -185,10 +190,6 @@ namespace MultiBoost {
         // delete the input data file
         if (pData) 
             delete pData;
-
-        vector<ExampleResults*>::iterator it;
-        for (it = results.begin(); it != results.end(); ++it)
-            delete (*it);
     }
 
     // -------------------------------------------------------------------------
@@ -210,13 +211,13 @@ namespace MultiBoost {
         us.loadHypotheses(shypFileName, weakHypotheses, pData);
 
         // where the results go
-        vector< ExampleResults* > results;
+        VotesMatrix votes;
 
         if (_verbose > 0)
             cout << "Classifying..." << flush;
 
         // get the results
-        computeResults( pData, weakHypotheses, results, (int)weakHypotheses.size());
+        computeResults( pData, weakHypotheses, votes, (int)weakHypotheses.size());
 
         const int numClasses = pData->getNumClasses();
         const int numExamples = pData->getNumExamples();
@@ -236,13 +237,16 @@ namespace MultiBoost {
 
             cout << "\nTruth\n";
 
+            vector<int> winners;
+            getWinners( votes, winners );
+
             for (int l = 0; l < numClasses; ++l)
             {
                 vector<int> winnerCount(numClasses, 0);
                 for (int i = 0; i < numExamples; ++i)
                 {
                     if ( pData->hasPositiveLabel(i, l) )
-                        ++winnerCount[ results[i]->getWinner().first ];
+                        ++winnerCount[ winners[i] ];
                 }
 
                 // class
@@ -266,10 +270,6 @@ namespace MultiBoost {
         // delete the input data file
         if (pData) 
             delete pData;
-
-        vector<ExampleResults*>::iterator it;
-        for (it = results.begin(); it != results.end(); ++it)
-            delete (*it);
     }
 
     // -------------------------------------------------------------------------
@@ -292,13 +292,13 @@ namespace MultiBoost {
         us.loadHypotheses(shypFileName, weakHypotheses, pData);
 
         // where the results go
-        vector< ExampleResults* > results;
+        VotesMatrix votes;
 
         if (_verbose > 0)
             cout << "Classifying..." << flush;
 
         // get the results
-        computeResults( pData, weakHypotheses, results, (int)weakHypotheses.size() );
+        computeResults( pData, weakHypotheses, votes, (int)weakHypotheses.size() );
 
         const int numClasses = pData->getNumClasses();
         const int numExamples = pData->getNumExamples();
@@ -307,6 +307,10 @@ namespace MultiBoost {
 
         //////////////////////////////////////////////////////////////////////////
 
+        vector<int> winners;
+        getWinners( votes, winners );
+
+
         for (int l = 0; l < numClasses; ++l)
             outFile << '\t' << pData->getClassMap().getNameFromIdx(l);
         outFile << endl;
@@ -317,7 +321,7 @@ namespace MultiBoost {
             for (int i = 0; i < numExamples; ++i)
             {
                 if ( pData->hasPositiveLabel(i,l) )
-                    ++winnerCount[ results[i]->getWinner().first ];
+                    ++winnerCount[ winners[i] ];
             }
 
             // class name
@@ -337,10 +341,6 @@ namespace MultiBoost {
         // delete the input data file
         if (pData) 
             delete pData;
-
-        vector<ExampleResults*>::iterator it;
-        for (it = results.begin(); it != results.end(); ++it)
-            delete (*it);
     }
 
     // -------------------------------------------------------------------------
@@ -363,7 +363,7 @@ namespace MultiBoost {
         us.loadHypotheses(shypFileName, weakHypotheses, pData);
 
         // where the results go
-        vector< ExampleResults* > results;
+        VotesMatrix votes;
 
         if (_verbose > 0)
             cout << "Classifying..." << flush;
@@ -372,7 +372,7 @@ namespace MultiBoost {
             period=numIterations;
                 
         // get the results
-        computeResults( pData, weakHypotheses, results, period );
+        computeResults( pData, weakHypotheses, votes, period );
 
         const int numClasses = pData->getNumClasses();
         const int numExamples = pData->getNumExamples();
@@ -395,9 +395,9 @@ namespace MultiBoost {
                 outFile << exampleName << ',';
 
             // output the posteriors
-            outFile << results[i]->getVotesVector()[0];
+            outFile << votes.getVotes(i)[0];
             for (int l = 1; l < numClasses; ++l)
-                outFile << ',' << results[i]->getVotesVector()[l];
+                outFile << ',' << votes.getVotes(i)[l];
             outFile << '\n';
         }
 
@@ -406,7 +406,7 @@ namespace MultiBoost {
         {
             if ( (p+period) > weakHypotheses.size() ) break;
                         
-            continueComputingResults(pData, weakHypotheses, results, p, p+period );
+            continueComputingResults(pData, weakHypotheses, votes, p, p+period );
             if ( _verbose > 0) {
                 cout << "Write out the posterios for iteration " << p << endl;
             }
@@ -420,9 +420,9 @@ namespace MultiBoost {
                     outFile << exampleName << ',';
                                 
                 // output the posteriors
-                outFile << results[i]->getVotesVector()[0];
+                outFile << votes.getVotes(i)[0];
                 for (int l = 1; l < numClasses; ++l)
-                    outFile << ',' << results[i]->getVotesVector()[l];
+                    outFile << ',' << votes.getVotes(i)[l];
                 outFile << '\n';
             }
                         
@@ -441,10 +441,6 @@ namespace MultiBoost {
         // delete the input data file
         if (pData) 
             delete pData;
-
-        vector<ExampleResults*>::iterator it;
-        for (it = results.begin(); it != results.end(); ++it)
-            delete (*it);
     }
 
 
@@ -469,13 +465,13 @@ namespace MultiBoost {
         us.loadHypotheses(shypFileName, weakHypotheses, pData);
 
         // where the results go
-        vector< ExampleResults* > results;
+        VotesMatrix votes;
 
         if (_verbose > 0)
             cout << "Classifying..." << flush;
 
         // get the results
-        computeResults( pData, weakHypotheses, results, numIterations );
+        computeResults( pData, weakHypotheses, votes, numIterations );
 
         const int numClasses = pData->getNumClasses();
         const int numExamples = pData->getNumExamples();
@@ -495,9 +491,9 @@ namespace MultiBoost {
                 outFile << exampleName << ',';
 
             // output the posteriors
-            outFile << results[i]->getVotesVector()[0];
+            outFile << votes.getVotes(i)[0];
             for (int l = 1; l < numClasses; ++l)
-                outFile << ',' << results[i]->getVotesVector()[l];
+                outFile << ',' << votes.getVotes(i)[l];
             outFile << '\n';
         }
 
@@ -514,10 +510,6 @@ namespace MultiBoost {
         // delete the input data file
         if (pData) 
             delete pData;
-
-        vector<ExampleResults*>::iterator it;
-        for (it = results.begin(); it != results.end(); ++it)
-            delete (*it);
     }
 
 
@@ -542,7 +534,7 @@ namespace MultiBoost {
         us.loadHypotheses(shypFileName, weakHypotheses, pData);
 
         // where the results go
-        vector< ExampleResults* > results;
+        VotesMatrix votes;
 
         if (_verbose > 0)
             cout << "Classifying..." << flush;
@@ -559,7 +551,7 @@ namespace MultiBoost {
 
         // get the results
         /////////////////////////////////////////////////////////////////////
-        // computeResults( pData, weakHypotheses, results, numIterations );
+        // computeResults( pData, weakHypotheses, votes, numIterations );
         assert( !weakHypotheses.empty() );
 
         // Initialize the output info
@@ -568,40 +560,29 @@ namespace MultiBoost {
         if ( !_outputInfoFile.empty() )
             pOutInfo = new OutputInfo(_args);
 
-        // Creating the results structures. See file Structures.h for the
-        // PointResults structure
-        results.clear();
-        results.reserve(numExamples);
-        for (int i = 0; i < numExamples; ++i)
-            results.push_back( new ExampleResults(i, numClasses) );
+        votes.reset(numExamples, numClasses);
 
-        // sum votes for classes
-        vector< AlphaReal > votesForExamples( numClasses );
-        vector< AlphaReal > expVotesForExamples( numClasses );
+        // the terms of the log-likelihood, per example and class, so that they
+        // can be computed in parallel and summed in the original order
+        vector< AlphaReal > likelihoodTerms( numExamples * numClasses );
+
+        const int numThreads = nor_utils::getNumThreads();
 
         // iterator over all the weak hypotheses
         vector<BaseLearner*>::const_iterator whyIt;
         int t;
 
-        pOutInfo->initialize( pData );
+        if ( pOutInfo )
+            pOutInfo->initialize( pData );
 
         // for every feature: 1..T
         for (whyIt = weakHypotheses.begin(), t = 0; 
              whyIt != weakHypotheses.end() && t < numIterations; ++whyIt, ++t)
         {
             BaseLearner* currWeakHyp = *whyIt;
-            AlphaReal alpha = currWeakHyp->getAlpha();
 
             // for every point
-            for (int i = 0; i < numExamples; ++i)
-            {
-                // a reference for clarity and speed
-                vector<AlphaReal>& currVotesVector = results[i]->getVotesVector();
-
-                // for every class
-                for (int l = 0; l < numClasses; ++l)
-                    currVotesVector[l] += alpha * currWeakHyp->classify(pData, i, l);
-            }
+            addVotes( pData, weakHypotheses, votes, t, t+1 );
 
             // if needed output the step-by-step information
             if ( pOutInfo )
@@ -619,49 +600,56 @@ namespace MultiBoost {
             } // for (int i = 0; i < numExamples; ++i)
             // calculate likelihoods from votes
 
-            fill( votesForExamples.begin(), votesForExamples.end(), 0.0 );
-            AlphaReal lLambda = 0.0;
-            for (int i = 0; i < numExamples; ++i)
+#pragma omp parallel num_threads(numThreads) if (numThreads > 1)
             {
-                // a reference for clarity and speed
-                vector<AlphaReal>& currVotesVector = results[i]->getVotesVector();
-                AlphaReal sumExp = 0.0;
-                // for every class
-                for (int l = 0; l < numClasses; ++l) 
-                {                                
-                    expVotesForExamples[l] =  exp( currVotesVector[l] ) ;
-                    sumExp += expVotesForExamples[l];
-                }                       
-
-                if ( sumExp > numeric_limits<AlphaReal>::epsilon() ) 
+                vector< AlphaReal > expVotesForExamples( numClasses );
+
+#pragma omp for schedule(static)
+                for (int i = 0; i < numExamples; ++i)
                 {
+                    // a reference for clarity and speed
+                    const AlphaReal* currVotesVector = votes.getVotes(i);
+                    AlphaReal sumExp = 0.0;
+                    // for every class
                     for (int l = 0; l < numClasses; ++l) 
+                    {                                
+                        expVotesForExamples[l] =  exp( currVotesVector[l] ) ;
+                        sumExp += expVotesForExamples[l];
+                    }                       
+
+                    if ( sumExp > numeric_limits<AlphaReal>::epsilon() ) 
                     {
-                        expVotesForExamples[l] /= sumExp;
+                        for (int l = 0; l < numClasses; ++l) 
+                        {
+                            expVotesForExamples[l] /= sumExp;
+                        }
                     }
-                }
 
-                Example ex = pData->getExample( results[i]->getIdx() );
-                vector<Label> labs = ex.getLabels();
-                AlphaReal m = numeric_limits<AlphaReal>::infinity();
-                for (int l = 0; l < numClasses; ++l)  
-                {
-                    if ( labs[l].y > 0 )
+                    const vector<Label>& labs = pData->getLabels(i);
+                    AlphaReal* terms = &likelihoodTerms[ i * numClasses ];
+                    AlphaReal m = numeric_limits<AlphaReal>::infinity();
+                    for (int l = 0; l < numClasses; ++l)  
                     {
-                        if ( expVotesForExamples[l] > numeric_limits<AlphaReal>::epsilon() )
+                        terms[l] = 0.0;
+                        if ( labs[l].y > 0 )
                         {
-                            AlphaReal logVal = log( expVotesForExamples[l] );
+                            if ( expVotesForExamples[l] > numeric_limits<AlphaReal>::epsilon() )
+                            {
+                                AlphaReal logVal = log( expVotesForExamples[l] );
                                                         
-                            if ( logVal != m ) {
-                                lLambda += ( ( 1.0/(AlphaReal)numExamples ) * logVal );
+                                if ( logVal != m ) {
+                                    terms[l] = ( ( 1.0/(AlphaReal)numExamples ) * logVal );
+                                }
                             }
                         }
                     }
                 }
-
-
             }
-                        
+
+            // adding the zeros of the missing terms does not change the sum
+            AlphaReal lLambda = 0.0;
+            for (int k = 0; k < numExamples * numClasses; ++k)
+                lLambda += likelihoodTerms[k];
 
             outFile << t << "\t" << lLambda ;
             outFile << '\n';
@@ -672,7 +660,7 @@ namespace MultiBoost {
         if (pOutInfo)
             delete pOutInfo;
 
-        // computeResults( pData, weakHypotheses, results, numIterations );
+        // computeResults( pData, weakHypotheses, votes, numIterations );
         ///////////////////////////////////////////////////////////////////////////////////
 
 
@@ -686,9 +674,9 @@ namespace MultiBoost {
           outFile << exampleName << ',';
 
           // output the posteriors
-          outFile << results[i]->getVotesVector()[0];
+          outFile << votes.getVotes(i)[0];
           for (int l = 1; l < numClasses; ++l)
-          outFile << ',' << results[i]->getVotesVector()[l];
+          outFile << ',' << votes.getVotes(i)[l];
           outFile << '\n';
           }
         */
@@ -706,39 +694,28 @@ namespace MultiBoost {
         // delete the input data file
         if (pData) 
             delete pData;
-
-        vector<ExampleResults*>::iterator it;
-        for (it = results.begin(); it != results.end(); ++it)
-            delete (*it);
     }
 
 
     // -------------------------------------------------------------------------
     // -------------------------------------------------------------------------
 
-    InputData* AdaBoostMHClassifier::loadInputData(const string& dataFileName, const string& shypFileName)
+    void AdaBoostMHClassifier::convertHypotheses(const string& dataFileName, const string& shypFileName,
+                                                 const string& outShypFileName)
     {
-        // open file
-        ifstream inFile(shypFileName.c_str());
-        if (!inFile.is_open())
-        {
-            cerr << "ERROR: Cannot open strong hypothesis file <" << shypFileName << ">!" << endl;
-            exit(1);
-        }
+        InputData* pData = loadInputData(dataFileName, shypFileName);
 
-        // Declares the stream tokenizer
-        nor_utils::StreamTokenizer st(inFile, "<>\n\r\t");
+        Serialization::convertHypotheses(shypFileName, outShypFileName, pData, _verbose);
 
-        // Move until it finds the multiboost tag
-        if ( !UnSerialization::seekSimpleTag(st, "multiboost") )
-        {
-            // no multiboost tag found: this is not the correct file!
-            cerr << "ERROR: Not a valid MultiBoost Strong Hypothesis file!!" << endl;
-            exit(1);
-        }
+        delete pData;
+    }
 
-        // Move until it finds the algo tag
-        string basicLearnerName = UnSerialization::seekAndParseEnclosedValue<string>(st, "algo");
+    // -------------------------------------------------------------------------
+
+    InputData* AdaBoostMHClassifier::loadInputData(const string& dataFileName, const string& shypFileName)
+    {
+        // the name of the weak learner, from the xml or the binary header
+        string basicLearnerName = UnSerialization::getWeakLearnerName(shypFileName);
 
         // Check if the weak learner exists
         if ( !BaseLearner::RegisteredLearners().hasLearner(basicLearnerName) )
@@ -764,7 +741,7 @@ namespace MultiBoost {
 
     // Returns the results into ptRes
     void AdaBoostMHClassifier::computeResults(InputData* pData, vector<BaseLearner*>& weakHypotheses, 
-                                              vector< ExampleResults* >& results, int numIterations)
+                                              VotesMatrix& votes, int numIterations)
     {
         assert( !weakHypotheses.empty() );
 
@@ -780,17 +757,13 @@ namespace MultiBoost {
             
         }
         
+        // Creating the results structure. See file ExampleResults.h for the
+        // VotesMatrix structure
+        votes.reset(numExamples, numClasses);
 
-        // Creating the results structures. See file Structures.h for the
-        // PointResults structure
-        results.clear();
-        results.reserve(numExamples);
-        for (int i = 0; i < numExamples; ++i)
-            results.push_back( new ExampleResults(i, numClasses) );
-
-        // iterator over all the weak hypotheses
-        vector<BaseLearner*>::const_iterator whyIt;
-        int t;
+        // the votes do not depend on the step-by-step information, so they are
+        // computed at once (in parallel)
+        addVotes( pData, weakHypotheses, votes, 0, numIterations );
 
         if ( pOutInfo )
         {
@@ -800,29 +773,18 @@ namespace MultiBoost {
                                    false, // output time
                                    true // endline
                 );
-        }
 
-        // for every feature: 1..T
-        for (whyIt = weakHypotheses.begin(), t = 0; 
-             whyIt != weakHypotheses.end() && t < numIterations; ++whyIt, ++t)
-        {
-            BaseLearner* currWeakHyp = *whyIt;
-            AlphaReal alpha = currWeakHyp->getAlpha();
+            // iterator over all the weak hypotheses
+            vector<BaseLearner*>::const_iterator whyIt;
+            int t;
 
-            // for every point
-            for (int i = 0; i < numExamples; ++i)
+            // for every feature: 1..T
+            for (whyIt = weakHypotheses.begin(), t = 0; 
+                 whyIt != weakHypotheses.end() && t < numIterations; ++whyIt, ++t)
             {
-                // a reference for clarity and speed
-                vector<AlphaReal>& currVotesVector = results[i]->getVotesVector();
-
-                // for every class
-                for (int l = 0; l < numClasses; ++l)
-                    currVotesVector[l] += alpha * currWeakHyp->classify(pData, i, l);
-            }
+                BaseLearner* currWeakHyp = *whyIt;
 
-            // if needed output the step-by-step information
-            if ( pOutInfo )
-            {
+                // output the step-by-step information
                 pOutInfo->outputIteration(t);
 //                              pOutInfo->outputError(pData, currWeakHyp);
 //                              pOutInfo->outTPRFPR(pData);
@@ -838,10 +800,9 @@ namespace MultiBoost {
                 //outInfo.outputEdge(pData, currWeakHyp);
                 pOutInfo->endLine();
             }
-        }
 
-        if (pOutInfo)
             delete pOutInfo;
+        }
 
     }
         
@@ -850,56 +811,98 @@ namespace MultiBoost {
     // Continue returns the results into ptRes for savePosteriors
     // must be called the computeResult first!!!
     void AdaBoostMHClassifier::continueComputingResults(InputData* pData, vector<BaseLearner*>& weakHypotheses, 
-                                                        vector< ExampleResults* >& results, int fromIteration, int toIteration)
+                                                        VotesMatrix& votes, int fromIteration, int toIteration)
     {
         assert( !weakHypotheses.empty() );
                 
+        addVotes( pData, weakHypotheses, votes, fromIteration, toIteration );
+    }
+        
+    // -------------------------------------------------------------------------
+
+    void AdaBoostMHClassifier::addVotes(InputData* pData, vector<BaseLearner*>& weakHypotheses, 
+                                        VotesMatrix& votes, int fromIteration, int toIteration)
+    {
         const int numClasses = pData->getNumClasses();
         const int numExamples = pData->getNumExamples();
-                
-                                                
-        // iterator over all the weak hypotheses
-        vector<BaseLearner*>::const_iterator whyIt;
-        int t;
 
-        for (whyIt = weakHypotheses.begin(), t = 0; 
-             whyIt != weakHypotheses.end() && t < fromIteration; ++whyIt, ++t) {}
-                
-        // for every feature: 1..T
-        for (;whyIt != weakHypotheses.end() && t < toIteration; ++whyIt, ++t)
+        toIteration = min( toIteration, (int)weakHypotheses.size() );
+
+        // stumps are scored in blocks with the compiled model, the other
+        // learners through classify()
+        CompiledStumpModel compiledModel;
+        const bool isCompiled = compiledModel.compile( weakHypotheses, fromIteration, toIteration, numClasses );
+
+        // every chunk of examples is processed by a single thread, hypothesis
+        // by hypothesis, so the votes are summed in the serial order
+        const int chunkSize = 256;
+        const int numChunks = (numExamples + chunkSize - 1) / chunkSize;
+        const int numThreads = nor_utils::getNumThreads();
+
+#pragma omp parallel num_threads(numThreads) if (numThreads > 1)
         {
-            BaseLearner* currWeakHyp = *whyIt;
-            AlphaReal alpha = currWeakHyp->getAlpha();
-                        
-            // for every point
-            for (int i = 0; i < numExamples; ++i)
+#pragma omp for schedule(dynamic)
+            for (int c = 0; c < numChunks; ++c)
             {
-                // a reference for clarity and speed
-                vector<AlphaReal>& currVotesVector = results[i]->getVotesVector();
-                                
-                // for every class
-                for (int l = 0; l < numClasses; ++l)
-                    currVotesVector[l] += alpha * currWeakHyp->classify(pData, i, l);
-            }                       
+                const int beginIdx = c * chunkSize;
+                const int endIdx = min( beginIdx + chunkSize, numExamples );
+
+                if ( isCompiled )
+                {
+                    compiledModel.addVotes( pData, votes, beginIdx, endIdx );
+                    continue;
+                }
+
+                for (int t = fromIteration; t < toIteration; ++t)
+                {
+                    BaseLearner* currWeakHyp = weakHypotheses[t];
+                    AlphaReal alpha = currWeakHyp->getAlpha();
+
+                    // for every point
+                    for (int i = beginIdx; i < endIdx; ++i)
+                    {
+                        AlphaReal* currVotesVector = votes.getVotes(i);
+
+                        // for every class
+                        for (int l = 0; l < numClasses; ++l)
+                            currVotesVector[l] += alpha * currWeakHyp->classify(pData, i, l);
+                    }
+                }
+            }
         }
-                
     }
-        
+
     // -------------------------------------------------------------------------
 
-    float AdaBoostMHClassifier::getOverallError( InputData* pData, const vector<ExampleResults*>& results, 
+    void AdaBoostMHClassifier::getWinners( const VotesMatrix& votes, vector<int>& winners )
+    {
+        const int numExamples = votes.getNumExamples();
+        const int numThreads = nor_utils::getNumThreads();
+
+        winners.resize( numExamples );
+
+#pragma omp parallel for num_threads(numThreads) if (numThreads > 1) schedule(static)
+        for (int i = 0; i < numExamples; ++i)
+            winners[i] = votes.getWinner(i).first;
+    }
+
+    // -------------------------------------------------------------------------
+
+    float AdaBoostMHClassifier::getOverallError( InputData* pData, const VotesMatrix& votes, 
                                                  int atLeastRank )
     {
         const int numExamples = pData->getNumExamples();
+        const int numThreads = nor_utils::getNumThreads();
         int numErrors = 0;
 
         assert(atLeastRank >= 0);
 
+#pragma omp parallel for num_threads(numThreads) if (numThreads > 1) reduction(+:numErrors) schedule(static)
         for (int i = 0; i < numExamples; ++i)
         {
             // if the actual class is not the one with the highest vote in the
             // vote vector, then it is an error!
-            if ( !results[i]->isWinner( pData->getExample(i), atLeastRank ) )
+            if ( !votes.isWinner( i, pData->getExample(i), atLeastRank ) )
                 ++numErrors;
         }  
 
@@ -909,33 +912,47 @@ namespace MultiBoost {
 
     // -------------------------------------------------------------------------
 
-    void AdaBoostMHClassifier::getClassError( InputData* pData, const vector<ExampleResults*>& results, 
+    void AdaBoostMHClassifier::getClassError( InputData* pData, const VotesMatrix& votes, 
                                               vector<float>& classError, int atLeastRank )
     {
         const int numExamples = pData->getNumExamples();
         const int numClasses = pData->getNumClasses();
+        const int numThreads = nor_utils::getNumThreads();
 
         classError.resize( numClasses, 0 );
 
         assert(atLeastRank >= 0);
 
-        for (int i = 0; i < numExamples; ++i)
+        // the errors are counted per thread, then added (the counts are exact)
+        vector< vector<int> > threadErrors( numThreads, vector<int>(numClasses, 0) );
+
+#pragma omp parallel num_threads(numThreads) if (numThreads > 1)
         {
-            // if the actual class is not the one with the highest vote in the
-            // vote vector, then it is an error!
-            if ( !results[i]->isWinner( pData->getExample(i), atLeastRank ) )
+            vector<int>& errors = threadErrors[ nor_utils::getThreadIdx() ];
+
+#pragma omp for schedule(static)
+            for (int i = 0; i < numExamples; ++i)
             {
-                const vector<Label>& labels = pData->getLabels(i);
-                vector<Label>::const_iterator lIt;
-                for ( lIt = labels.begin(); lIt != labels.end(); ++lIt )
+                // if the actual class is not the one with the highest vote in the
+                // vote vector, then it is an error!
+                if ( !votes.isWinner( i, pData->getExample(i), atLeastRank ) )
                 {
-                    if ( lIt->y > 0 )
-                        ++classError[ lIt->idx ];
+                    const vector<Label>& labels = pData->getLabels(i);
+                    vector<Label>::const_iterator lIt;
+                    for ( lIt = labels.begin(); lIt != labels.end(); ++lIt )
+                    {
+                        if ( lIt->y > 0 )
+                            ++errors[ lIt->idx ];
+                    }
+                    //++classError[ pData->getClass(i) ];
                 }
-                //++classError[ pData->getClass(i) ];
             }
         }
 
+        for (int t = 0; t < numThreads; ++t)
+            for (int l = 0; l < numClasses; ++l)
+                classError[l] += threadErrors[t][l];
+
         // makes the error between 0 and 1
         for (int l = 0; l < numClasses; ++l)
             classError[l] /= (float)pData->getNumExamplesPerClass(l);
@@ -52,7 +52,7 @@ namespace MultiBoost {
     //////////////////////////////////////////////////////////////////////////////////////////////
         
     // Forward declarations.
-    class ExampleResults;
+    class VotesMatrix;
     class InputData;
     class BaseLearner;
         
@@ -167,6 +167,18 @@ namespace MultiBoost {
                 
         void saveLikelihoods(const string& dataFileName, const string& shypFileName,
                              const string& outFileName, int numIterations);
+
+        /**
+         * Convert a strong hypothesis file between xml and binary (a binary file
+         * is converted into xml, and an xml file into binary).
+         * \param dataFileName The name of the data file, for the names of the classes and attributes.
+         * \param shypFileName The name of the strong hypothesis file to convert.
+         * \param outShypFileName The name of the converted strong hypothesis file.
+         * \see Serialization::convertHypotheses
+         * \date 16/10/2026
+         */
+        void convertHypotheses(const string& dataFileName, const string& shypFileName,
+                               const string& outShypFileName);
                 
         /**
          * Save the data generated by using the strong hypothesis file of 
@@ -221,45 +233,71 @@ namespace MultiBoost {
          * This method is the one that effectively computes \f${\bf g}(x)\f$.
          * \param pData A pointer to the data to be classified.
          * \param weakHypotheses The list of weak hypotheses.
-         * \param results The vector where the results will be stored.
-         * \see ExampleResults
+         * \param votes The matrix where the results will be stored.
+         * \param numIterations The number of weak hypotheses to use.
+         * \see VotesMatrix
          * \date 16/11/2005
          */
         virtual void computeResults(InputData* pData, vector<BaseLearner*>& weakHypotheses, 
-                                    vector< ExampleResults* >& results, int numIterations );
+                                    VotesMatrix& votes, int numIterations );
                 
                 
         virtual void continueComputingResults(InputData* pData, vector<BaseLearner*>& weakHypotheses, 
-                                              vector< ExampleResults* >& results, int fromIteration, int toIteration);
+                                              VotesMatrix& votes, int fromIteration, int toIteration);
+
+        /**
+         * Add the votes of the weak hypotheses [fromIteration, toIteration) to 
+         * \a votes. The examples are split among the threads (see --threads), 
+         * each example being updated by a single thread in the order of the
+         * hypotheses, so the result does not depend on the number of threads.
+         * Stumps are scored with CompiledStumpModel, the other learners with
+         * BaseLearner::classify().
+         * \param pData A pointer to the data to be classified.
+         * \param weakHypotheses The list of weak hypotheses.
+         * \param votes The matrix of the votes to update.
+         * \param fromIteration The first weak hypothesis.
+         * \param toIteration The weak hypothesis after the last one.
+         * \date 16/10/2026
+         */
+        void addVotes(InputData* pData, vector<BaseLearner*>& weakHypotheses, 
+                      VotesMatrix& votes, int fromIteration, int toIteration);
+
+        /**
+         * Get the winner class of every example, in parallel.
+         * \param votes The votes of the examples.
+         * \param winners The returned class indices.
+         * \date 16/10/2026
+         */
+        void getWinners( const VotesMatrix& votes, vector<int>& winners );
                 
         /**
          * Compute the overall error on the data.
          * \param pData A pointer to the data. Needed to get the actual class of 
          * the example.
-         * \param results The vector where the results are hold.
+         * \param votes The matrix where the results are hold.
          * \param atLeastRank The maximum rank in which the classification will not be considered
          * an error. If \a atLeastRank = 0, no errors are allowed. If it is 1, the second "guess"
          * will be taken into consideration, among the first, and so on.
          * \return The error.
-         * \see ExampleResults
+         * \see VotesMatrix
          * \date 16/11/2005
          */
-        float getOverallError( InputData* pData, const vector< ExampleResults* >& results, 
+        float getOverallError( InputData* pData, const VotesMatrix& votes, 
                                int atLeastRank = 0 );
                 
         /**
          * Compute the error per class.
          * \param pData A pointer to the data. Needed to get the actual class of 
          * the example.
-         * \param results The vector where the results are hold.
+         * \param votes The matrix where the results are hold.
          * \param classError The returned per class errors.
          * \param atLeastRank The maximum rank in which the classification will not be considered
          * an error. If \a atLeastRank = 0, no errors are allowed. If it is 1, the second "guess"
          * will be taken into consideration, among the first, and so on.
-         * \see ExampleResults
+         * \see VotesMatrix
          * \date 16/11/2005
          */
-        void getClassError( InputData* pData,  const vector< ExampleResults* >& results, 
+        void getClassError( InputData* pData,  const VotesMatrix& votes, 
                             vector<float>& classError, int atLeastRank = 0  );
                 
         /**
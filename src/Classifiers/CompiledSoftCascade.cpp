@@ -0,0 +1,191 @@
+/*
+ *
+ *    MultiBoost - Multi-purpose boosting package
+ *
+ *    Copyright (C)        AppStat group
+ *                         Laboratoire de l'Accelerateur Lineaire
+ *                         Universite Paris-Sud, 11, CNRS
+ *
+ *    This file is part of the MultiBoost library
+ *
+ *    This library is free software; you can redistribute it 
+ *    and/or modify it under the terms of the GNU General Public
+ *    License as published by the Free Software Foundation
+ *    version 2.1 of the License.
+ *
+ *    This library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *    General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public
+ *    License along with this library; if not, write to the Free Software
+ *    Foundation, Inc., 51 Franklin St, 5th Floor, Boston, MA 02110-1301 USA
+ *
+ *    Contact: : multiboost@googlegroups.com
+ *
+ *    For more information and up-to-date version, please visit
+ *        
+ *                       http://www.multiboost.org/
+ *
+ */
+
+
+
+
+
+#include "Classifiers/CompiledSoftCascade.h"
+#include "IO/InputData.h"
+#include "WeakLearners/SingleStumpLearner.h"
+
+#include <algorithm> // for min
+#include <typeinfo> // for typeid
+
+namespace MultiBoost {
+
+    // -------------------------------------------------------------------------
+    // -------------------------------------------------------------------------
+
+    void CompiledSoftCascade::compile( const vector<BaseLearner*>& weakHypotheses, 
+                                       const vector<AlphaReal>& rejectionThresholds,
+                                       int positiveLabelIndex )
+    {
+        _positiveLabelIndex = positiveLabelIndex;
+        _stages.resize( weakHypotheses.size() );
+
+        for (int s = 0; s < (int)weakHypotheses.size(); ++s)
+        {
+            BaseLearner* pWeakHyp = weakHypotheses[s];
+            Stage& stage = _stages[s];
+
+            stage.column = -1;
+            stage.threshold = 0;
+            stage.vote = 0;
+            stage.rejectionThreshold = rejectionThresholds[s];
+            stage.alpha = pWeakHyp->getAlpha();
+            stage.pWeakHyp = pWeakHyp;
+
+            // only the exact type: the derived classes may redefine phi()
+            if ( typeid(*pWeakHyp) == typeid(SingleStumpLearner) )
+            {
+                SingleStumpLearner* pStump = dynamic_cast<SingleStumpLearner*>(pWeakHyp);
+                if ( positiveLabelIndex < (int)pStump->_v.size() )
+                {
+                    stage.column = pStump->getSelectedColumn();
+                    stage.threshold = pStump->getThreshold();
+                    // phi is +1 or -1, so alpha * (v * phi) == phi * (alpha * v) exactly
+                    stage.vote = stage.alpha * pStump->_v[positiveLabelIndex];
+                }
+            }
+        }
+
+        _currentStage = 0;
+    }
+
+    // -------------------------------------------------------------------------
+
+    void CompiledSoftCascade::reset( InputData* pData )
+    {
+        const int numExamples = pData->getNumExamples();
+
+        _currentStage = 0;
+        _numEvaluationsSum = 0;
+
+        _activeIndices.resize( numExamples );
+        for (int i = 0; i < numExamples; ++i)
+            _activeIndices[i] = i;
+
+        _posteriors.assign( numExamples, 0. );
+        _numEvaluations.assign( numExamples, 0 );
+        _forecasts.assign( numExamples, 1 );
+    }
+
+    // -------------------------------------------------------------------------
+
+    void CompiledSoftCascade::evaluate( InputData* pData, int toStage )
+    {
+        toStage = min( toStage, (int)_stages.size() );
+        if ( toStage <= _currentStage )
+            return;
+
+        const bool isDense = ( pData->getDataRep() == DR_DENSE );
+        const int numActive = (int)_activeIndices.size();
+        int numSurvivors = 0;
+
+        vector<int> blockIndices( BLOCK_SIZE );
+        vector<AlphaReal> blockPosteriors( BLOCK_SIZE );
+
+        for (int blockBegin = 0; blockBegin < numActive; blockBegin += BLOCK_SIZE)
+        {
+            int blockSize = min( (int)BLOCK_SIZE, numActive - blockBegin );
+
+            for (int j = 0; j < blockSize; ++j)
+            {
+                blockIndices[j] = _activeIndices[ blockBegin + j ];
+                blockPosteriors[j] = _posteriors[ blockIndices[j] ];
+            }
+
+            for (int s = _currentStage; s < toStage && blockSize > 0; ++s)
+            {
+                const Stage& stage = _stages[s];
+
+                if ( stage.column < 0 )
+                {
+                    for (int j = 0; j < blockSize; ++j)
+                        blockPosteriors[j] += stage.alpha * 
+                            stage.pWeakHyp->classify( pData, blockIndices[j], _positiveLabelIndex );
+                }
+                else if ( isDense )
+                {
+                    // same test as SingleStumpLearner::phi (missing values go to -1)
+                    for (int j = 0; j < blockSize; ++j)
+                        blockPosteriors[j] += pData->getValues( blockIndices[j] )[ stage.column ] > stage.threshold ? 
+                            stage.vote : -stage.vote;
+                }
+                else
+                {
+                    for (int j = 0; j < blockSize; ++j)
+                        blockPosteriors[j] += pData->getValue( blockIndices[j], stage.column ) > stage.threshold ? 
+                            stage.vote : -stage.vote;
+                }
+
+                _numEvaluationsSum += blockSize;
+
+                // the rejected examples leave the cascade, the survivors are compacted
+                int numKept = 0;
+                for (int j = 0; j < blockSize; ++j)
+                {
+                    const int i = blockIndices[j];
+                    if ( blockPosteriors[j] < stage.rejectionThreshold )
+                    {
+                        _posteriors[i] = blockPosteriors[j];
+                        _numEvaluations[i] = s + 1;
+                        _forecasts[i] = -1;
+                    }
+                    else
+                    {
+                        blockIndices[numKept] = i;
+                        blockPosteriors[numKept] = blockPosteriors[j];
+                        ++numKept;
+                    }
+                }
+                blockSize = numKept;
+            }
+
+            // the survivors of the block stay active
+            for (int j = 0; j < blockSize; ++j)
+            {
+                const int i = blockIndices[j];
+                _posteriors[i] = blockPosteriors[j];
+                _numEvaluations[i] = toStage;
+                _activeIndices[ numSurvivors++ ] = i;
+            }
+        }
+
+        _activeIndices.resize( numSurvivors );
+        _currentStage = toStage;
+    }
+
+    // -------------------------------------------------------------------------
+
+} // end of namespace MultiBoost
@@ -0,0 +1,159 @@
+/*
+ *
+ *    MultiBoost - Multi-purpose boosting package
+ *
+ *    Copyright (C)        AppStat group
+ *                         Laboratoire de l'Accelerateur Lineaire
+ *                         Universite Paris-Sud, 11, CNRS
+ *
+ *    This file is part of the MultiBoost library
+ *
+ *    This library is free software; you can redistribute it 
+ *    and/or modify it under the terms of the GNU General Public
+ *    License as published by the Free Software Foundation
+ *    version 2.1 of the License.
+ *
+ *    This library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *    General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public
+ *    License along with this library; if not, write to the Free Software
+ *    Foundation, Inc., 51 Franklin St, 5th Floor, Boston, MA 02110-1301 USA
+ *
+ *    Contact: : multiboost@googlegroups.com
+ *
+ *    For more information and up-to-date version, please visit
+ *        
+ *                       http://www.multiboost.org/
+ *
+ */
+
+
+
+
+/**
+ * \file CompiledSoftCascade.h A flat representation of a soft cascade, evaluated
+ * with early exit on blocks of examples.
+ */
+
+#ifndef __COMPILED_SOFT_CASCADE_H
+#define __COMPILED_SOFT_CASCADE_H
+
+#include <vector>
+#include "Defaults.h" // for AlphaReal and FeatureReal
+
+using namespace std;
+
+//////////////////////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace MultiBoost {
+
+    // Forward declarations.
+    class BaseLearner;
+    class InputData;
+
+    /**
+     * A soft cascade compiled into a flat array of stages: for every calibrated weak
+     * hypothesis the column, the threshold, the vote \f$\alpha v_+\f$ of the positive
+     * class and the rejection threshold. The examples that are still in the cascade
+     * (the active ones) are evaluated in blocks, stage by stage; after the rejection
+     * check of each stage the survivors of the block are compacted, so the next stages
+     * only see them. The evaluation can be continued stage by stage with evaluate(),
+     * as it is needed by the calibration curves of SoftCascadeClassifier::savePosteriors.
+     * SingleStumpLearner stages are evaluated directly on the values, the other weak
+     * learners through BaseLearner::classify(). The posteriors are accumulated in the
+     * same order as with classify(), so the results are identical.
+     * \date 16/10/2026
+     */
+    class CompiledSoftCascade
+    {
+    public:
+
+        /**
+         * The constructor. The cascade is empty until compile() is called.
+         * \date 16/10/2026
+         */
+        CompiledSoftCascade() : _positiveLabelIndex(0), _currentStage(0), _numEvaluationsSum(0) {}
+
+        /**
+         * Compile the cascade.
+         * \param weakHypotheses The calibrated weak hypotheses, in the order of the stages.
+         * \param rejectionThresholds The rejection threshold of each stage.
+         * \param positiveLabelIndex The index of the positive class.
+         * \date 16/10/2026
+         */
+        void compile( const vector<BaseLearner*>& weakHypotheses, 
+                      const vector<AlphaReal>& rejectionThresholds,
+                      int positiveLabelIndex );
+
+        /**
+         * Put every example of the data at the entrance of the cascade: the posteriors 
+         * are set to zero, and all the examples are active.
+         * \param pData The data to be classified.
+         * \date 16/10/2026
+         */
+        void reset( InputData* pData );
+
+        /**
+         * Continue the evaluation of the active examples up to stage \a toStage.
+         * \param pData The data given to reset().
+         * \param toStage The stage after the last one to evaluate (it is clipped to
+         * the number of stages).
+         * \date 16/10/2026
+         */
+        void evaluate( InputData* pData, int toStage );
+
+        int getNumStages() const { return (int)_stages.size(); } //!< The number of compiled stages.
+        int getCurrentStage() const { return _currentStage; } //!< The number of stages evaluated so far.
+
+        //! The posterior of each example, at the stage where it has been rejected or at the current stage.
+        const vector<AlphaReal>& getPosteriors() const { return _posteriors; }
+
+        //! The number of stages evaluated on each example.
+        const vector<int>& getNumEvaluations() const { return _numEvaluations; }
+
+        //! The forecast of each example: -1 if it has been rejected, +1 otherwise.
+        const vector<char>& getForecasts() const { return _forecasts; }
+
+        /**
+         * The average number of stages (hence features) evaluated per example so far.
+         * \date 16/10/2026
+         */
+        double getAverageNumEvaluations() const
+        { return _posteriors.empty() ? 0. : (double)_numEvaluationsSum / _posteriors.size(); }
+
+    protected:
+
+        /**
+         * One stage of the cascade.
+         * \date 16/10/2026
+         */
+        struct Stage
+        {
+            int          column; //!< The column of the stump, or -1 if classify() is used.
+            FeatureReal  threshold; //!< The threshold of the stump.
+            AlphaReal    vote; //!< alpha * v[positiveLabelIndex] of the stump.
+            AlphaReal    rejectionThreshold; //!< The example is rejected if the posterior is below.
+            AlphaReal    alpha; //!< The coefficient of the weak hypothesis.
+            BaseLearner* pWeakHyp; //!< The weak hypothesis, used when column < 0.
+        };
+
+        static const int BLOCK_SIZE = 256; //!< The number of active examples evaluated together.
+
+        vector<Stage>      _stages; //!< The stages of the cascade.
+        int                _positiveLabelIndex; //!< The index of the positive class.
+
+        int                _currentStage; //!< The number of stages evaluated on the active examples.
+        vector<int>        _activeIndices; //!< The examples not yet rejected.
+        vector<AlphaReal>  _posteriors; //!< The posterior of each example.
+        vector<int>        _numEvaluations; //!< The number of stages evaluated on each example.
+        vector<char>       _forecasts; //!< The forecast of each example.
+        long long          _numEvaluationsSum; //!< The number of stages evaluated on all the examples.
+    };
+
+} // end of namespace MultiBoost
+
+#endif // __COMPILED_SOFT_CASCADE_H
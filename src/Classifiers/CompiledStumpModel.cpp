@@ -0,0 +1,248 @@
+/*
+ *
+ *    MultiBoost - Multi-purpose boosting package
+ *
+ *    Copyright (C)        AppStat group
+ *                         Laboratoire de l'Accelerateur Lineaire
+ *                         Universite Paris-Sud, 11, CNRS
+ *
+ *    This file is part of the MultiBoost library
+ *
+ *    This library is free software; you can redistribute it 
+ *    and/or modify it under the terms of the GNU General Public
+ *    License as published by the Free Software Foundation
+ *    version 2.1 of the License.
+ *
+ *    This library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *    General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public
+ *    License along with this library; if not, write to the Free Software
+ *    Foundation, Inc., 51 Franklin St, 5th Floor, Boston, MA 02110-1301 USA
+ *
+ *    Contact: : multiboost@googlegroups.com
+ *
+ *    For more information and up-to-date version, please visit
+ *        
+ *                       http://www.multiboost.org/
+ *
+ */
+
+
+
+#include "Classifiers/CompiledStumpModel.h"
+#include "Classifiers/ExampleResults.h" // for VotesMatrix
+#include "IO/InputData.h"
+#include "WeakLearners/SingleStumpLearner.h"
+#include "WeakLearners/MultiStumpLearner.h"
+#include "WeakLearners/ConstantLearner.h"
+
+#include <map>
+#include <algorithm> // for min
+#include <typeinfo> // for typeid
+
+namespace MultiBoost {
+
+    // -------------------------------------------------------------------------
+    // -------------------------------------------------------------------------
+
+    bool CompiledStumpModel::compile( const vector<BaseLearner*>& weakHypotheses, int fromIteration,
+                                      int toIteration, int numClasses )
+    {
+        _numClasses = numClasses;
+        _numHypotheses = 0;
+
+        _types.clear();
+        _slots.clear();
+        _thresholds.clear();
+        _votes.clear();
+        _columns.clear();
+
+        toIteration = min( toIteration, (int)weakHypotheses.size() );
+        if ( fromIteration >= toIteration )
+            return true;
+
+        const int numHypotheses = toIteration - fromIteration;
+        _types.reserve( numHypotheses );
+        _slots.reserve( numHypotheses * numClasses );
+        _thresholds.reserve( numHypotheses * numClasses );
+        _votes.reserve( numHypotheses * numClasses );
+
+        // column -> slot in _columns
+        map<int, int> columnSlots;
+
+        for (int t = fromIteration; t < toIteration; ++t)
+        {
+            BaseLearner* pWeakHyp = weakHypotheses[t];
+            const AlphaReal alpha = pWeakHyp->getAlpha();
+
+            // only the exact types: the derived classes may redefine phi()
+            AbstainableLearner* pAbstainable = NULL;
+            vector<int> columns( numClasses, -1 );
+            vector<FeatureReal> thresholds( numClasses, 0 );
+            char type;
+
+            if ( typeid(*pWeakHyp) == typeid(SingleStumpLearner) )
+            {
+                SingleStumpLearner* pStump = dynamic_cast<SingleStumpLearner*>(pWeakHyp);
+                pAbstainable = pStump;
+                fill( columns.begin(), columns.end(), pStump->getSelectedColumn() );
+                fill( thresholds.begin(), thresholds.end(), pStump->getThreshold() );
+                type = HT_SINGLE_STUMP;
+            }
+            else if ( typeid(*pWeakHyp) == typeid(MultiStumpLearner) )
+            {
+                MultiStumpLearner* pStump = dynamic_cast<MultiStumpLearner*>(pWeakHyp);
+                if ( (int)pStump->getSelectedColumns().size() != numClasses ||
+                     (int)pStump->getThresholds().size() != numClasses )
+                    return false;
+                pAbstainable = pStump;
+                columns = pStump->getSelectedColumns();
+                thresholds = pStump->getThresholds();
+                type = HT_MULTI_STUMP;
+            }
+            else if ( typeid(*pWeakHyp) == typeid(ConstantLearner) )
+            {
+                pAbstainable = dynamic_cast<ConstantLearner*>(pWeakHyp);
+                type = HT_CONSTANT;
+            }
+            else
+                return false;
+
+            if ( (int)pAbstainable->_v.size() != numClasses )
+                return false;
+
+            _types.push_back( type );
+            for (int l = 0; l < numClasses; ++l)
+            {
+                int slot = -1;
+                if ( columns[l] >= 0 )
+                {
+                    map<int, int>::const_iterator sIt = columnSlots.find( columns[l] );
+                    if ( sIt == columnSlots.end() )
+                    {
+                        slot = (int)_columns.size();
+                        columnSlots[ columns[l] ] = slot;
+                        _columns.push_back( columns[l] );
+                    }
+                    else
+                        slot = sIt->second;
+                }
+                else if ( type != HT_CONSTANT )
+                    return false;
+
+                _slots.push_back( slot );
+                _thresholds.push_back( thresholds[l] );
+                // phi is +1 or -1, so alpha * (v * phi) == phi * (alpha * v) exactly
+                _votes.push_back( alpha * pAbstainable->_v[l] );
+            }
+        }
+
+        _numHypotheses = numHypotheses;
+        return true;
+    }
+
+    // -------------------------------------------------------------------------
+
+    void CompiledStumpModel::addVotes( InputData* pData, VotesMatrix& votes ) const
+    {
+        addVotes( pData, votes, 0, pData->getNumExamples() );
+    }
+
+    // -------------------------------------------------------------------------
+
+    void CompiledStumpModel::addVotes( InputData* pData, VotesMatrix& votes, 
+                                       int beginIdx, int endIdx ) const
+    {
+        if ( _numHypotheses == 0 )
+            return;
+
+        const int numClasses = _numClasses;
+        const int numColumns = (int)_columns.size();
+        const bool isDense = ( pData->getDataRep() == DR_DENSE );
+
+        // the values of the block, column by column
+        vector<FeatureReal> blockValues( numColumns * BLOCK_SIZE );
+        vector<AlphaReal> signs( BLOCK_SIZE );
+
+        for (int blockBegin = beginIdx; blockBegin < endIdx; blockBegin += BLOCK_SIZE)
+        {
+            const int blockSize = min( (int)BLOCK_SIZE, endIdx - blockBegin );
+
+            // the rows of the block are contiguous in the matrix
+            AlphaReal* blockVotes = votes.getVotes( blockBegin );
+
+            // gather the values
+            for (int j = 0; j < blockSize; ++j)
+            {
+                const int i = blockBegin + j;
+
+                if ( isDense && numColumns > 0 )
+                {
+                    const vector<FeatureReal>& values = pData->getValues(i);
+                    for (int s = 0; s < numColumns; ++s)
+                        blockValues[ s * BLOCK_SIZE + j ] = values[ _columns[s] ];
+                }
+                else
+                {
+                    for (int s = 0; s < numColumns; ++s)
+                        blockValues[ s * BLOCK_SIZE + j ] = pData->getValue( i, _columns[s] );
+                }
+            }
+
+            // for every hypothesis, in order, update the votes of the whole block
+            for (int t = 0; t < _numHypotheses; ++t)
+            {
+                const AlphaReal* pVotes = &_votes[ t * numClasses ];
+
+                switch ( _types[t] )
+                {
+                case HT_CONSTANT:
+                    for (int j = 0; j < blockSize; ++j)
+                    {
+                        AlphaReal* pRow = &blockVotes[ j * numClasses ];
+                        for (int l = 0; l < numClasses; ++l)
+                            pRow[l] += pVotes[l];
+                    }
+                    break;
+
+                case HT_SINGLE_STUMP:
+                    {
+                        const FeatureReal* pValues = &blockValues[ _slots[ t * numClasses ] * BLOCK_SIZE ];
+                        const FeatureReal threshold = _thresholds[ t * numClasses ];
+
+                        // same test as SingleStumpLearner::phi (missing values go to -1)
+                        for (int j = 0; j < blockSize; ++j)
+                            signs[j] = pValues[j] > threshold ? +1 : -1;
+
+                        for (int j = 0; j < blockSize; ++j)
+                        {
+                            AlphaReal* pRow = &blockVotes[ j * numClasses ];
+                            const AlphaReal sign = signs[j];
+                            for (int l = 0; l < numClasses; ++l)
+                                pRow[l] += sign * pVotes[l];
+                        }
+                    }
+                    break;
+
+                case HT_MULTI_STUMP:
+                    for (int l = 0; l < numClasses; ++l)
+                    {
+                        const FeatureReal* pValues = &blockValues[ _slots[ t * numClasses + l ] * BLOCK_SIZE ];
+                        const FeatureReal threshold = _thresholds[ t * numClasses + l ];
+                        const AlphaReal vote = pVotes[l];
+
+                        for (int j = 0; j < blockSize; ++j)
+                            blockVotes[ j * numClasses + l ] += pValues[j] > threshold ? vote : -vote;
+                    }
+                    break;
+                }
+            }
+        }
+    }
+
+    // -------------------------------------------------------------------------
+
+} // end of namespace MultiBoost
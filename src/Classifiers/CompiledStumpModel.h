@@ -0,0 +1,141 @@
+/*
+ *
+ *    MultiBoost - Multi-purpose boosting package
+ *
+ *    Copyright (C)        AppStat group
+ *                         Laboratoire de l'Accelerateur Lineaire
+ *                         Universite Paris-Sud, 11, CNRS
+ *
+ *    This file is part of the MultiBoost library
+ *
+ *    This library is free software; you can redistribute it 
+ *    and/or modify it under the terms of the GNU General Public
+ *    License as published by the Free Software Foundation
+ *    version 2.1 of the License.
+ *
+ *    This library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *    General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public
+ *    License along with this library; if not, write to the Free Software
+ *    Foundation, Inc., 51 Franklin St, 5th Floor, Boston, MA 02110-1301 USA
+ *
+ *    Contact: : multiboost@googlegroups.com
+ *
+ *    For more information and up-to-date version, please visit
+ *        
+ *                       http://www.multiboost.org/
+ *
+ */
+
+
+
+/**
+ * \file CompiledStumpModel.h A flat, devirtualized representation of a strong
+ * hypothesis made of stumps, used to score large datasets.
+ */
+
+#ifndef __COMPILED_STUMP_MODEL_H
+#define __COMPILED_STUMP_MODEL_H
+
+#include <vector>
+#include "Defaults.h" // for AlphaReal and FeatureReal
+
+using namespace std;
+
+//////////////////////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace MultiBoost {
+
+    // Forward declarations.
+    class BaseLearner;
+    class InputData;
+    class VotesMatrix;
+
+    /**
+     * A strong hypothesis of SingleStumpLearner, MultiStumpLearner and ConstantLearner
+     * weak hypotheses, compiled into contiguous arrays: for every hypothesis and class the
+     * column, the threshold and the vote \f$\alpha v_\ell\f$. The examples are then scored
+     * in blocks, feature-major: the values of the columns used by the model are gathered
+     * once per block, and each hypothesis updates the votes of the whole block, instead of
+     * calling BaseLearner::classify() for every hypothesis, example and class.
+     * The votes are accumulated in the same order as with classify(), so the results
+     * are identical.
+     * \date 16/10/2026
+     */
+    class CompiledStumpModel
+    {
+    public:
+
+        /**
+         * The constructor. The model is empty until compile() is called.
+         * \date 16/10/2026
+         */
+        CompiledStumpModel() : _numClasses(0), _numHypotheses(0) {}
+
+        /**
+         * Compile the weak hypotheses [fromIteration, toIteration).
+         * \param weakHypotheses The list of weak hypotheses.
+         * \param fromIteration The index of the first hypothesis to compile.
+         * \param toIteration The index after the last hypothesis to compile (it
+         * is clipped to the size of \a weakHypotheses).
+         * \param numClasses The number of classes.
+         * \return false if one of the hypotheses is not a SingleStumpLearner, 
+         * MultiStumpLearner or ConstantLearner (derived classes excluded), in this
+         * case the caller must use classify().
+         * \date 16/10/2026
+         */
+        bool compile( const vector<BaseLearner*>& weakHypotheses, int fromIteration,
+                      int toIteration, int numClasses );
+
+        /**
+         * Add the votes of the compiled hypotheses to the votes of the examples.
+         * \param pData The data to be classified.
+         * \param votes The votes of the examples of \a pData.
+         * \date 16/10/2026
+         */
+        void addVotes( InputData* pData, VotesMatrix& votes ) const;
+
+        /**
+         * Add the votes of the compiled hypotheses to the votes of the examples
+         * [beginIdx, endIdx). It does not change the object, so different ranges can
+         * be scored at the same time.
+         * \param pData The data to be classified.
+         * \param votes The votes of the examples of \a pData.
+         * \param beginIdx The first example.
+         * \param endIdx The example after the last one.
+         * \date 16/10/2026
+         */
+        void addVotes( InputData* pData, VotesMatrix& votes, int beginIdx, int endIdx ) const;
+
+        int getNumHypotheses() const { return _numHypotheses; } //!< The number of compiled hypotheses.
+
+    protected:
+
+        //! The kind of compiled hypothesis.
+        enum eHypothesisType
+        {
+            HT_CONSTANT, //!< h(x,l) = v[l]
+            HT_SINGLE_STUMP, //!< h(x,l) = v[l] * phi(x[j])
+            HT_MULTI_STUMP //!< h(x,l) = v[l] * phi_l(x[j_l])
+        };
+
+        static const int BLOCK_SIZE = 256; //!< The number of examples scored together.
+
+        int _numClasses;
+        int _numHypotheses;
+
+        vector<char>        _types; //!< The eHypothesisType of each hypothesis.
+        vector<int>         _slots; //!< The index in _columns of the column of each (hypothesis, class).
+        vector<FeatureReal> _thresholds; //!< The threshold of each (hypothesis, class).
+        vector<AlphaReal>   _votes; //!< alpha * v[l] of each (hypothesis, class).
+
+        vector<int>         _columns; //!< The distinct columns used by the model.
+    };
+
+} // end of namespace MultiBoost
+
+#endif // __COMPILED_STUMP_MODEL_H
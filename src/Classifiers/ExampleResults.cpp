@@ -71,20 +71,48 @@ namespace MultiBoost {
 
 // -------------------------------------------------------------------------
 
-    void ExampleResults::getRankedList( vector< pair<int, AlphaReal> >& rankedList ) const
+    void ExampleResults::getRankedList( const AlphaReal* pVotes, int numClasses, 
+                                        vector< pair<int, AlphaReal> >& rankedList )
     {
-        rankedList.resize( _votesVector.size() );
+        rankedList.resize( numClasses );
 
-        vector<AlphaReal>::const_iterator vIt;
-        const vector<AlphaReal>::const_iterator votesVectorEnd = _votesVector.end();
-        int i;
-        for (vIt = _votesVector.begin(), i = 0; vIt != votesVectorEnd; ++vIt, ++i )
-            rankedList[i] = make_pair(i, *vIt);
+        for (int i = 0; i < numClasses; ++i )
+            rankedList[i] = make_pair(i, pVotes[i]);
 
         sort( rankedList.begin(), rankedList.end(), 
               nor_utils::comparePair<2, int, AlphaReal, greater<AlphaReal> >() );
     }
 
+// -------------------------------------------------------------------------
+// -------------------------------------------------------------------------
+
+    pair<int, AlphaReal> VotesMatrix::getWinner(const int idx, int rank) const
+    {
+        assert(rank >= 0);
+
+        vector< pair<int, AlphaReal> > rankedList;
+        ExampleResults::getRankedList(getVotes(idx), _numClasses, rankedList);
+        return rankedList[rank];
+    }
+
+// -------------------------------------------------------------------------
+
+    bool VotesMatrix::isWinner(const int idx, const Example& example, int atLeastRank) const
+    {
+        assert(atLeastRank >= 0);
+
+        vector< pair<int, AlphaReal> > rankedList;
+        ExampleResults::getRankedList(getVotes(idx), _numClasses, rankedList);
+
+        for (int i = 0; i <= atLeastRank; ++i)
+        {
+            if ( example.hasPositiveLabel(rankedList[i].first) )
+                return true;
+        }
+
+        return false;
+    }
+
 // -------------------------------------------------------------------------
 
 } // end of namespace MultiBoost
@@ -92,6 +92,19 @@ namespace MultiBoost {
          */
         bool isWinner(const Example& example, int atLeastRank = 0) const;
 
+        /**
+         * Create a sorted ranking list of the given votes. It builds a vector
+         * of pairs that contains the index of the class and the value of the votes
+         * (that is a vector of <\f$\ell\f$, \f$g_\ell(x)\f$>), which is sorted
+         * by the second element, resulting in a ranking of the votes per class.
+         * \param pVotes The votes of the example.
+         * \param numClasses The number of classes.
+         * \param rankedList the vector that will be filled with the rankings.
+         * \date 16/10/2026
+         */
+        static void getRankedList( const AlphaReal* pVotes, int numClasses, 
+                                   vector< pair<int, AlphaReal> >& rankedList );
+
     private:
 
         /**
@@ -102,7 +115,8 @@ namespace MultiBoost {
          * \param rankedList the vector that will be filled with the rankings.
          * \date 16/11/2005
          */
-        void getRankedList( vector< pair<int, AlphaReal> >& rankedList ) const;
+        void getRankedList( vector< pair<int, AlphaReal> >& rankedList ) const
+        { getRankedList( &_votesVector[0], (int)_votesVector.size(), rankedList ); }
 
         const int _idx; //!< The index of the example 
 
@@ -121,6 +135,66 @@ namespace MultiBoost {
 
     }; // ExampleResults
 
+    //////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Holds the results of all the examples of a dataset in a single contiguous
+ * matrix (numExamples x numClasses, row-major), so that the rows can be filled
+ * by several threads at the same time. It offers the same evaluation methods as
+ * ExampleResults, per example.
+ * \date 16/10/2026
+ */
+    class VotesMatrix
+    {
+    public:
+
+        /**
+         * The constructor. Initialize the matrix to zero.
+         * \param numExamples The number of examples.
+         * \param numClasses The number of classes.
+         * \date 16/10/2026
+         */
+    VotesMatrix(const int numExamples = 0, const int numClasses = 0)
+        : _numExamples(numExamples), _numClasses(numClasses), 
+            _votes(numExamples * numClasses, 0) {}
+
+        //! Set the size of the matrix, and reset all the votes to zero.
+        void reset(const int numExamples, const int numClasses)
+        {
+            _numExamples = numExamples;
+            _numClasses = numClasses;
+            _votes.assign( numExamples * numClasses, 0 );
+        }
+
+        int getNumExamples() const { return _numExamples; }
+        int getNumClasses() const { return _numClasses; }
+
+        //! The votes \f${\bf g}(x)\f$ of the example \a idx.
+        AlphaReal*       getVotes(const int idx)       { return &_votes[ idx * _numClasses ]; }
+        const AlphaReal* getVotes(const int idx) const { return &_votes[ idx * _numClasses ]; }
+
+        /**
+         * Get the winner of the example \a idx. 
+         * \see ExampleResults::getWinner
+         * \date 16/10/2026
+         */
+        pair<int, AlphaReal> getWinner(const int idx, int rank = 0) const;
+
+        /**
+         * Checks if the given class is the winner class of the example \a idx.
+         * \see ExampleResults::isWinner
+         * \date 16/10/2026
+         */
+        bool isWinner(const int idx, const Example& example, int atLeastRank = 0) const;
+
+    private:
+
+        int _numExamples;
+        int _numClasses;
+        vector<AlphaReal> _votes; //!< The votes of the examples, row by row.
+
+    }; // VotesMatrix
+
 } // end of namespace MultiBoost
 
 #endif // __EXAMPLE_RESULTS_H
@@ -40,6 +40,7 @@
 #include "Utils/Utils.h"
 #include "IO/Serialization.h"
 #include "IO/OutputInfo.h"
+#include "Classifiers/CompiledSoftCascade.h"
 
 namespace MultiBoost {
     
@@ -156,19 +157,23 @@ namespace MultiBoost {
                 
         us.loadHypothesesWithThresholds(shypFileName, calibWeakHypotheses, rejectionThresholds, pData);
         
-        
-        for (int w = 0; w < calibWeakHypotheses.size(); ++w) {
+        // the step-by-step information is computed by SoftCascadeOutput
+        for (int w = 0; pOutInfo && w < calibWeakHypotheses.size(); ++w) {
             dynamic_cast<SoftCascadeOutput*>( pOutInfo->getOutputInfoObject("sca") )->appendRejectionThreshold(rejectionThresholds[w]);            
             printOutputInfo(pOutInfo, w, pData, calibWeakHypotheses[w], rejectionThresholds[w]);
         }
         
+        // the forecasts of the whole cascade, with early exit
+        CompiledSoftCascade cascade;
+        cascade.compile(calibWeakHypotheses, rejectionThresholds, positiveLabelIndex);
+        cascade.reset(pData);
+        cascade.evaluate(pData, cascade.getNumStages());
         
-        vector<char> & forecast = dynamic_cast<SoftCascadeOutput*>( pOutInfo->getOutputInfoObject("sca") )->getForcastVector() ;
-
-//        for (int j = 0; j < forecast.size(); j++) {
-//            cout << (int) forecast[j] << " ";
-//        }
-//        cout << endl;
+        const vector<char>& forecast = cascade.getForecasts();
+        
+        if (_verbose > 0)
+            cout << "Average number of evaluated features per example: " 
+                 << cascade.getAverageNumEvaluations() << endl;
         
         vector<vector<int> > confMatrix(2);
         confMatrix[0].resize(2);
@@ -271,14 +276,23 @@ namespace MultiBoost {
                     
         
         
-        vector<BaseLearner*> weakHypotheses;
+        // the labels, looked up once
+        vector<char> labelYs(numExamples);
+        for (int i = 0; i < numExamples; ++i)
+            labelYs[i] = pData->getExample(i).getLabelY(positiveLabelIndex);
+        
+        // the cascade is evaluated one more stage at each calibration step, 
+        // only on the examples not yet rejected
+        CompiledSoftCascade cascade;
+        cascade.compile(calibWeakHypotheses, rejectionThresholds, positiveLabelIndex);
+        cascade.reset(pData);
+        
+        const vector<AlphaReal>& posteriors = cascade.getPosteriors();
+        const vector<int>& numEvaluations = cascade.getNumEvaluations();
+        const vector<char>& forecasts = cascade.getForecasts();
+        
         for (int w = 0; w < calibWeakHypotheses.size(); ++w) {
-            weakHypotheses.push_back(calibWeakHypotheses[w]);
-            
-            AlphaReal alphaSum = 0. ;
-            for (int wh = 0; wh < weakHypotheses.size(); ++wh) {
-                alphaSum += weakHypotheses[wh]->getAlpha();
-            }
+            cascade.evaluate(pData, min(w + 1, numIterations));
             
             int TP = 0, FP = 0;
             int err = 0;
@@ -286,36 +300,14 @@ namespace MultiBoost {
             vector< pair< int, AlphaReal> > scores;
             scores.resize(numExamples);
             
-            vector<vector< AlphaReal> > outputs;
-            outputs.resize(numExamples);
-            
             for (int i = 0; i < numExamples; ++i) {
-                int forecast = 1;
-                AlphaReal posterior = 0. ;
-                int nbEvaluations = 0 ;
-
-                const Example& example = pData->getExample(i);
-                int labelY = example.getLabelY(positiveLabelIndex);
-
-                for (int s = 0; s < numIterations && s < weakHypotheses.size(); ++s) {
-                    
-                    nbEvaluations += 1;
-                    
-                    posterior += weakHypotheses[s]->getAlpha() * weakHypotheses[s]->classify(pData, i, positiveLabelIndex);
-                    if (  posterior < rejectionThresholds[s] ) {
-                        forecast = -1;
-                        break;
-                    }
-                }
-                
-                outputs[i].resize(2);
-                outputs[i][0] = posterior; // ( ( posterior/alphaSum ) + 1 ) / 2 ;;
-                outputs[i][1] = nbEvaluations;
+                const int forecast = forecasts[i];
+                const int labelY = labelYs[i];
                 
-                scores[i].second = outputs[i][0];
+                scores[i].second = posteriors[i];
                 if (labelY < 0) {
                     scores[i].first = 0;
-                    numWhyp += nbEvaluations;
+                    numWhyp += numEvaluations[i];
                 }
                 else 
                     scores[i].first = 1;
@@ -335,8 +327,8 @@ namespace MultiBoost {
                 }
             }
             
-            for (int i = 0; i < outputs.size(); ++i) {
-                outputPosteriors << outputs[i][0] << " ";
+            for (int i = 0; i < numExamples; ++i) {
+                outputPosteriors << posteriors[i] << " ";
             }
             outputPosteriors << endl;
             
@@ -364,6 +356,10 @@ namespace MultiBoost {
             }
         }
         
+        if (_verbose > 0)
+            cout << "Average number of evaluated features per example: " 
+                 << cascade.getAverageNumEvaluations() << endl;
+        
         if (pData) {
             delete pData;
         }
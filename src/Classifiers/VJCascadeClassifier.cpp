@@ -115,16 +115,26 @@ namespace MultiBoost {
             outputHeader();
         }
                 
+        // the examples not rejected yet: a stage is evaluated only on them
+        vector<int> activeIndices(numOfExamples);
+        for( int i = 0; i < numOfExamples; ++i )
+            activeIndices[i] = i;
+
+        // the number of evaluated examples and weak learner calls per stage
+        vector<int> numEvaluated(weakHypotheses.size(), 0);
+        vector<long long> numWeakCalls(weakHypotheses.size(), 0);
+                
         for(int stagei=0; stagei < weakHypotheses.size(); ++stagei )
         {
             // for posteriors
             vector<AlphaReal> posteriors(0);                
                         
             // calculate the posteriors after stage
-            VJCascadeLearner::calculatePosteriors( pData, weakHypotheses[stagei], posteriors, _positiveLabelIndex );                        
+            numEvaluated[stagei] = static_cast<int>( activeIndices.size() );
+            numWeakCalls[stagei] = VJCascadeLearner::calculatePosteriors( pData, weakHypotheses[stagei], activeIndices, posteriors, _positiveLabelIndex );
                         
             // update the data (posteriors, active element index etc.)
-            updateCascadeData(pData, weakHypotheses, stagei, posteriors, thresholds, _positiveLabelIndex, cascadeData);
+            updateCascadeData(weakHypotheses, stagei, posteriors, thresholds, _positiveLabelIndex, cascadeData, activeIndices);
                         
             if (!_outputInfoFile.empty())
             {
@@ -133,13 +143,29 @@ namespace MultiBoost {
                 outputCascadeResult( pData, cascadeData );
             }
                         
-            int numberOfActiveInstance = 0;
-            for( int i = 0; i < numOfExamples; ++i )
-                if (cascadeData[i].active) numberOfActiveInstance++;
+            const int numberOfActiveInstance = static_cast<int>( activeIndices.size() );
                         
             if (_verbose > 0 )
                 cout << "Number of active instances: " << numberOfActiveInstance << "(" << numOfExamples << ")" << endl;                                                                        
         }
+
+        if (_verbose > 0)
+        {
+            long long sumWeakCalls = 0;
+            long long sumAllWeakCalls = 0;
+            if (_verbose > 1)
+                cout << endl << "Evaluated examples and weak learner calls per stage:" << endl;
+            for(int stagei=0; stagei < weakHypotheses.size(); ++stagei )
+            {
+                if (_verbose > 1)
+                    cout << "Stage " << stagei + 1 << ": " << numEvaluated[stagei] << " examples, " 
+                         << numWeakCalls[stagei] << " weak learner calls" << endl;
+                sumWeakCalls += numWeakCalls[stagei];
+                sumAllWeakCalls += static_cast<long long>( numOfExamples ) * weakHypotheses[stagei].size();
+            }
+            cout << "Weak learner calls: " << sumWeakCalls << " (" << sumAllWeakCalls 
+                 << " without early exit)" << endl;
+        }
                                 
         vector<vector<int> > confMatrix(2);
         confMatrix[0].resize(2);
@@ -190,11 +216,10 @@ namespace MultiBoost {
     }
         
     // -------------------------------------------------------------------------
-    void VJCascadeClassifier::updateCascadeData(InputData* pData, vector<vector<BaseLearner*> >& weakHypotheses, 
+    void VJCascadeClassifier::updateCascadeData(vector<vector<BaseLearner*> >& weakHypotheses, 
                                                 int stagei, const vector<AlphaReal>& posteriors, vector<AlphaReal>& thresholds, int positiveLabelIndex,
-                                                vector<CascadeOutputInformation>& cascadeData)
+                                                vector<CascadeOutputInformation>& cascadeData, vector<int>& activeIndices)
     {
-        const int numOfExamples = pData->getNumExamples();
         int sumOfWeakClassifier = 0;
         for(int i=0; i<=0; ++i) sumOfWeakClassifier += ((int)weakHypotheses[stagei].size());
                 
@@ -204,42 +229,34 @@ namespace MultiBoost {
             sumalphas += weakHypotheses[stagei][i]->getAlpha();
         }
                 
-        for(int i=0; i<numOfExamples; ++i )
+        // only the active examples have been evaluated; the rejected ones are
+        // removed from the list
+        const int numActive = static_cast<int>( activeIndices.size() );
+        int numStillActive = 0;
+        for(int k=0; k<numActive; ++k )
         {
-            bool isPos;
-            
-            const Example& example = pData->getExample(i);
-            int labelY = example.getLabelY(_positiveLabelIndex);
-            
-            if (labelY>0)                           
-                isPos = true;
-            else 
-                isPos =false;                   
-                        
+            const int i = activeIndices[k];
                         
             //cout << posteriors[i] << " ";
-            if (cascadeData[i].active) // active: it is not classified yet
-            {
-                cascadeData[i].score=((posteriors[i]/sumalphas)+1)/2;
+            cascadeData[i].score=((posteriors[i]/sumalphas)+1)/2;
                 
-                cascadeData[i].score += stagei - 1 ;
+            cascadeData[i].score += stagei - 1 ;
                 
-                if (posteriors[i]<thresholds[stagei])
-                {
-                    cascadeData[i].active = false; // classified
-                    cascadeData[i].forecast=0;
-                } else {
-                    cascadeData[i].active = true; // continue
-                    cascadeData[i].forecast=1;                                      
-                }
+            if (posteriors[i]<thresholds[stagei])
+            {
+                cascadeData[i].active = false; // classified
+                cascadeData[i].forecast=0;
+            } else {
+                cascadeData[i].active = true; // continue
+                cascadeData[i].forecast=1;                                      
+                activeIndices[numStillActive++] = i;
+            }
                 
                                 
-                cascadeData[i].classifiedInStage=stagei;
-                cascadeData[i].numberOfUsedClassifier=sumOfWeakClassifier;                                                              
-            }                                               
+            cascadeData[i].classifiedInStage=stagei;
+            cascadeData[i].numberOfUsedClassifier=sumOfWeakClassifier;                                                              
         }                               
-                
-                
+        activeIndices.resize(numStillActive);
     }
                                                            
     // -------------------------------------------------------------------------
@@ -320,22 +337,25 @@ namespace MultiBoost {
             it->active=true;
         }                                                                               
                 
+        // the examples not rejected yet: a stage is evaluated only on them
+        vector<int> activeIndices(numOfExamples);
+        for( int i = 0; i < numOfExamples; ++i )
+            activeIndices[i] = i;
+                
         for(int stagei=0; stagei < weakHypotheses.size(); ++stagei )
         {
             // for posteriors
             vector<AlphaReal> posteriors(0);                
                         
             // calculate the posteriors after stage
-            VJCascadeLearner::calculatePosteriors( pData, weakHypotheses[stagei], posteriors, _positiveLabelIndex );                        
+            VJCascadeLearner::calculatePosteriors( pData, weakHypotheses[stagei], activeIndices, posteriors, _positiveLabelIndex );
                         
             // update the data (posteriors, active element index etc.)
             //VJCascadeLearner::forecastOverAllCascade( pData, posteriors, activeInstances, thresholds[stagei] );
-            updateCascadeData(pData, weakHypotheses, stagei, posteriors, thresholds, _positiveLabelIndex, cascadeData);
+            updateCascadeData(weakHypotheses, stagei, posteriors, thresholds, _positiveLabelIndex, cascadeData, activeIndices);
                         
                         
-            int numberOfActiveInstance = 0;
-            for( int i = 0; i < numOfExamples; ++i )
-                if (cascadeData[i].active) numberOfActiveInstance++;
+            const int numberOfActiveInstance = static_cast<int>( activeIndices.size() );
                         
             if (_verbose > 0 )
                 cout << "Number of active instances: " << numberOfActiveInstance << "(" << numOfExamples << ")" << endl;                                                                        
@@ -164,9 +164,15 @@ namespace MultiBoost {
          */
         InputData* loadInputData(const string& dataFileName, const string& shypFileName);
                                 
-        virtual void updateCascadeData(InputData* pData, vector<vector<BaseLearner*> >& weakHypotheses, 
+        /**
+         * Updates the cascade data of the active examples after a stage, and removes the
+         * examples rejected by the stage from the list of active examples.
+         * \param activeIndices The indices of the examples still active, compacted in place.
+         * \date 16/10/2026
+         */
+        virtual void updateCascadeData(vector<vector<BaseLearner*> >& weakHypotheses, 
                                        int stagei, const vector<AlphaReal>& posteriors, vector<AlphaReal>& thresholds, int positiveLabelIndex,
-                                       vector<CascadeOutputInformation>& cascadeData);
+                                       vector<CascadeOutputInformation>& cascadeData, vector<int>& activeIndices);
         /**
          * Defines the level of verbosity:
          * - 0 = no messages
@@ -37,8 +37,117 @@
 #include "IO/ArffParser.h"
 #include "Utils/Utils.h"
 
+#include <cstring> // for memchr, memcmp
+#include <limits>
+
 namespace MultiBoost {
 
+    namespace {
+
+        // The read-only tables shared by the threads of ArffParser::readMappedData()
+        struct MappedDataTables
+        {
+            int numAttributes;
+            int numClasses;
+            const vector<RawData::eAttributeType>* pAttributeTypes;
+            vector< map<string, int> > enumIndices; //!< name -> index of the enum attributes
+            map<string, int> classIndices; //!< name -> index of the classes
+        };
+
+        inline bool isSpace(char c) { return isspace( static_cast<unsigned char>(c) ) != 0; }
+
+        // the separators of the dense locale, without the newline
+        inline bool isDenseSeparator(char c) { return c == ' ' || c == ','; }
+
+        // Read a dense row [p, eol) as ArffParser::readDenseValues() and 
+        // ArffParser::readSimpleLabels() do. It returns false if the row is not supported.
+        bool readMappedRow( const char* p, const char* eol, const MappedDataTables& tables,
+                            Example& example, string& tmpStr )
+        {
+            const vector<RawData::eAttributeType>& attributeTypes = *tables.pAttributeTypes;
+
+            vector<FeatureReal>& values = example.getValues();
+            values.reserve(tables.numAttributes);
+
+            for ( int j = 0; j < tables.numAttributes; ++j )
+            {
+                while ( p != eol && isDenseSeparator(*p) )
+                    ++p;
+                if ( p == eol ) // the values continue on the next line
+                    return false;
+
+                const char* tokenEnd = p;
+                while ( tokenEnd != eol && !isDenseSeparator(*tokenEnd) )
+                    ++tokenEnd;
+                const size_t tokenLength = tokenEnd - p;
+
+                if ( attributeTypes[j] == RawData::ATTRIBUTE_NUMERIC ) 
+                {
+                    if ( ( tokenLength == 3 && ( memcmp(p, "Nan", 3) == 0 || memcmp(p, "NaN", 3) == 0 ) ) ||
+                         ( tokenLength == 1 && *p == '?' ) )
+                        values.push_back( numeric_limits<float>::infinity() );
+                    else
+                        values.push_back( nor_utils::parse_double(p, tokenEnd) );
+                }
+                else
+                {
+                    tmpStr.assign(p, tokenEnd);
+                    map<string, int>::const_iterator it = tables.enumIndices[j].find(tmpStr);
+                    if ( it == tables.enumIndices[j].end() )
+                        return false;
+                    values.push_back( it->second );
+                }
+
+                p = tokenEnd;
+            }
+
+            // skip spaces and the last comma
+            while ( p != eol && ( isSpace(*p) || *p == ',' ) )
+                ++p;
+            if ( p == eol || *p == '{' ) // no labels, or labels with weights
+                return false;
+
+            vector<Label>& labels = example.getLabels();
+            labels.resize(tables.numClasses);
+            for ( int i = 0; i < tables.numClasses; ++i )
+            {
+                labels[i].idx = i;
+                labels[i].y = -1;
+            }
+
+            // now get the declared labels
+            while ( p != eol )
+            {
+                const char* tokenEnd = p;
+                while ( tokenEnd != eol && !isDenseSeparator(*tokenEnd) )
+                    ++tokenEnd;
+
+                // trim
+                const char* labelBeg = p;
+                const char* labelEnd = tokenEnd;
+                while ( labelBeg != labelEnd && isSpace(*labelBeg) )
+                    ++labelBeg;
+                while ( labelEnd != labelBeg && isSpace(labelEnd[-1]) )
+                    --labelEnd;
+                if ( labelBeg == labelEnd )
+                    return false;
+
+                tmpStr.assign(labelBeg, labelEnd);
+                map<string, int>::const_iterator it = tables.classIndices.find(tmpStr);
+                if ( it == tables.classIndices.end() )
+                    return false;
+                labels[ it->second ].y = +1;
+
+                p = tokenEnd;
+                while ( p != eol && isDenseSeparator(*p) )
+                    ++p;
+            }
+
+            return true;
+        }
+
+    } // end of anonymous namespace
+
     // ------------------------------------------------------------------------
 
     ArffParser::ArffParser(const string& fileName,const string& headerFileName)
@@ -65,8 +174,13 @@ namespace MultiBoost {
         _dataRep = DR_UNKNOWN;
         _labelRep = LR_UNKNOWN;
 
+        // the data section starts after the header, if it is in the same file
+        streamoff dataOffset = 0;
         if (_headerFileName.empty())
+        {
             readHeader(inFile, classMap, enumMaps, attributeNameMap, attributeTypes);
+            dataOffset = inFile.tellg();
+        }
         else {
             // open separate header file
             ifstream inHeaderFile(_headerFileName.c_str());
@@ -77,6 +191,12 @@ namespace MultiBoost {
             }               
             readHeader(inHeaderFile, classMap, enumMaps, attributeNameMap, attributeTypes);
         }
+
+        if ( dataOffset >= 0 &&
+             readMappedData(_fileName, static_cast<size_t>(dataOffset), examples, 
+                            classMap, enumMaps, attributeTypes) )
+            return;
+
         readData(inFile, examples, classMap, enumMaps, attributeTypes);
 
     }
@@ -451,6 +571,162 @@ namespace MultiBoost {
 
     // ------------------------------------------------------------------------
 
+    bool ArffParser::readMappedData( const string& fileName, size_t dataOffset,
+                                     vector<Example>& examples, const NameMap& classMap,
+                                     const vector<NameMap>& enumMaps,
+                                     const vector<RawData::eAttributeType>& attributeTypes )
+    {
+        if ( _hasName || _hasAttributeClassForm || classMap.getNumNames() == 0 )
+            return false;
+
+        nor_utils::MappedFile mappedFile;
+        if ( !mappedFile.open(fileName) || dataOffset >= mappedFile.size() )
+            return false;
+
+        MappedDataTables tables;
+        tables.numAttributes = _numAttributes;
+        tables.numClasses = classMap.getNumNames();
+        tables.pAttributeTypes = &attributeTypes;
+        tables.enumIndices.resize(_numAttributes);
+        for ( int j = 0; j < _numAttributes; ++j )
+        {
+            if ( attributeTypes[j] != RawData::ATTRIBUTE_ENUM )
+                continue;
+            for ( int k = 0; k < enumMaps[j].getNumNames(); ++k )
+                tables.enumIndices[j][ enumMaps[j].getNameFromIdx(k) ] = k;
+        }
+        for ( int i = 0; i < tables.numClasses; ++i )
+            tables.classIndices[ classMap.getNameFromIdx(i) ] = i;
+
+        const char* dataBeg = mappedFile.begin() + dataOffset;
+        const char* dataEnd = mappedFile.end();
+        const size_t dataSize = dataEnd - dataBeg;
+
+        // split the data section into chunks of whole lines
+        const int numThreads = nor_utils::getNumThreads();
+        const int numChunks = numThreads > 1 ? numThreads * 4 : 1;
+        vector<const char*> chunkBegs(numChunks + 1);
+        chunkBegs[0] = dataBeg;
+        chunkBegs[numChunks] = dataEnd;
+        for ( int c = 1; c < numChunks; ++c )
+        {
+            const char* p = max( chunkBegs[c - 1], dataBeg + (dataSize / numChunks) * c );
+            while ( p != dataEnd && p != dataBeg && p[-1] != '\n' )
+                ++p;
+            chunkBegs[c] = p;
+        }
+
+        if (_verboseLevel > 0) cout << "Counting rows.." << flush;
+
+        // first pass: count the rows (the lines that are not blank) of each chunk
+        vector<size_t> chunkRows(numChunks, 0);
+        vector<size_t> chunkLines(numChunks, 0);
+        vector<char>   isChunkSupported(numChunks, 1);
+
+#pragma omp parallel for num_threads(numThreads) if (numThreads > 1) schedule(dynamic, 1)
+        for ( int c = 0; c < numChunks; ++c )
+        {
+            const char* chunkEnd = chunkBegs[c + 1];
+            for ( const char* p = chunkBegs[c]; p != chunkEnd; )
+            {
+                const char* eol = static_cast<const char*>( memchr(p, '\n', chunkEnd - p) );
+                if ( eol == NULL )
+                    eol = chunkEnd;
+                else
+                    ++chunkLines[c];
+
+                while ( p != eol && isSpace(*p) )
+                    ++p;
+                if ( p != eol )
+                {
+                    if ( *p == '%' || *p == '{' ) // comment or sparse row
+                    {
+                        isChunkSupported[c] = 0;
+                        break;
+                    }
+                    ++chunkRows[c];
+                }
+
+                p = (eol == chunkEnd) ? eol : eol + 1;
+            }
+        }
+
+        vector<size_t> chunkOffsets(numChunks + 1, 0);
+        size_t numLines = 0;
+        for ( int c = 0; c < numChunks; ++c )
+        {
+            if ( !isChunkSupported[c] )
+                return false;
+            chunkOffsets[c + 1] = chunkOffsets[c] + chunkRows[c];
+            numLines += chunkLines[c];
+        }
+
+        const size_t numRows = chunkOffsets[numChunks];
+        // the stream parser reads at most one row per newline
+        if ( numRows == 0 || numRows > numLines )
+            return false;
+
+        if (_verboseLevel > 0) cout << "Allocating.." << flush;
+
+        try {
+            examples.resize(numRows);
+        } 
+        catch(...) {
+            cerr << "ERROR: Cannot allocate memory for storage!" << endl;
+            exit(1);
+        }
+
+        if (_verboseLevel > 0) cout << "Done!" << endl;
+
+        if (_verboseLevel > 0) cout << "Now reading file.." << flush;
+
+        // second pass: parse the rows in place
+#pragma omp parallel for num_threads(numThreads) if (numThreads > 1) schedule(dynamic, 1)
+        for ( int c = 0; c < numChunks; ++c )
+        {
+            string tmpStr;
+            size_t i = chunkOffsets[c];
+            const char* chunkEnd = chunkBegs[c + 1];
+            for ( const char* p = chunkBegs[c]; p != chunkEnd; )
+            {
+                const char* eol = static_cast<const char*>( memchr(p, '\n', chunkEnd - p) );
+                if ( eol == NULL )
+                    eol = chunkEnd;
+
+                while ( p != eol && isSpace(*p) )
+                    ++p;
+                if ( p != eol )
+                {
+                    if ( !readMappedRow(p, eol, tables, examples[i], tmpStr) )
+                    {
+                        isChunkSupported[c] = 0;
+                        break;
+                    }
+                    ++i;
+                }
+
+                p = (eol == chunkEnd) ? eol : eol + 1;
+            }
+        }
+
+        for ( int c = 0; c < numChunks; ++c )
+        {
+            if ( !isChunkSupported[c] )
+            {
+                if (_verboseLevel > 0) cout << "Unsupported row, using the stream parser.." << flush;
+                vector<Example>().swap(examples);
+                return false;
+            }
+        }
+
+        _dataRep = DR_DENSE;
+        _labelRep = LR_DENSE;
+
+        return true;
+    }
+
+    // ------------------------------------------------------------------------
+
     void ArffParser::readSimpleLabels( istringstream& ss, vector<Label>& labels,
                                        NameMap& classMap )
     {
@@ -101,6 +101,27 @@ namespace MultiBoost {
                       vector<NameMap>& enumMaps, 
                       const vector<RawData::eAttributeType>& attributeTypes);
                 
+        /**
+         * Read the dense data section in place from the memory mapped file.
+         * The section is split into chunks of whole lines that are parsed in parallel,
+         * straight into their examples, and the numbers are converted with
+         * nor_utils::parse_double(), giving the same values as readData(ifstream&, ...).
+         * Only the dense rows with simple labels are supported: if the file has
+         * example names, class attributes (\a _hasAttributeClassForm), sparse rows,
+         * comments, labels with weights, or anything unexpected, it returns \a false
+         * and the stream parser must be used.
+         * \param fileName The name of the data file.
+         * \param dataOffset The position of the data section in the file.
+         * \param examples The examples to be filled. Left empty if the data is not supported.
+         * \param \see GenericParser::readData
+         * \return \a true if the data has been read.
+         * \date 16/10/2026
+         */
+        bool readMappedData(const string& fileName, size_t dataOffset,
+                            vector<Example>& examples, const NameMap& classMap,
+                            const vector<NameMap>& enumMaps,
+                            const vector<RawData::eAttributeType>& attributeTypes);
+
         string readName(ifstream& in);
                 
         void readDenseValues(ifstream& in, vector<FeatureReal>& values,
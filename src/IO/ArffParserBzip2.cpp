@@ -33,6 +33,7 @@
 
 #include <iostream>
 #include <cmath> // for abs
+#include <deque>
 
 #include "IO/ArffParserBzip2.h"
 #include "Utils/Utils.h"
@@ -56,7 +57,8 @@ namespace MultiBoost {
     {
 
         // open file
-        Bzip2WrapperReader inFile( _fileName.c_str() );
+        // the bzip2 blocks are decompressed in parallel
+        Bzip2WrapperReader inFile( _fileName.c_str(), nor_utils::getNumThreads() );
         if ( ! inFile.is_open() )
         {
             cerr << "\nERROR: Cannot open file <" << _fileName << ">!!" << endl;
@@ -216,23 +218,13 @@ namespace MultiBoost {
         istringstream ssSparse;
         ssSparse.imbue(_sparseLocale);
 
-        if (_verboseLevel > 0) cout << "Counting rows.." << flush;
-        //size_t numRows = nor_utils::count_rows(in);
-        /////////////////////////////////////////////////////
-        size_t numRows = in.remainingRowNum();
-        if (_verboseLevel > 0) cout << "Allocating.." << flush;
-        try {
-            examples.resize(numRows);
-        } 
-        catch(...) {
-            cerr << "ERROR: Cannot allocate memory for storage!" << endl;
-            exit(1);
-        }
-        if (_verboseLevel > 0) cout << "Done!" << endl;
+        // The rows are not counted beforehand, since it would decompress the
+        // file twice: they are read into a deque, which does not move its
+        // elements when it grows, and swapped into the examples at the end.
+        deque<Example> rows;
 
         if (_verboseLevel > 0) cout << "Now reading file.." << flush;
-        size_t i;
-        for (i = 0; i < numRows; ++i)
+        for (;;)
         {
 
             while ( isspace(firstChar = in.get()) && !in.eof() );
@@ -240,12 +232,8 @@ namespace MultiBoost {
             if (in.eof())
                 break;
 
-            //if ( i == 7493 ) {
-            //cout << i << endl;
-            //}
-
-
-            Example& currExample = examples[i];
+            rows.push_back( Example() );
+            Example& currExample = rows.back();
 
             //////////////////////////////////////////////////////////////////////////
             // first read the data
@@ -356,11 +344,20 @@ namespace MultiBoost {
 
         if (_verboseLevel > 0) cout << "Done!" << endl;
 
-        if ( i != numRows )
+        if (_verboseLevel > 0) cout << "Allocating.." << flush;
+        try {
+            examples.resize(rows.size());
+        } 
+        catch(...) {
+            cerr << "ERROR: Cannot allocate memory for storage!" << endl;
+            exit(1);
+        }
+        for (size_t i = 0; !rows.empty(); ++i)
         {
-            // last row was empty!
-            examples.resize(i);
+            examples[i].swapWith( rows.front() );
+            rows.pop_front();
         }
+        if (_verboseLevel > 0) cout << "Done!" << endl;
 
         // sparse representation always set the weight!
         if ( _labelRep == LR_SPARSE )
@@ -439,7 +436,7 @@ namespace MultiBoost {
                 if ( ( ! tmpVal.compare( "NaN" ) ) || ( ! tmpVal.compare( "?" ) ) )
                     values.push_back( numeric_limits<FeatureReal>::infinity() );
                 else
-                    values.push_back(atof(tmpVal.c_str()));
+                    values.push_back( nor_utils::parse_double( tmpVal.data(), tmpVal.data() + tmpVal.size() ) );
             else //if ( attributeTypes[i] == RawData::ATTRIBUTE_ENUM ) 
                 values.push_back( enumMaps[j].getIdxFromName(tmpVal) );
         }
@@ -0,0 +1,410 @@
+/*
+ *
+ *    MultiBoost - Multi-purpose boosting package
+ *
+ *    Copyright (C)        AppStat group
+ *                         Laboratoire de l'Accelerateur Lineaire
+ *                         Universite Paris-Sud, 11, CNRS
+ *
+ *    This file is part of the MultiBoost library
+ *
+ *    This library is free software; you can redistribute it 
+ *    and/or modify it under the terms of the GNU General Public
+ *    License as published by the Free Software Foundation
+ *    version 2.1 of the License.
+ *
+ *    This library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *    General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public
+ *    License along with this library; if not, write to the Free Software
+ *    Foundation, Inc., 51 Franklin St, 5th Floor, Boston, MA 02110-1301 USA
+ *
+ *    Contact: : multiboost@googlegroups.com
+ *
+ *    For more information and up-to-date version, please visit
+ *        
+ *                       http://www.multiboost.org/
+ *
+ */
+
+
+#include "IO/BinarySerialization.h"
+#include "WeakLearners/BaseLearner.h"
+
+#include <cstring> // for memcmp, memcpy
+#include <iostream>
+
+#ifndef _WIN32
+#include <sys/mman.h> // for mmap
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace MultiBoost {
+
+    const char BinarySerialization::MAGIC[8] = { 'M', 'B', 'S', 'H', 'Y', 'P', 'B', '\0' };
+    const int BinarySerialization::VERSION = 1;
+
+    // -----------------------------------------------------------------------
+
+    // The size of a record with numClasses classes, padded to 8 bytes.
+    static size_t getRecordSize(int numClasses)
+    {
+        const size_t size = 2 * sizeof(int) + (2 * numClasses + 1) * sizeof(double)
+            + numClasses * sizeof(int);
+        return (size + 7) & ~static_cast<size_t>(7);
+    }
+
+    // -----------------------------------------------------------------------
+
+    // The learner that is created for each type of record.
+    static const char* getLearnerName(int type)
+    {
+        switch (type)
+        {
+        case BHT_CONSTANT:
+            return "ConstantLearner";
+        case BHT_SINGLE_STUMP:
+            return "SingleStumpLearner";
+        case BHT_MULTI_STUMP:
+            return "MultiStumpLearner";
+        default:
+            return NULL;
+        }
+    }
+
+    // -----------------------------------------------------------------------
+    // -----------------------------------------------------------------------
+
+    BinarySerialization::BinarySerialization(const string& shypFileName)
+        : _shypFileName(shypFileName), _numClasses(0)
+    {
+        _shypFile.open(shypFileName.c_str(), ios::out | ios::binary | ios::trunc);
+        if (!_shypFile.is_open())
+        {
+            cerr << "ERROR: Cannot create strong hypothesis file <" << shypFileName << ">!" << endl;
+            exit(1);
+        }
+    }
+
+    // -----------------------------------------------------------------------
+
+    void BinarySerialization::writeString(const string& str)
+    {
+        writeInt( static_cast<int>(str.size()) );
+        _shypFile.write(str.data(), str.size());
+    }
+
+    // -----------------------------------------------------------------------
+
+    void BinarySerialization::writeHeader(const string& weakLearnerName, InputData* pData)
+    {
+        if (pData == NULL)
+        {
+            cerr << "ERROR: The binary strong hypothesis file needs the training data!" << endl;
+            exit(1);
+        }
+
+        const NameMap& classMap = pData->getClassMap();
+        const NameMap& attributeNameMap = pData->getAttributeNameMap();
+        _numClasses = pData->getNumClasses();
+        const int numAttributes = pData->getNumAttributes();
+
+        _shypFile.write(MAGIC, sizeof(MAGIC));
+        writeInt(VERSION);
+        writeInt(_numClasses);
+        writeInt(numAttributes);
+
+        writeString(weakLearnerName);
+        for (int l = 0; l < _numClasses; ++l)
+            writeString( classMap.getNameFromIdx(l) );
+        for (int j = 0; j < numAttributes; ++j)
+            writeString( attributeNameMap.getNameFromIdx(j) );
+
+        // align the first record
+        const char padding[8] = { 0, 0, 0, 0, 0, 0, 0, 0 };
+        const long pos = static_cast<long>(_shypFile.tellp());
+        _shypFile.write(padding, (8 - pos % 8) % 8);
+
+        _record.assign(getRecordSize(_numClasses), 0);
+    }
+
+    // -----------------------------------------------------------------------
+
+    void BinarySerialization::appendHypothesis(int iteration, BaseLearner* pWeakHypothesis)
+    {
+        if ( !pWeakHypothesis->saveBinary(_hypothesis) )
+        {
+            cerr << "ERROR: The weak learner <" << pWeakHypothesis->getName()
+                 << "> cannot be saved in the binary strong hypothesis format!" << endl;
+            exit(1);
+        }
+
+        char* pRecord = &_record[0];
+        const int type = _hypothesis.type;
+        const double alpha = _hypothesis.alpha;
+        memcpy(pRecord, &type, sizeof(int));
+        memcpy(pRecord + sizeof(int), &iteration, sizeof(int));
+        memcpy(pRecord + 2 * sizeof(int), &alpha, sizeof(double));
+
+        double* pV = reinterpret_cast<double*>(pRecord + 2 * sizeof(int) + sizeof(double));
+        double* pThresholds = pV + _numClasses;
+        int* pColumns = reinterpret_cast<int*>(pThresholds + _numClasses);
+        for (int l = 0; l < _numClasses; ++l)
+        {
+            pV[l] = _hypothesis.v[l];
+            pThresholds[l] = _hypothesis.thresholds[l];
+            pColumns[l] = _hypothesis.columns[l];
+        }
+
+        _shypFile.write(pRecord, _record.size());
+    }
+
+    // -----------------------------------------------------------------------
+
+    void BinarySerialization::writeFooter()
+    {
+        _shypFile.flush();
+    }
+
+    // -----------------------------------------------------------------------
+    // -----------------------------------------------------------------------
+
+    BinaryUnSerialization::BinaryUnSerialization(const string& shypFileName)
+        : _shypFileName(shypFileName), _pBuffer(NULL), _bufferSize(0), _isMapped(false),
+          _headerSize(0), _recordSize(0), _numHypotheses(0)
+    {
+#ifndef _WIN32
+        const int fd = open(shypFileName.c_str(), O_RDONLY);
+        if (fd < 0)
+        {
+            cerr << "ERROR: Cannot open strong hypothesis file <" << shypFileName << ">!" << endl;
+            exit(1);
+        }
+
+        struct stat fileStat;
+        if ( fstat(fd, &fileStat) == 0 && fileStat.st_size > 0 )
+        {
+            void* pMap = mmap(NULL, fileStat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (pMap != MAP_FAILED)
+            {
+                _pBuffer = static_cast<const char*>(pMap);
+                _bufferSize = fileStat.st_size;
+                _isMapped = true;
+            }
+        }
+        close(fd);
+#endif
+
+        // no mmap: read it at once
+        if (!_isMapped)
+        {
+            ifstream inFile(shypFileName.c_str(), ios::in | ios::binary);
+            if (!inFile.is_open())
+            {
+                cerr << "ERROR: Cannot open strong hypothesis file <" << shypFileName << ">!" << endl;
+                exit(1);
+            }
+            inFile.seekg(0, ios::end);
+            _bufferSize = static_cast<size_t>(inFile.tellg());
+            inFile.seekg(0, ios::beg);
+
+            char* pBuffer = new char[_bufferSize + 8];
+            inFile.read(pBuffer, _bufferSize);
+            _pBuffer = pBuffer;
+        }
+
+        // parse the header
+        size_t pos = 0;
+        checkSize(pos, sizeof(BinarySerialization::MAGIC));
+        if ( memcmp(_pBuffer, BinarySerialization::MAGIC, sizeof(BinarySerialization::MAGIC)) != 0 )
+        {
+            cerr << "ERROR: Not a valid MultiBoost Strong Hypothesis file!!" << endl;
+            exit(1);
+        }
+        pos += sizeof(BinarySerialization::MAGIC);
+
+        const int version = readInt(pos);
+        if (version != BinarySerialization::VERSION)
+        {
+            cerr << "ERROR: Unsupported version " << version << " of the binary strong hypothesis file <"
+                 << shypFileName << ">!" << endl;
+            exit(1);
+        }
+
+        const int numClasses = readInt(pos);
+        const int numAttributes = readInt(pos);
+        if (numClasses <= 0 || numAttributes < 0)
+        {
+            cerr << "ERROR: Corrupted binary strong hypothesis file <" << shypFileName << ">!" << endl;
+            exit(1);
+        }
+
+        _weakLearnerName = readString(pos);
+        _classNames.resize(numClasses);
+        for (int l = 0; l < numClasses; ++l)
+            _classNames[l] = readString(pos);
+        _attributeNames.resize(numAttributes);
+        for (int j = 0; j < numAttributes; ++j)
+            _attributeNames[j] = readString(pos);
+
+        _headerSize = (pos + 7) & ~static_cast<size_t>(7);
+        _recordSize = getRecordSize(numClasses);
+
+        // a truncated last record (interrupted training) is ignored
+        if (_bufferSize > _headerSize)
+            _numHypotheses = static_cast<int>( (_bufferSize - _headerSize) / _recordSize );
+    }
+
+    // -----------------------------------------------------------------------
+
+    BinaryUnSerialization::~BinaryUnSerialization()
+    {
+#ifndef _WIN32
+        if (_isMapped)
+        {
+            munmap(const_cast<char*>(_pBuffer), _bufferSize);
+            return;
+        }
+#endif
+        delete [] _pBuffer;
+    }
+
+    // -----------------------------------------------------------------------
+
+    void BinaryUnSerialization::checkSize(size_t pos, size_t size)
+    {
+        if (pos + size > _bufferSize)
+        {
+            cerr << "ERROR: Corrupted binary strong hypothesis file <" << _shypFileName << ">!" << endl;
+            exit(1);
+        }
+    }
+
+    // -----------------------------------------------------------------------
+
+    int BinaryUnSerialization::readInt(size_t& pos)
+    {
+        int val;
+        checkSize(pos, sizeof(int));
+        memcpy(&val, _pBuffer + pos, sizeof(int));
+        pos += sizeof(int);
+        return val;
+    }
+
+    // -----------------------------------------------------------------------
+
+    string BinaryUnSerialization::readString(size_t& pos)
+    {
+        const int length = readInt(pos);
+        if (length < 0)
+        {
+            cerr << "ERROR: Corrupted binary strong hypothesis file <" << _shypFileName << ">!" << endl;
+            exit(1);
+        }
+        checkSize(pos, length);
+        string str(_pBuffer + pos, length);
+        pos += length;
+        return str;
+    }
+
+    // -----------------------------------------------------------------------
+
+    void BinaryUnSerialization::loadHypotheses(vector<BaseLearner*>& weakHypotheses,
+                                               InputData* pTrainingData, int verbose)
+    {
+        const int numFileClasses = static_cast<int>(_classNames.size());
+        const int numClasses = pTrainingData->getNumClasses();
+
+        // map the classes of the file to the classes of the data
+        vector<int> classIndices(numFileClasses);
+        for (int l = 0; l < numFileClasses; ++l)
+            classIndices[l] = pTrainingData->getClassMap().getIdxFromName(_classNames[l]);
+
+        // the columns are mapped when they are first met
+        vector<int> columnIndices(_attributeNames.size(), -2);
+
+        BinaryHypothesis hypothesis;
+        weakHypotheses.reserve(weakHypotheses.size() + _numHypotheses);
+
+        for (int t = 0; t < _numHypotheses; ++t)
+        {
+            const char* pRecord = _pBuffer + _headerSize + t * _recordSize;
+
+            int type;
+            memcpy(&type, pRecord, sizeof(int));
+            const char* learnerName = getLearnerName(type);
+            if ( learnerName == NULL || !BaseLearner::RegisteredLearners().hasLearner(learnerName) )
+            {
+                cerr << "ERROR: Unknown weak hypothesis type " << type << " in the binary strong hypothesis file <"
+                     << _shypFileName << ">!" << endl;
+                exit(1);
+            }
+
+            double alpha;
+            memcpy(&alpha, pRecord + 2 * sizeof(int), sizeof(double));
+
+            // the records are aligned: read the arrays in place
+            const double* pV = reinterpret_cast<const double*>(pRecord + 2 * sizeof(int) + sizeof(double));
+            const double* pThresholds = pV + numFileClasses;
+            const int* pColumns = reinterpret_cast<const int*>(pThresholds + numFileClasses);
+
+            hypothesis.type = static_cast<eBinaryHypothesisType>(type);
+            hypothesis.alpha = alpha;
+            hypothesis.v.assign(numClasses, 0);
+            hypothesis.thresholds.assign(numClasses, 0);
+            hypothesis.columns.assign(numClasses, -1);
+
+            for (int l = 0; l < numFileClasses; ++l)
+            {
+                const int classIdx = classIndices[l];
+                if (classIdx < 0 || classIdx >= numClasses)
+                    continue;
+
+                hypothesis.v[classIdx] = static_cast<AlphaReal>(pV[l]);
+                hypothesis.thresholds[classIdx] = static_cast<FeatureReal>(pThresholds[l]);
+
+                const int fileColumn = pColumns[l];
+                if (fileColumn >= 0 && fileColumn < (int)columnIndices.size())
+                {
+                    if (columnIndices[fileColumn] == -2)
+                        columnIndices[fileColumn] =
+                            pTrainingData->getAttributeNameMap().getIdxFromName(_attributeNames[fileColumn]);
+                    hypothesis.columns[classIdx] = columnIndices[fileColumn];
+                }
+            }
+
+            BaseLearner* pWeakHypothesis =
+                BaseLearner::RegisteredLearners().getLearner(learnerName)->create();
+            pWeakHypothesis->setTrainingData(pTrainingData);
+            pWeakHypothesis->loadBinary(hypothesis);
+
+            weakHypotheses.push_back(pWeakHypothesis);
+
+            // show some progress while loading on verbose > 1
+            if (verbose > 1 && weakHypotheses.size() % 1000 == 0)
+                cout << "." << flush;
+        }
+    }
+
+    // -----------------------------------------------------------------------
+
+    bool BinaryUnSerialization::isBinaryShyp(const string& shypFileName)
+    {
+        ifstream inFile(shypFileName.c_str(), ios::in | ios::binary);
+        if (!inFile.is_open())
+            return false;
+
+        char magic[sizeof(BinarySerialization::MAGIC)];
+        inFile.read(magic, sizeof(magic));
+        return inFile.gcount() == sizeof(magic) &&
+            memcmp(magic, BinarySerialization::MAGIC, sizeof(magic)) == 0;
+    }
+
+    // -----------------------------------------------------------------------
+
+} // end of namespace MultiBoost
@@ -0,0 +1,235 @@
+/*
+ *
+ *    MultiBoost - Multi-purpose boosting package
+ *
+ *    Copyright (C)        AppStat group
+ *                         Laboratoire de l'Accelerateur Lineaire
+ *                         Universite Paris-Sud, 11, CNRS
+ *
+ *    This file is part of the MultiBoost library
+ *
+ *    This library is free software; you can redistribute it 
+ *    and/or modify it under the terms of the GNU General Public
+ *    License as published by the Free Software Foundation
+ *    version 2.1 of the License.
+ *
+ *    This library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *    General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public
+ *    License along with this library; if not, write to the Free Software
+ *    Foundation, Inc., 51 Franklin St, 5th Floor, Boston, MA 02110-1301 USA
+ *
+ *    Contact: : multiboost@googlegroups.com
+ *
+ *    For more information and up-to-date version, please visit
+ *        
+ *                       http://www.multiboost.org/
+ *
+ */
+
+
+
+/**
+ * \file BinarySerialization.h Save and load the strong hypothesis in binary format.
+ */
+
+#ifndef __BINARY_SERIALIZATION_H
+#define __BINARY_SERIALIZATION_H
+
+#include "Defaults.h" // for AlphaReal, FeatureReal
+#include "IO/InputData.h"
+
+#include <vector>
+#include <string>
+#include <fstream>
+
+using namespace std;
+
+//////////////////////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace MultiBoost {
+
+    // forward declaration to avoid an include
+    class BaseLearner;
+
+    /**
+     * The kinds of weak hypotheses that have a binary record.
+     * The values are written in the file: do not reorder them.
+     * \date 16/10/2026
+     */
+    enum eBinaryHypothesisType
+    {
+        BHT_CONSTANT = 0,     //!< ConstantLearner
+        BHT_SINGLE_STUMP = 1, //!< SingleStumpLearner
+        BHT_MULTI_STUMP = 2   //!< MultiStumpLearner
+    };
+
+    /**
+     * A weak hypothesis as it is exchanged between the learners and the
+     * binary strong hypothesis file. All the vectors have one element per class,
+     * and the columns and the classes are indexed as in the data of the learner
+     * (the file remaps them by name).
+     * \see BaseLearner::saveBinary
+     * \see BaseLearner::loadBinary
+     * \date 16/10/2026
+     */
+    struct BinaryHypothesis
+    {
+        eBinaryHypothesisType type;       //!< The kind of weak hypothesis.
+        AlphaReal             alpha;      //!< The coefficient of the hypothesis.
+        vector<AlphaReal>     v;          //!< The vote vector.
+        vector<int>           columns;    //!< The column per class (-1 if not used).
+        vector<FeatureReal>   thresholds; //!< The threshold per class (0 if not used).
+    };
+
+    /**
+     * The binary serialization (saving) of the weak learners found.
+     * The file starts with a header, that is the magic string, the version of the
+     * format, the name of the weak learner and the names of the classes and of the
+     * attributes of the training data. The weak hypotheses follow, as records of
+     * fixed size (for K classes):
+     * \verbatim
+     int32  type         (see eBinaryHypothesisType)
+     int32  iteration
+     double alpha
+     double v[K]
+     double thresholds[K]
+     int32  columns[K] \endverbatim
+     * The header and the records are padded to a multiple of 8 bytes, so each record
+     * is aligned and can be read in place from a memory mapped file. The numbers are stored in
+     * the byte order of the machine. Only the weak learners that implement
+     * BaseLearner::saveBinary() can be saved in this format.
+     * \see BinaryUnSerialization
+     * \see Serialization
+     * \date 16/10/2026
+     */
+    class BinarySerialization
+    {
+    public:
+
+        /**
+         * The constructor. Create the binary file.
+         * \param shypFileName The name of the strong hypothesis file.
+         * \date 16/10/2026
+         */
+        BinarySerialization(const string& shypFileName);
+
+        /**
+         * Write the header.
+         * \param weakLearnerName The name of the weak learner used to find the weak
+         * hypotheses.
+         * \param pData The data the hypotheses are trained on, for the names of
+         * the classes and of the attributes.
+         * \date 16/10/2026
+         */
+        void writeHeader(const string& weakLearnerName, InputData* pData);
+
+        /**
+         * Append the record of the passed weak hypothesis to the file. It stops with
+         * an error if the weak hypothesis has no binary record.
+         * \param iteration The iteration index.
+         * \param pWeakHypothesis The current weak hypothesis.
+         * \date 16/10/2026
+         */
+        void appendHypothesis(int iteration, BaseLearner* pWeakHypothesis);
+
+        /**
+         * Flush the file. The records are complete after each append, so there
+         * is no footer.
+         * \date 16/10/2026
+         */
+        void writeFooter();
+
+        static const char MAGIC[8]; //!< The first bytes of a binary strong hypothesis file.
+        static const int  VERSION;  //!< The version of the format written.
+
+    private:
+        void writeInt(int val) { _shypFile.write(reinterpret_cast<const char*>(&val), sizeof(int)); }
+        void writeString(const string& str);
+
+        ofstream          _shypFile;     //!< The strong learner file.
+        string            _shypFileName; //!< Its name, for the error messages.
+        int               _numClasses;   //!< The number of classes of each record.
+        BinaryHypothesis  _hypothesis;   //!< The buffer of the hypothesis being saved.
+        vector<char>      _record;       //!< The buffer of the record being written.
+    };
+
+    // -----------------------------------------------------------------------
+    // -----------------------------------------------------------------------
+
+    /**
+     * The binary un-serialization (loading) of the weak learners found. The file is
+     * memory mapped (read at once if mmap is not available) and the records are
+     * decoded in place.
+     * \see BinarySerialization
+     * \see UnSerialization
+     * \date 16/10/2026
+     */
+    class BinaryUnSerialization
+    {
+    public:
+
+        /**
+         * The constructor. It opens and maps the file, and parses the header.
+         * It stops with an error if the file is not a valid binary strong
+         * hypothesis file.
+         * \param shypFileName The name of the strong hypothesis file.
+         * \date 16/10/2026
+         */
+        BinaryUnSerialization(const string& shypFileName);
+
+        /**
+         * The destructor. It unmaps the file.
+         * \date 16/10/2026
+         */
+        ~BinaryUnSerialization();
+
+        /**
+         * Load the weak hypotheses of the file.
+         * \param weakHypotheses The vector of weak hypotheses that will be filled.
+         * \param pTrainingData Pointer to the data, needed for the class and attribute names.
+         * \param verbose The level of verbosity.
+         * \date 16/10/2026
+         */
+        void loadHypotheses(vector<BaseLearner*>& weakHypotheses,
+                            InputData* pTrainingData, int verbose = 1);
+
+        //! The name of the weak learner stored in the header.
+        const string& getWeakLearnerName() const { return _weakLearnerName; }
+
+        //! The number of complete records in the file.
+        int getNumHypotheses() const { return _numHypotheses; }
+
+        /**
+         * Check if the file starts with the magic string of the binary format.
+         * \param shypFileName The name of the strong hypothesis file.
+         * \return true if it is a binary strong hypothesis file.
+         * \date 16/10/2026
+         */
+        static bool isBinaryShyp(const string& shypFileName);
+
+    private:
+        int readInt(size_t& pos);
+        string readString(size_t& pos);
+        void checkSize(size_t pos, size_t size);
+
+        string          _shypFileName;    //!< The name of the file, for the error messages.
+        const char*     _pBuffer;         //!< The content of the file.
+        size_t          _bufferSize;      //!< The size of the file.
+        bool            _isMapped;        //!< Is _pBuffer memory mapped (or allocated)?
+
+        string          _weakLearnerName; //!< The name of the weak learner.
+        vector<string>  _classNames;      //!< The names of the classes, in file order.
+        vector<string>  _attributeNames;  //!< The names of the attributes, in file order.
+        size_t          _headerSize;      //!< The offset of the first record.
+        size_t          _recordSize;      //!< The size of a record.
+        int             _numHypotheses;   //!< The number of complete records.
+    };
+
+} // end of namespace MultiBoost
+
+#endif // __BINARY_SERIALIZATION_H
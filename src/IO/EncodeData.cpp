@@ -32,6 +32,13 @@
 
 
 #include "EncodeData.h"
+#include "WeakLearners/ParasiteLearner.h"
+#include "IO/OutputInfo.h"
+#include "Utils/Utils.h" // for getNumThreads
+
+#include <fstream>
+#include <sstream>
+#include <cmath>
 
 
 //
@@ -42,6 +49,10 @@ namespace MultiBoost {
     void EncodeData::resetData()
     { 
         _pData->clearRawData();
+        _numExamples = 0;
+        _indirectIndices.clear();
+        _rawIndices.clear();
+        updateVersion();
     }
 
 
@@ -50,6 +61,228 @@ namespace MultiBoost {
     void EncodeData::addExample(Example example)
     { 
         _pData->addExample( example );
+        _indirectIndices.push_back( _numExamples );
+        _rawIndices.push_back( _numExamples );
+        ++_numExamples;
+        updateVersion();
+    }
+
+// ------------------------------------------------------------------------
+// ------------------------------------------------------------------------
+
+    void DataEncoder::encode(const string& labelsFileName, const string& autoassociativeFileName,
+                             const string& outputFileName, int numIterations, int numBaseLearners)
+    {
+        InputData* pAutoassociativeData = new InputData();
+        pAutoassociativeData->initOptions(_args);
+        pAutoassociativeData->load(autoassociativeFileName,IT_TRAIN,_verbose);
+
+        // for the original labels, it is loaded once if it is the same file
+        InputData* pLabelsData = pAutoassociativeData;
+        if ( labelsFileName != autoassociativeFileName )
+        {
+            pLabelsData = new InputData();
+            pLabelsData->initOptions(_args);
+            pLabelsData->load(labelsFileName,IT_TRAIN,_verbose);
+        }
+
+        const int numExamples = pAutoassociativeData->getNumExamples();
+        const int numClasses = pAutoassociativeData->getNumClasses();
+        if ( pLabelsData->getNumExamples() != numExamples )
+        {
+            cerr << "ERROR: The label file <" << labelsFileName << "> and the autoassociative file <"
+                 << autoassociativeFileName << "> must have the same number of examples!" << endl;
+            exit(1);
+        }
+
+        const NameMap& classMap = pLabelsData->getClassMap();
+        vector<string> classNames( classMap.getNumNames() );
+        for (int l = 0; l < classMap.getNumNames(); ++l)
+            classNames[l] = classMap.getNameFromIdx(l);
+
+        // the step-by-step information needs the example alone with its weights,
+        // so the examples are encoded serially
+        if ( _args.hasArgument("outputinfo") )
+        {
+            _pOnePoint = new EncodeData();
+            _pOnePoint->initOptions(_args);
+            _pOnePoint->copyHeader(pAutoassociativeData);
+            _pOutInfo = new OutputInfo(_args);
+        }
+
+        // one learner per thread, they share the pool and its outputs
+        const int numThreads = _pOutInfo ? 1 : nor_utils::getNumThreads();
+        BaseLearner* pWeakHypothesisSource = 
+            BaseLearner::RegisteredLearners().getLearner("ParasiteLearner");
+        vector<ParasiteLearner*> learners(numThreads);
+        for (int t = 0; t < numThreads; ++t)
+        {
+            learners[t] = dynamic_cast<ParasiteLearner*>( pWeakHypothesisSource->create() );
+            learners[t]->initLearningOptions(_args);
+            learners[t]->setTrainingData(pAutoassociativeData);
+        }
+
+        ofstream outFile(outputFileName.c_str());
+        if (!outFile.is_open())
+        {
+            cerr << "ERROR: Cannot open strong hypothesis file <" << outputFileName << ">!" << endl;
+            exit(1);
+        }
+
+        // the outputs of the pool are kept for one block at a time
+        const int blockSize = 16384;
+        vector<int> blockIndices;
+        vector<string> rows;
+
+        for (int blockBeg = 0; blockBeg < numExamples; blockBeg += blockSize)
+        {
+            const int blockEnd = min(blockBeg + blockSize, numExamples);
+            const int numBlockExamples = blockEnd - blockBeg;
+
+            blockIndices.resize(numBlockExamples);
+            for (int k = 0; k < numBlockExamples; ++k)
+                blockIndices[k] = blockBeg + k;
+            pAutoassociativeData->loadIndexSet(blockIndices);
+
+            learners[0]->initPool(pAutoassociativeData);
+
+            if (blockBeg == 0)
+            {
+                const vector<BaseLearner*>& baseLearners = learners[0]->getBaseLearners();
+                if ( baseLearners.empty() )
+                {
+                    cerr << "ERROR: The pool of weak learners is empty!" << endl;
+                    exit(1);
+                }
+                if ( numBaseLearners < 0 || (int)baseLearners.size() < numBaseLearners )
+                    numBaseLearners = baseLearners.size();
+                outFile << "%Hidden representation using autoassociative boosting" << endl << endl;
+                outFile << "@RELATION " << outputFileName << endl << endl;
+                outFile << "% numBaseLearners" << endl;
+                for (int j = 0; j < numBaseLearners; ++j) 
+                    outFile << "@ATTRIBUTE " << j << "_" << baseLearners[j]->getId() << " NUMERIC" << endl;
+                outFile << "@ATTRIBUTE class {" << classNames[0];
+                for (int l = 1; l < (int)classNames.size(); ++l)
+                    outFile << ", " << classNames[l];
+                outFile << "}" << endl<< endl<< "@DATA" << endl;
+            }
+
+            if (_verbose >= 1)
+                cout << "--> Encoding examples " << (blockBeg+1) << " to " << blockEnd << endl;
+
+            rows.resize(numBlockExamples);
+
+#pragma omp parallel num_threads(numThreads) if (numThreads > 1)
+            {
+                ParasiteLearner* pLearner = learners[ nor_utils::getThreadIdx() ];
+                vector<float> alphas(numBaseLearners);
+                vector<AlphaReal> weights(numClasses);
+                vector<char> ys(numClasses);
+                ostringstream row;
+
+#pragma omp for schedule(dynamic, 16)
+                for (int k = 0; k < numBlockExamples; ++k)
+                {
+                    encodeExample(pLearner, pAutoassociativeData, k, numIterations, alphas, weights, ys);
+
+                    float sumAlphas = 0;
+                    for (int j = 0; j < numBaseLearners; ++j)
+                        sumAlphas += alphas[j];
+
+                    row.str("");
+                    for (int j = 0; j < numBaseLearners; ++j)
+                        row << alphas[j]/sumAlphas << ",";
+
+                    const vector<Label>& labels = (pLabelsData == pAutoassociativeData) ?
+                        pLabelsData->getLabels(k) : pLabelsData->getLabels(blockBeg + k);
+                    for (int l = 0; l < (int)labels.size(); ++l)
+                        if (labels[l].y > 0)
+                            row << classNames[labels[l].idx] << '\n';
+
+                    rows[k] = row.str();
+                }
+            }
+
+            // in the order of the input
+            for (int k = 0; k < numBlockExamples; ++k)
+                outFile << rows[k];
+        }
+
+        outFile.close();
+        pAutoassociativeData->clearIndexSet();
+
+        for (int t = 0; t < numThreads; ++t)
+            delete learners[t];
+        if (_pOutInfo)
+        {
+            delete _pOutInfo;
+            delete _pOnePoint;
+            _pOutInfo = NULL;
+            _pOnePoint = NULL;
+        }
+        if (pLabelsData != pAutoassociativeData)
+            delete pLabelsData;
+        delete pAutoassociativeData;
+    }
+
+// ------------------------------------------------------------------------
+
+    void DataEncoder::encodeExample(ParasiteLearner* pLearner, InputData* pData, int idx, int numIterations,
+                                    vector<float>& alphas, vector<AlphaReal>& weights, vector<char>& ys)
+    {
+        const vector<Label>& labels = pData->getLabels(idx);
+        const int numClasses = static_cast<int>( weights.size() );
+        const int firstOutput = idx * numClasses;
+
+        for (int l = 0; l < numClasses; ++l)
+        {
+            weights[l] = labels[l].weight;
+            ys[l] = labels[l].y;
+        }
+        fill(alphas.begin(), alphas.end(), 0);
+
+        if (_pOutInfo)
+        {
+            _pOnePoint->resetData();
+            _pOnePoint->addExample( pData->getExample(idx) );
+            _pOutInfo->initialize(_pOnePoint);
+        }
+
+        vector<AlphaReal> factors(numClasses);
+
+        for (int t = 0; t < numIterations; ++t)
+        {
+            pLearner->runOnExample(idx, weights, ys);
+
+            const int j = pLearner->getSelectedIndex();
+            const int signOfAlpha = pLearner->getSignOfAlpha();
+            const AlphaReal alpha = pLearner->getAlpha();
+            alphas[j] += alpha * signOfAlpha;
+
+            // as AdaBoostMHLearner::printOutputInfo(), before the weight update
+            if (_pOutInfo)
+            {
+                vector<Label>& onePointLabels = _pOnePoint->getLabels(0);
+                for (int l = 0; l < numClasses; ++l)
+                    onePointLabels[l].weight = weights[l];
+
+                _pOutInfo->outputIteration(t);
+                _pOutInfo->outputCustom(_pOnePoint, pLearner);
+                _pOutInfo->outputCurrentTime();
+                _pOutInfo->endLine();
+            }
+
+            // the weight update of AdaBoostMHLearner::updateWeights() on this example
+            AlphaReal Z = 0;
+            for (int l = 0; l < numClasses; ++l)
+            {
+                const AlphaReal h = signOfAlpha * ParasiteLearner::getPoolOutput(j, firstOutput + l);
+                factors[l] = exp( -alpha * ( h * ys[l] ) );
+                Z += weights[l] * factors[l];
+            }
+            for (int l = 0; l < numClasses; ++l)
+                weights[l] = weights[l] * factors[l] / Z;
+        }
     }
 
 } // end of namespace MultiBoost
@@ -40,6 +40,7 @@
 #define __ENCODE_DATA_H
 
 #include "IO/InputData.h"
+#include "Utils/Args.h"
 
 #include <vector>
 #include <utility> // for pair
@@ -81,6 +82,76 @@ namespace MultiBoost {
 
     };
 
+    class ParasiteLearner;
+    class OutputInfo;
+
+//////////////////////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * The engine of the --encode option. For each example of the autoassociative data,
+ * it runs AdaBoost.MH with ParasiteLearner on this example alone, and the normalized
+ * coefficients of the learners of the pool are the new representation of the
+ * example. 
+ * The data is loaded once and the examples are encoded by blocks: the outputs of 
+ * the pool are computed once on the examples of the block, then the examples are 
+ * encoded in parallel, one ParasiteLearner per thread, and the block is written in
+ * the order of the input.
+ * With --outputinfo the examples are encoded serially, and the step-by-step 
+ * information of the boosting of each example alone is written, one example 
+ * after the other.
+ * \date 16/10/2026
+ */
+    class DataEncoder
+    {
+    public:
+
+        /**
+         * The constructor.
+         * \param args The arguments of the command line, with the --pool of 
+         * ParasiteLearner set.
+         * \param verbose The level of verbosity.
+         * \date 16/10/2026
+         */
+        DataEncoder(const nor_utils::Args& args, int verbose = 1)
+            : _args(args), _verbose(verbose), _pOutInfo(NULL), _pOnePoint(NULL) {}
+
+        /**
+         * Encode the examples and write them as an arff file.
+         * \param labelsFileName The file with the original labels of the examples.
+         * \param autoassociativeFileName The file with the examples to be encoded.
+         * \param outputFileName The output arff file.
+         * \param numIterations The number of iterations of boosting per example.
+         * \param numBaseLearners The number of learners of the pool (attributes of
+         * the output), -1 for all of them.
+         * \date 16/10/2026
+         */
+        void encode(const string& labelsFileName, const string& autoassociativeFileName,
+                    const string& outputFileName, int numIterations, int numBaseLearners);
+
+    private:
+
+        /**
+         * Run the boosting iterations on one example of the current block.
+         * \param pLearner The learner of the thread.
+         * \param pData The data, filtered to the block.
+         * \param idx The index of the example in the block.
+         * \param numIterations The number of iterations.
+         * \param alphas The sum of the coefficients of each learner of the pool.
+         * \param weights A buffer for the weights of the classes.
+         * \param ys A buffer for the labels of the classes.
+         * \date 16/10/2026
+         */
+        void encodeExample(ParasiteLearner* pLearner, InputData* pData, int idx, int numIterations,
+                           vector<float>& alphas, vector<AlphaReal>& weights, vector<char>& ys);
+
+        const nor_utils::Args& _args; //!< The arguments of the command line.
+        int _verbose; //!< The level of verbosity.
+
+        OutputInfo* _pOutInfo; //!< The step-by-step information, NULL without --outputinfo.
+        EncodeData* _pOnePoint; //!< The example being encoded alone, for _pOutInfo.
+    };
+
 } // end of namespace MultiBoost
 
 #endif // __ENCODE_DATA_H
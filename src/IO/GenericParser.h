@@ -65,6 +65,12 @@ namespace MultiBoost
         : _fileName(fileName), _headerFileName(headerFileName), 
             _dataRep(DR_DENSE), _labelRep(LR_DENSE), _hasWeigthInit(false) {}
                 
+        /**
+         * The destructor. Must be declared (virtual) for the proper destruction of
+         * the object, since the parsers are deleted through this class.
+         */
+        virtual ~GenericParser() {}
+
         /**
          * Abstract function for reading data.
          * \param examples The vector of examples to be filled up.
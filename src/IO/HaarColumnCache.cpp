@@ -0,0 +1,94 @@
+/*
+ *
+ *    MultiBoost - Multi-purpose boosting package
+ *
+ *    Copyright (C)        AppStat group
+ *                         Laboratoire de l'Accelerateur Lineaire
+ *                         Universite Paris-Sud, 11, CNRS
+ *
+ *    This file is part of the MultiBoost library
+ *
+ *    This library is free software; you can redistribute it 
+ *    and/or modify it under the terms of the GNU General Public
+ *    License as published by the Free Software Foundation
+ *    version 2.1 of the License.
+ *
+ *    This library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *    General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public
+ *    License along with this library; if not, write to the Free Software
+ *    Foundation, Inc., 51 Franklin St, 5th Floor, Boston, MA 02110-1301 USA
+ *
+ *    Contact: : multiboost@googlegroups.com
+ *
+ *    For more information and up-to-date version, please visit
+ *        
+ *                       http://www.multiboost.org/
+ *
+ */
+
+
+
+#include "IO/HaarColumnCache.h"
+
+namespace MultiBoost {
+
+    // -------------------------------------------------------------------------
+
+    const HaarColumnCache::column* HaarColumnCache::find(int featureType, int configIdx)
+    {
+        map<key, lru_list::iterator>::iterator it = _index.find( key(featureType, configIdx) );
+        if ( it == _index.end() )
+        {
+            ++_numMisses;
+            return NULL;
+        }
+
+        ++_numHits;
+
+        // move it in front, the iterators stay valid
+        _columns.splice( _columns.begin(), _columns, it->second );
+        return &it->second->second;
+    }
+
+    // -------------------------------------------------------------------------
+
+    void HaarColumnCache::insert(int featureType, int configIdx, const column& sortedColumn)
+    {
+        const size_t numBytes = getNumBytes(sortedColumn);
+        if ( numBytes > _maxNumBytes )
+            return;
+
+        const key k(featureType, configIdx);
+        if ( _index.find(k) != _index.end() )
+            return;
+
+        // evict the least recently used columns
+        while ( _numBytes + numBytes > _maxNumBytes )
+        {
+            _numBytes -= getNumBytes( _columns.back().second );
+            _index.erase( _columns.back().first );
+            _columns.pop_back();
+        }
+
+        _columns.push_front( make_pair(k, column()) );
+        _columns.front().second = sortedColumn;
+        _index[k] = _columns.begin();
+        _numBytes += numBytes;
+    }
+
+    // -------------------------------------------------------------------------
+
+    void HaarColumnCache::clear()
+    {
+        _columns.clear();
+        _index.clear();
+        _numBytes = 0;
+    }
+
+    // -------------------------------------------------------------------------
+
+} // end of namespace MultiBoost
@@ -0,0 +1,158 @@
+/*
+ *
+ *    MultiBoost - Multi-purpose boosting package
+ *
+ *    Copyright (C)        AppStat group
+ *                         Laboratoire de l'Accelerateur Lineaire
+ *                         Universite Paris-Sud, 11, CNRS
+ *
+ *    This file is part of the MultiBoost library
+ *
+ *    This library is free software; you can redistribute it 
+ *    and/or modify it under the terms of the GNU General Public
+ *    License as published by the Free Software Foundation
+ *    version 2.1 of the License.
+ *
+ *    This library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *    General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public
+ *    License along with this library; if not, write to the Free Software
+ *    Foundation, Inc., 51 Franklin St, 5th Floor, Boston, MA 02110-1301 USA
+ *
+ *    Contact: : multiboost@googlegroups.com
+ *
+ *    For more information and up-to-date version, please visit
+ *        
+ *                       http://www.multiboost.org/
+ *
+ */
+
+
+
+/**
+ * \file HaarColumnCache.h The sorted outputs of the Haar configurations on the training data.
+ */
+
+#ifndef __HAAR_COLUMN_CACHE_H
+#define __HAAR_COLUMN_CACHE_H
+
+#include "Defaults.h" // for FeatureReal
+
+#include <vector>
+#include <map>
+#include <list>
+#include <utility> // for pair
+
+using namespace std;
+
+//////////////////////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace MultiBoost {
+
+    /**
+     * A least recently used cache of the outputs of the Haar configurations on 
+     * the training examples, sorted by value, as they are given to the stump 
+     * algorithms. The outputs of a configuration never change during the training
+     * (only the weights do), so when a configuration is visited again the
+     * transformation of the integral images and the sort can be skipped.
+     * The cache is keyed by the type of the feature and the index of the
+     * configuration, and it holds at most a given number of bytes: the least
+     * recently used columns are evicted to make room for the new ones.
+     * \remark The cache is emptied when the number of raw examples changes
+     * (see setNumRawExamples), but it cannot know when a subset of the examples
+     * is selected: it must be used only with the whole (not filtered) training data.
+     * \remark It is not thread safe: find() and insert() must be called serially.
+     * \see HaarData::getColumnCache
+     * \date 16/10/2026
+     */
+    class HaarColumnCache
+    {
+    public:
+
+        typedef vector< pair<int, FeatureReal> > column; //!< The (index, value) pairs sorted by value.
+
+        /**
+         * The constructor. The cache is disabled.
+         * \date 16/10/2026
+         */
+        HaarColumnCache() : _maxNumBytes(0), _numBytes(0), _numHits(0), _numMisses(0), _numRawExamples(0) {}
+
+        /**
+         * Set the memory budget of the cache. The cache is emptied.
+         * \param maxNumBytes The maximum number of bytes of the stored columns,
+         * 0 disables the cache.
+         * \date 16/10/2026
+         */
+        void setBudget(size_t maxNumBytes) { clear(); _maxNumBytes = maxNumBytes; }
+
+        //! Is the cache enabled?
+        bool isEnabled() const { return _maxNumBytes > 0; }
+
+        /**
+         * Look for the sorted column of a configuration, which becomes the most
+         * recently used one.
+         * \param featureType The type of the feature (see eFeatureType).
+         * \param configIdx The index of the configuration of the feature.
+         * \return The pointer to the column, or NULL if it is not in the cache.
+         * The pointer is valid until the next call to insert() or clear().
+         * \date 16/10/2026
+         */
+        const column* find(int featureType, int configIdx);
+
+        /**
+         * Store the sorted column of a configuration, evicting the least recently
+         * used columns if needed. A column larger than the budget is not stored.
+         * \param featureType The type of the feature (see eFeatureType).
+         * \param configIdx The index of the configuration of the feature.
+         * \param sortedColumn The column, which is copied.
+         * \date 16/10/2026
+         */
+        void insert(int featureType, int configIdx, const column& sortedColumn);
+
+        /**
+         * Set the number of raw examples the columns are computed on. When it
+         * changes (examples were added to the data), the cache is emptied.
+         * \param numRawExamples The number of raw examples of the data.
+         * \date 16/10/2026
+         */
+        void setNumRawExamples(int numRawExamples)
+        {
+            if ( numRawExamples != _numRawExamples ) { clear(); _numRawExamples = numRawExamples; }
+        }
+
+        /**
+         * Drop all the columns. The hit and miss counters are kept.
+         * \date 16/10/2026
+         */
+        void clear();
+
+        long   getNumHits() const { return _numHits; } //!< The number of successful find() calls.
+        long   getNumMisses() const { return _numMisses; } //!< The number of failed find() calls.
+        size_t getNumBytes() const { return _numBytes; } //!< The number of bytes of the stored columns.
+        size_t getNumColumns() const { return _index.size(); } //!< The number of stored columns.
+
+    private:
+
+        typedef pair<int, int> key; //!< (feature type, configuration index)
+        typedef list< pair<key, column> > lru_list; //!< The columns, the most recently used first.
+
+        static size_t getNumBytes(const column& c) 
+        { return sizeof( pair<key, column> ) + c.size() * sizeof( pair<int, FeatureReal> ); }
+
+        lru_list                        _columns; //!< The stored columns.
+        map<key, lru_list::iterator>    _index; //!< The position of the columns in _columns.
+
+        size_t _maxNumBytes; //!< The memory budget, 0 if disabled.
+        size_t _numBytes; //!< The memory used by the stored columns.
+        long   _numHits; //!< The number of hits.
+        long   _numMisses; //!< The number of misses.
+        int    _numRawExamples; //!< The number of raw examples the columns are computed on.
+    };
+
+} // end of namespace MultiBoost
+
+#endif // __HAAR_COLUMN_CACHE_H
@@ -105,6 +105,10 @@ namespace MultiBoost {
                 
         ss.getline(val, 10);
         _height = static_cast<short>( atoi(val) );
+
+        // the budget of the cache of the configurations, in megabytes
+        if ( args.hasArgument("hcache") )
+            _columnCache.setBudget( static_cast<size_t>( args.getValue<int>("hcache", 0) ) * 1024 * 1024 );
     }
         
     // ------------------------------------------------------------------------
@@ -244,7 +248,7 @@ namespace MultiBoost {
             if (verboseLevel > 1)
                 cout << "(" << (*it)->getShortName() << ": " << nPrecs << ")" << flush;
         }
-                
+
         //if (verboseLevel > 0)
         //   cout << endl;
                 
@@ -264,6 +268,40 @@ namespace MultiBoost {
                 
     }
         
+    // ------------------------------------------------------------------------
+
+    bool HaarData::preparePixelMajorImages()
+    {
+        if ( isFiltered() )
+            return false;
+
+        if ( _pixelMajorImages.empty() || 
+             _numPixelMajorExamples != static_cast<size_t>( getNumExamples() ) )
+            buildPixelMajorImages();
+
+        return true;
+    }
+
+    // ------------------------------------------------------------------------
+
+    void HaarData::buildPixelMajorImages()
+    {
+        const vector<Example>& examples = _pData->getExamples();
+        const size_t numPixels = static_cast<size_t>(_width) * _height;
+
+        _numPixelMajorExamples = examples.size();
+        _pixelMajorImages.assign( (numPixels + 1) * _numPixelMajorExamples, 0 );
+
+        for (size_t i = 0; i < _numPixelMajorExamples; ++i)
+        {
+            const vector<FeatureReal>& intImage = examples[i].getValues();
+            const size_t numValues = min( numPixels, intImage.size() );
+
+            for (size_t p = 0; p < numValues; ++p)
+                _pixelMajorImages[ p * _numPixelMajorExamples + i ] = intImage[p];
+        }
+    }
+        
     // ------------------------------------------------------------------------
     bool HaarData::checkInput(const string& line, int numColumns)
     {
@@ -44,6 +44,7 @@
 #define __HAAR_DATA_H
 
 #include "IO/InputData.h"
+#include "IO/HaarColumnCache.h"
 #include "WeakLearners/Haar/HaarFeatures.h"
 #include "Utils/Utils.h" // for Rect
 
@@ -95,6 +96,12 @@ namespace MultiBoost {
     {
     public:
                 
+        /**
+         * The constructor. It does nothing but initializing some variables.
+         * \date 16/10/2026
+         */
+        HaarData() : _numPixelMajorExamples(0) {}
+
         /**
          * The destructor. Erases the integral image data.
          * \date 17/12/2005
@@ -153,6 +160,49 @@ namespace MultiBoost {
          * \date 17/12/2005
          */
         vector<HaarFeature*>& getLoadedFeatures() { return _loadedFeatures; }
+
+        /**
+         * Get the cache of the sorted outputs of the configurations on these 
+         * examples. It is disabled unless a budget is given with --hcache.
+         * It is emptied if examples were added since the last call.
+         * \see HaarColumnCache
+         * \date 16/10/2026
+         */
+        HaarColumnCache& getColumnCache() 
+        { 
+            _columnCache.setNumRawExamples( _pData->getNumExample() );
+            return _columnCache; 
+        }
+
+        /**
+         * Prepare the pixel-major copy of the integral images for the search of 
+         * the configurations. It is built at the first call, so only the data the
+         * learners search on carries it (not the test, validation or bootstrap
+         * data), and it is built again if examples were added since (see 
+         * addExample). It cannot be used when a subset of the examples is selected.
+         * \remark It is not thread safe: call it before the parallel search.
+         * \return true if getPixelColumn() can be used.
+         * \see getPixelColumn
+         * \date 16/10/2026
+         */
+        bool preparePixelMajorImages();
+
+        /**
+         * Get the values of the integral images at (x, y) for all the examples,
+         * from the pixel-major copy of the integral images: the values of the
+         * same pixel for all the examples are contiguous.
+         * \param x The x coordinate.
+         * \param y The y coordinate.
+         * \return The pointer to the numExamples values. If x or y is negative, 
+         * the values are zeros, as in HaarFeature::getSumAt.
+         * \see preparePixelMajorImages
+         * \date 16/10/2026
+         */
+        const FeatureReal* getPixelColumn(int x, int y) const
+        {
+            const size_t pixelIdx = ( x < 0 || y < 0 ) ? _width * _height : _width * y + x;
+            return &_pixelMajorImages[ pixelIdx * _numPixelMajorExamples ];
+        }
                 
         //////////////////////////////////////////////////////////////////////////
                 
@@ -170,6 +220,13 @@ namespace MultiBoost {
                 
     protected:
         bool checkInput(const string& line, int numColumns);
+
+        /**
+         * Build the pixel-major copy of the integral images of the examples.
+         * \see getPixelColumn
+         * \date 16/10/2026
+         */
+        void buildPixelMajorImages();
                 
         //vector< int* >   _intImages;       //!< the data of the examples.
                 
@@ -180,6 +237,15 @@ namespace MultiBoost {
          * The list of features that have been requested by the user.
          */
         vector<HaarFeature*> _loadedFeatures; //!< 
+
+        /**
+         * The integral images stored pixel by pixel: (width * height + 1) rows of
+         * _numPixelMajorExamples values, the last row is zeros.
+         */
+        vector<FeatureReal> _pixelMajorImages;
+        size_t _numPixelMajorExamples; //!< The number of examples in _pixelMajorImages.
+
+        HaarColumnCache _columnCache; //!< The sorted outputs of the visited configurations.
     };
         
 } // end of namespace Multiboost
@@ -0,0 +1,85 @@
+/*
+ *
+ *    MultiBoost - Multi-purpose boosting package
+ *
+ *    Copyright (C)        AppStat group
+ *                         Laboratoire de l'Accelerateur Lineaire
+ *                         Universite Paris-Sud, 11, CNRS
+ *
+ *    This file is part of the MultiBoost library
+ *
+ *    This library is free software; you can redistribute it 
+ *    and/or modify it under the terms of the GNU General Public
+ *    License as published by the Free Software Foundation
+ *    version 2.1 of the License.
+ *
+ *    This library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *    General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public
+ *    License along with this library; if not, write to the Free Software
+ *    Foundation, Inc., 51 Franklin St, 5th Floor, Boston, MA 02110-1301 USA
+ *
+ *    Contact: : multiboost@googlegroups.com
+ *
+ *    For more information and up-to-date version, please visit
+ *        
+ *                       http://www.multiboost.org/
+ *
+ */
+
+
+
+#include "IO/HypothesisOutputCache.h"
+#include "WeakLearners/BaseLearner.h"
+#include "Utils/Utils.h" // for getNumThreads
+
+namespace MultiBoost {
+
+    // -------------------------------------------------------------------------
+
+    void HypothesisOutputCache::setHypothesis(BaseLearner* pWeakHypothesis)
+    {
+        _pWeakHypothesis = pWeakHypothesis;
+
+        map<InputData*, CachedOutputs>::iterator it;
+        for (it = _outputs.begin(); it != _outputs.end(); ++it)
+            it->second.isValid = false;
+    }
+
+    // -------------------------------------------------------------------------
+
+    const vector<AlphaReal>& HypothesisOutputCache::getOutputs(InputData* pData)
+    {
+        CachedOutputs& cached = _outputs[pData];
+        if ( cached.isValid )
+            return cached.values;
+
+        const int numExamples = pData->getNumExamples();
+        const int numClasses = pData->getNumClasses();
+
+        vector<AlphaReal>& hypOutputs = cached.values;
+        hypOutputs.resize( (size_t)numExamples * numClasses );
+
+        const int numThreads = nor_utils::getNumThreads();
+
+#pragma omp parallel for num_threads(numThreads) if (numThreads > 1) schedule(static)
+        for (int i = 0; i < numExamples; ++i)
+        {
+            const vector<Label>& labels = pData->getLabels(i);
+            AlphaReal* hx = &hypOutputs[ (size_t)i * numClasses ];
+            vector<Label>::const_iterator lIt;
+
+            for (lIt = labels.begin(); lIt != labels.end(); ++lIt )
+                hx[lIt->idx] = _pWeakHypothesis->classify(pData, i, lIt->idx); // h_l(x_i)
+        }
+
+        cached.isValid = true;
+        return hypOutputs;
+    }
+
+    // -------------------------------------------------------------------------
+
+} // end of namespace MultiBoost
@@ -0,0 +1,124 @@
+/*
+ *
+ *    MultiBoost - Multi-purpose boosting package
+ *
+ *    Copyright (C)        AppStat group
+ *                         Laboratoire de l'Accelerateur Lineaire
+ *                         Universite Paris-Sud, 11, CNRS
+ *
+ *    This file is part of the MultiBoost library
+ *
+ *    This library is free software; you can redistribute it 
+ *    and/or modify it under the terms of the GNU General Public
+ *    License as published by the Free Software Foundation
+ *    version 2.1 of the License.
+ *
+ *    This library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *    General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public
+ *    License along with this library; if not, write to the Free Software
+ *    Foundation, Inc., 51 Franklin St, 5th Floor, Boston, MA 02110-1301 USA
+ *
+ *    Contact: : multiboost@googlegroups.com
+ *
+ *    For more information and up-to-date version, please visit
+ *        
+ *                       http://www.multiboost.org/
+ *
+ */
+
+
+
+/**
+ * \file HypothesisOutputCache.h The outputs of the current weak hypothesis on the datasets.
+ */
+
+#ifndef __HYPOTHESIS_OUTPUT_CACHE_H
+#define __HYPOTHESIS_OUTPUT_CACHE_H
+
+#include "Defaults.h" // for AlphaReal
+#include "IO/InputData.h"
+
+#include <vector>
+#include <map>
+
+using namespace std;
+
+//////////////////////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace MultiBoost {
+
+    // forward declaration to avoid an include
+    class BaseLearner;
+
+    /**
+     * Keeps the outputs \f$h_\ell(x_i)\f$ of the weak hypothesis of the current
+     * boosting iteration, one flat numExamples x numClasses buffer (row-major) per
+     * dataset. A buffer is filled the first time it is asked for, so within an iteration
+     * the hypothesis is classified once per dataset, however many consumers (the
+     * re-weighting, the tables and the metrics of OutputInfo) read it.
+     * Only the entries of the labels an example has are set.
+     * \remark The cache does not own the hypothesis, and it cannot know when the 
+     * hypothesis or the data change: setHypothesis() must be called at each iteration.
+     * \date 16/10/2026
+     */
+    class HypothesisOutputCache
+    {
+    public:
+
+        /**
+         * The constructor. The cache is empty.
+         * \date 16/10/2026
+         */
+        HypothesisOutputCache() : _pWeakHypothesis(NULL) {}
+
+        /**
+         * Start a new iteration: the outputs of the previous hypothesis are dropped
+         * (the buffers are kept to be reused).
+         * \param pWeakHypothesis The weak hypothesis of the iteration.
+         * \date 16/10/2026
+         */
+        void setHypothesis(BaseLearner* pWeakHypothesis);
+
+        //! The hypothesis whose outputs are cached.
+        BaseLearner* getHypothesis() const { return _pWeakHypothesis; }
+
+        /**
+         * Get the outputs of the current hypothesis on the data, classifying the
+         * examples (in parallel) if it has not been done yet in this iteration.
+         * \param pData The data.
+         * \return The numExamples x numClasses buffer of the outputs.
+         * \date 16/10/2026
+         */
+        const vector<AlphaReal>& getOutputs(InputData* pData);
+
+        /**
+         * Drop everything, the buffers included.
+         * \date 16/10/2026
+         */
+        void clear() { _pWeakHypothesis = NULL; _outputs.clear(); }
+
+    protected:
+
+        /**
+         * The buffer of a dataset.
+         * \date 16/10/2026
+         */
+        struct CachedOutputs
+        {
+            CachedOutputs() : isValid(false) {}
+            bool isValid; //!< Do the values belong to the current hypothesis?
+            vector<AlphaReal> values; //!< The outputs (numExamples x numClasses).
+        };
+
+        BaseLearner* _pWeakHypothesis; //!< The current hypothesis.
+        map<InputData*, CachedOutputs> _outputs; //!< The outputs per dataset.
+    };
+
+} // end of namespace MultiBoost
+
+#endif // __HYPOTHESIS_OUTPUT_CACHE_H
@@ -53,6 +53,10 @@
 namespace MultiBoost {
         
     // ------------------------------------------------------------------------
+
+    unsigned long InputData::_lastVersion = 0;
+
+    // ------------------------------------------------------------------------
     
     
     void InputData::addExample( Example example ) { 
@@ -69,27 +73,55 @@ namespace MultiBoost {
             }
         }
         
+        // the new example comes after the examples in use, even when a subset is selected
         this->_indirectIndices.push_back(exampleIndex);
-        this->_rawIndices[exampleIndex] = this->_numExamples;
+        this->_indirectIndices[this->_numExamples] = exampleIndex;
+        this->_rawIndices.push_back(this->_numExamples);
         
         this->_numExamples++;
         
         //why shouldn't we do the same direct update of _subset in loadIndexSet() ?
         _subset.push_back(example);
+
+        updateVersion();
         
         //otherwise : _subsetAlreadyComputed = false;
     }
         
+    // ------------------------------------------------------------------------
+
+    void InputData::copyHeader( const InputData* pData ) {
+        _hasExampleName = pData->_hasExampleName;
+        _classInLastColumn = pData->_classInLastColumn;
+
+        _pData->copyHeader( *pData->_pData );
+
+        _numExamples = 0;
+        _indirectIndices.clear();
+        _rawIndices.clear();
+        _subset.clear();
+        _nExamplesPerClass.assign( _pData->getNumClasses(), 0 );
+        _subsetAlreadyComputed = true;
+
+        updateVersion();
+    }
+        
     // ------------------------------------------------------------------------
         
     int     InputData::loadIndexSet( set< int > ind ) {
+        return loadIndexSet( vector<int>( ind.begin(), ind.end() ) );
+    }
+
+    // ------------------------------------------------------------------------
+
+    int     InputData::loadIndexSet( const vector< int >& ind ) {
         int i = 0;
         //upload the indirection
         for (int j = 0; j < this->_rawIndices.size(); j++) this->_rawIndices[j] = -1;
 
         map<int, int> tmpPointsPerClass;
                 
-        for( set< int >::iterator it = ind.begin(); it != ind.end(); it++ ) {
+        for( vector< int >::const_iterator it = ind.begin(); it != ind.end(); it++ ) {
             this->_indirectIndices[i] = *it;
             this->_rawIndices[*it] = i;
                         
@@ -121,6 +153,7 @@ namespace MultiBoost {
         this->_numExamples = (int)ind.size();
         
         _subsetAlreadyComputed = false;
+        updateVersion();
         
         return 0;
     }
@@ -140,6 +173,7 @@ namespace MultiBoost {
         _nExamplesPerClass = this->_pData->getExamplesPerClass();
         
         _subsetAlreadyComputed = false;
+        updateVersion();
     }
         
 } // end of namespace MultiBoost
@@ -99,7 +99,7 @@ namespace MultiBoost {
          * The constructor. It does noting but initializing some variables.
          * \date 12/11/2005
          */
-    InputData() : _hasExampleName(false), _subsetAlreadyComputed(false), _classInLastColumn(false), _numExamples(0) { _pData = new RawData(); }
+    InputData() : _hasExampleName(false), _subsetAlreadyComputed(false), _classInLastColumn(false), _numExamples(0) { _pData = new RawData(); updateVersion(); }
                 
                 
         virtual int getOrderBasedOnRawIndex( int rawIndex ) {
@@ -157,6 +157,7 @@ namespace MultiBoost {
                         
             _subsetAlreadyComputed = true;
             _nExamplesPerClass = _pData->getExamplesPerClass();                             
+            updateVersion();
         }
                 
         /**
@@ -191,6 +192,9 @@ namespace MultiBoost {
 
         FeatureReal getValue(int idx, int columnIdx) const 
         { return _pData->getValue( _indirectIndices[idx], columnIdx); }
+
+        //! The representation of the values (DR_DENSE or DR_SPARSE).
+        eDataRep getDataRep() const { return _pData->getDataRep(); }
         //////////////////////////////////////////////////////////////////////////
         //////////////////////////////////////////////////////////////////////////
                 
@@ -262,6 +266,35 @@ namespace MultiBoost {
 
         vector<FeatureReal>& getMostFrequentValuePerFeature() { return _pData->getMostFrequentValuePerFeature(); }
 
+        /**
+         * Get the contiguous y * weight values of the labels of the example \a idx.
+         * \param idx The index of the example.
+         * \return The row of numClasses values, or NULL if the weighted label matrix
+         * is not maintained for this data (then use getLabels()).
+         * \see RawData::updateWeightedLabels
+         * \date 16/10/2026
+         */
+        inline const AlphaReal* getWeightedLabels(int idx) const
+        { return static_cast<const RawData*>(_pData)->getWeightedLabels( _indirectIndices[idx] ); }
+        inline       AlphaReal* getWeightedLabels(int idx)
+        { return _pData->getWeightedLabels( _indirectIndices[idx] ); }
+
+        //! Rebuild the weighted label matrix from the weights of all the examples.
+        void updateWeightedLabels() { _pData->updateWeightedLabels(); }
+        //! Drop the weighted label matrix.
+        void clearWeightedLabels() { _pData->clearWeightedLabels(); }
+        /**
+         * Set up an empty data set with the same header (classes, attributes)
+         * as another loaded one, without reading any file.
+         * \param pData The loaded data whose header is copied.
+         * \see RawData::copyHeader
+         * \date 16/10/2026
+         */
+        void copyHeader( const InputData* pData );
+
+        //! Is the weighted label matrix available?
+        bool hasWeightedLabels() const { return _pData->hasWeightedLabels(); }
+
                 
         /**
          * Set the indices of subset we use
@@ -269,6 +302,15 @@ namespace MultiBoost {
          * \data 12/10/2009
          */
         virtual int             loadIndexSet( set< int > ind ); 
+
+
+        /**
+         * Set the indices of subset we use.
+         * \param ind The indices, sorted and without duplicates.
+         * \see loadIndexSet(set<int>)
+         * \date 16/10/2026
+         */
+        int loadIndexSet( const vector< int >& ind );
         //TODO: comment         
         virtual void getIndexSet( set< int >& ind )
         {
@@ -314,6 +356,15 @@ namespace MultiBoost {
         }
         //TODO: comment        
         void addExample( Example example );
+
+        /**
+         * Return the version of the examples in use. It changes every time the
+         * index set or the raw data changes (loadIndexSet(), clearIndexSet(),
+         * addExample(), load()), and it is unique over all the InputData
+         * objects, so it can be used to validate anything computed on the data.
+         * \date 16/10/2026
+         */
+        unsigned long getVersion() const { return _version; }
                 
                 
         virtual ~InputData()
@@ -322,12 +373,24 @@ namespace MultiBoost {
         }
                 
     protected:
+        /**
+         * Give a new version to the data. It must be called by every function
+         * that changes the examples in use.
+         * \see getVersion()
+         * \date 16/10/2026
+         */
+        void updateVersion() { _version = ++_lastVersion; }
+
         int           _numExamples;  //!<  The number of examples.
         vector<int>   _nExamplesPerClass;   //!< The number of examples per class.
                 
         RawData*                _pData;
                 
         vector<Example> _subset;
+
+    private:
+        unsigned long _version; //!< The version of the examples in use.
+        static unsigned long _lastVersion; //!< The last version given to an InputData object.
     };
         
 } // end of namespace MultiBoost
@@ -32,10 +32,13 @@
 
 
 #include <limits>
+#include <sstream>
+#include <cctype> // for isdigit
 
 #include <math.h>
 
 #include "OutputInfo.h"
+#include "HypothesisOutputCache.h"
 #include "NameMap.h"
 #include "WeakLearners/BaseLearner.h"
 #include "Others/Example.h"
@@ -48,8 +51,10 @@ namespace MultiBoost {
     OutputInfo::OutputInfo(const nor_utils::Args& args, bool customUpdate, const string & clArg)
     {
         _customTablesUpdate = customUpdate;
+        _pHypOutputCache = NULL;
      
         _historyStartingIteration = 0;
+        _currentIteration = 0;
         _outputList.clear();
         
         string outputInfoFile;
@@ -176,14 +181,25 @@ namespace MultiBoost {
     
     void OutputInfo::getOutputListFromString(const string& outList,  const nor_utils::Args* args)
     {
-        for (int i = 0; i < outList.size(); i+=3) 
+        // the codes are three characters long, each can be followed by the period 
+        // (in iterations) of its computation, eg. e01auc10
+        for (int i = 0; i < (int)outList.size(); ) 
         {
             string outputName = outList.substr(i, 3);
+            i += 3;
+
+            int period = 0;
+            while ( i < (int)outList.size() && isdigit(outList[i]) ) 
+                period = period * 10 + (outList[i++] - '0');
+
             if (_outputList.find(outputName) == _outputList.end())
             {
                 BaseOutputInfoType* t = BaseOutputInfoType::createOutput(outputName, args);
                 if ( t )  _outputList[outputName] = t;
             }
+
+            if ( period > 0 && _outputList.find(outputName) != _outputList.end() )
+                _outputList[outputName]->setPeriod(period);
         }
         
         if ( _outputList.size() == 0 )
@@ -231,8 +247,17 @@ namespace MultiBoost {
         
     void OutputInfo::outputCustom(InputData* pData, BaseLearner* pWeakHypothesis)
     {
+        // the outputs of the hypothesis, if the learner shares them
+        const AlphaReal* pHypOutputs = NULL;
+        if ( _pHypOutputCache && pWeakHypothesis && _pHypOutputCache->getHypothesis() == pWeakHypothesis )
+        {
+            const vector<AlphaReal>& hypOutputs = _pHypOutputCache->getOutputs(pData);
+            if ( !hypOutputs.empty() )
+                pHypOutputs = &hypOutputs[0];
+        }
+
         if (! _customTablesUpdate) {
-            updateTables(pData, pWeakHypothesis);
+            updateTables(pData, pWeakHypothesis, pHypOutputs);
         }
         
         size_t numOutput = _outputList.size();
@@ -242,38 +267,77 @@ namespace MultiBoost {
         OutInfIt outputIt;
         int i = 0;
         for (outputIt = _outputList.begin(); outputIt != _outputList.end(); ++outputIt, ++i) {
-            outputIt->second->computeAndOutput(_outStream, pData, _gTableMap, _margins, _alphaSums, pWeakHypothesis);
+            BaseOutputInfoType* pOutput = outputIt->second;
+            const int period = pOutput->getPeriod();
+
+            if ( period == 1 ) {
+                pOutput->computeAndOutput(_outStream, pData, _gTableMap, _margins, _alphaSums, pWeakHypothesis, pHypOutputs);
+            }
+            else if ( (_currentIteration % period) != 0 && pOutput->outputLast(_outStream, pData) ) {
+                // skipped, the last values have been repeated
+            }
+            else {
+                // computed, and kept to be repeated until the next computation
+                ostringstream outputSs;
+                outputSs.copyfmt(_outStream);
+                pOutput->computeAndOutput(outputSs, pData, _gTableMap, _margins, _alphaSums, pWeakHypothesis, pHypOutputs);
+                pOutput->setLastOutput(pData, outputSs.str());
+                _outStream << outputSs.str();
+            }
+
             if ((i+1) != numOutput) _outStream << OUTPUT_SEPARATOR;
         } 
         
     }
     
     // -------------------------------------------------------------------------
-    void OutputInfo::updateTables(InputData* pData, BaseLearner* pWeakHypothesis)
+    void OutputInfo::updateTables(InputData* pData, BaseLearner* pWeakHypothesis, 
+                                  const AlphaReal* pHypOutputs)
     {
         const int numExamples = pData->getNumExamples();
+        const int numClasses = pData->getNumClasses();
+        const AlphaReal alpha = pWeakHypothesis->getAlpha();
                 
         table& g = _gTableMap[pData];
         table& margins = _margins[pData];
         
-        vector<Label>::const_iterator lIt;
+        const int numThreads = nor_utils::getNumThreads();
                 
         // Building the strong learner (discriminant function)
+        // the rows are independent
+#pragma omp parallel for num_threads(numThreads) if (numThreads > 1) schedule(static)
         for (int i = 0; i < numExamples; ++i)
         {
             const vector<Label>& labels = pData->getLabels(i);
+            const AlphaReal* hypOutputs = pHypOutputs ? pHypOutputs + (size_t)i * numClasses : NULL;
+            AlphaReal* gRow = g[i];
+            AlphaReal* marginsRow = margins[i];
+
+            if ( hypOutputs && isDenseRow(labels, numClasses) )
+            {
+                // all the labels, in order: straight loops over the rows
+                for (int l = 0; l < numClasses; ++l)
+                    gRow[l] += alpha * hypOutputs[l];
+
+                for (int l = 0; l < numClasses; ++l)
+                    marginsRow[l] += ( alpha * hypOutputs[l] ) * labels[l].y;
+
+                continue;
+            }
+
+            vector<Label>::const_iterator lIt;
                         
             for (lIt = labels.begin(); lIt != labels.end(); ++lIt )
             {
-                AlphaReal hx = pWeakHypothesis->getAlpha() * // alpha
-                    pWeakHypothesis->classify(pData, i, lIt->idx);
+                AlphaReal hx = alpha * // alpha
+                    ( hypOutputs ? hypOutputs[lIt->idx] : pWeakHypothesis->classify(pData, i, lIt->idx) );
                 
                 // update the posteriors table
-                g[i][lIt->idx] += hx ;
+                gRow[lIt->idx] += hx ;
                 
                 // update the margins table
                 // FIXME: redundancy 
-                margins[i][lIt->idx] += hx * lIt->y ;
+                marginsRow[lIt->idx] += hx * lIt->y ;
             }
         }
         
@@ -318,6 +382,7 @@ namespace MultiBoost {
     void OutputInfo::outputIteration(int t)
     { 
         _outStream << (t+1) << OUTPUT_SEPARATOR; // just output t
+        _currentIteration = t;
     }
     // -------------------------------------------------------------------------
         
@@ -337,30 +402,8 @@ namespace MultiBoost {
         int numClasses = pData->getNumClasses();
         const int numExamples = pData->getNumExamples();
         
-        table& g = _gTableMap[pData];
-        
-        g.resize(numExamples);
-        
-        for ( int i = 0; i < numExamples; ++i )
-        {
-            //if (pData->isSparseLabel())
-            //   numClasses = pData->getNumNonzeroLabels(i);
-            g[i].resize(numClasses);
-            for (int l = 0; l < numClasses; ++l)
-                g[i][l] = 0;
-        }
-        
-        table& margins = _margins[pData];
-        margins.resize(numExamples);
-        
-        for ( int i = 0; i < numExamples; ++i )
-        {
-            //if (pData->isSparseLabel())
-            //   numClasses = pData->getNumNonzeroLabels(i);
-            margins[i].resize(numClasses);
-            for (int l = 0; l < numClasses; ++l)
-                margins[i][l] = 0;
-        }
+        _gTableMap[pData].reset(numExamples, numClasses);
+        _margins[pData].reset(numExamples, numClasses);
         
         _alphaSums[pData] = 0;
 
@@ -384,6 +427,7 @@ namespace MultiBoost {
         if ( type.compare("mar") == 0 ) return new MarginsOutput();
         if ( type.compare("edg") == 0 ) return new EdgeOutput();
         if ( type.compare("auc") == 0 ) return new AUCOutput();
+        if ( type.compare("auh") == 0 ) return new AUCOutput(AUCOutput::DEFAULT_NUM_BINS); // approximate AUC
         if ( type.compare("roc") == 0 ) return new TPRFPROutput();
         if ( type.compare("sca") == 0 ) return new SoftCascadeOutput(*args); 
         if ( type.compare("pos") == 0 ) return new PosteriorsOutput();
@@ -402,7 +446,8 @@ namespace MultiBoost {
                                                   map<InputData*, table>& gTableMap, 
                                                   map<InputData*, table>& marginsTableMap, 
                                                   map<InputData*, AlphaReal>& alphaSums,
-                                                  BaseLearner* pWeakHypothesis)
+                                                  BaseLearner* pWeakHypothesis,
+                                                  const AlphaReal* pHypOutputs)
     {
         const int numExamples = pData->getNumExamples();
         
@@ -453,7 +498,8 @@ namespace MultiBoost {
                                               map<InputData*, table>& gTableMap, 
                                               map<InputData*, table>& marginsTableMap, 
                                               map<InputData*, AlphaReal>& alphaSums,
-                                              BaseLearner* pWeakHypothesis)
+                                              BaseLearner* pWeakHypothesis,
+                                              const AlphaReal* pHypOutputs)
     {
         const int numExamples = pData->getNumExamples();
         
@@ -504,7 +550,8 @@ namespace MultiBoost {
                                                       map<InputData*, table>& gTableMap, 
                                                       map<InputData*, table>& marginsTableMap, 
                                                       map<InputData*, AlphaReal>& alphaSums,
-                                                      BaseLearner* pWeakHypothesis)
+                                                      BaseLearner* pWeakHypothesis,
+                                                      const AlphaReal* pHypOutputs)
     {
         const int numExamples = pData->getNumExamples();
         
@@ -564,7 +611,8 @@ namespace MultiBoost {
                                               map<InputData*, table>& gTableMap, 
                                               map<InputData*, table>& marginsTableMap, 
                                               map<InputData*, AlphaReal>& alphaSums,
-                                              BaseLearner* pWeakHypothesis)
+                                              BaseLearner* pWeakHypothesis,
+                                              const AlphaReal* pHypOutputs)
     {
         const int numExamples = pData->getNumExamples();
         const int numClasses = pData->getNumClasses();
@@ -598,7 +646,8 @@ namespace MultiBoost {
                                                       map<InputData*, table>& gTableMap, 
                                                       map<InputData*, table>& marginsTableMap, 
                                                       map<InputData*, AlphaReal>& alphaSums,
-                                                      BaseLearner* pWeakHypothesis)
+                                                      BaseLearner* pWeakHypothesis,
+                                                      const AlphaReal* pHypOutputs)
     {
         const int numExamples = pData->getNumExamples();
         
@@ -636,7 +685,8 @@ namespace MultiBoost {
                                                map<InputData*, table>& gTableMap, 
                                                map<InputData*, table>& marginsTableMap, 
                                                map<InputData*, AlphaReal>& alphaSums,
-                                               BaseLearner* pWeakHypothesis)
+                                               BaseLearner* pWeakHypothesis,
+                                               const AlphaReal* pHypOutputs)
     {
         int numClasses = pData->getNumClasses();
         const int numExamples = pData->getNumExamples();
@@ -695,7 +745,8 @@ namespace MultiBoost {
                                                map<InputData*, table>& gTableMap, 
                                                map<InputData*, table>& marginsTableMap, 
                                                map<InputData*, AlphaReal>& alphaSums,
-                                               BaseLearner* pWeakHypothesis)
+                                               BaseLearner* pWeakHypothesis,
+                                               const AlphaReal* pHypOutputs)
     {
         
         
@@ -774,7 +825,8 @@ namespace MultiBoost {
                                     map<InputData*, table>& gTableMap, 
                                     map<InputData*, table>& marginsTableMap,
                                     map<InputData*, AlphaReal>& alphaSums,
-                                    BaseLearner* pWeakHypothesis)
+                                    BaseLearner* pWeakHypothesis,
+                                    const AlphaReal* pHypOutputs)
     {
         const int numExamples = pData->getNumExamples();
                 
@@ -823,7 +875,8 @@ namespace MultiBoost {
                                          map<InputData*, table>& gTableMap, 
                                          map<InputData*, table>& marginsTableMap, 
                                          map<InputData*, AlphaReal>& alphaSums,
-                                         BaseLearner* pWeakHypothesis)
+                                         BaseLearner* pWeakHypothesis,
+                                         const AlphaReal* pHypOutputs)
     {
         const int numExamples = pData->getNumExamples();
                 
@@ -858,9 +911,11 @@ namespace MultiBoost {
                                       map<InputData*, table>& gTableMap, 
                                       map<InputData*, table>& marginsTableMap, 
                                       map<InputData*, AlphaReal>& alphaSums,
-                                      BaseLearner* pWeakHypothesis)
+                                      BaseLearner* pWeakHypothesis,
+                                      const AlphaReal* pHypOutputs)
     {
         const int numExamples = pData->getNumExamples();
+        const int numClasses = pData->getNumClasses();
                 
         AlphaReal gamma = 0; // the edge
         // for each example
@@ -868,10 +923,11 @@ namespace MultiBoost {
         {
             vector<Label>& labels = pData->getLabels(i);
             vector<Label>::iterator lIt;
+            const AlphaReal* hypOutputs = pHypOutputs ? pHypOutputs + (size_t)i * numClasses : NULL;
                         
             for (lIt = labels.begin(); lIt != labels.end(); ++lIt )
             {
-                AlphaReal hy = pWeakHypothesis->classify(pData, i, lIt->idx) * // h_l(x_i)
+                AlphaReal hy = ( hypOutputs ? hypOutputs[lIt->idx] : pWeakHypothesis->classify(pData, i, lIt->idx) ) * // h_l(x_i)
                     lIt->y;
                 gamma += lIt->weight * hy;
             }
@@ -890,18 +946,17 @@ namespace MultiBoost {
                                      map<InputData*, table>& gTableMap, 
                                      map<InputData*, table>& marginsTableMap, 
                                      map<InputData*, AlphaReal>& alphaSums,
-                                     BaseLearner* pWeakHypothesis)
+                                     BaseLearner* pWeakHypothesis,
+                                     const AlphaReal* pHypOutputs)
     {
         const int numClasses = pData->getNumClasses();
         const int numExamples = pData->getNumExamples();
                 
-        vector< int > fp( numClasses );   
-        fill( fp.begin(), fp.end(), 0 );
-                
         table& g = gTableMap[pData];
-        vector<Label>::const_iterator lIt;
                 
-        vector< pair< int, AlphaReal > > data( numExamples );
+        // the buffers are kept from one call to the next
+        vector< pair< int, AlphaReal > >& data = _rocData;
+        data.resize( numExamples );
                 
         vector< double > ROCscores( numClasses );
         fill( ROCscores.begin(), ROCscores.end(), 0.0 );
@@ -910,12 +965,9 @@ namespace MultiBoost {
         for( int i=0; i < numClasses; i++ ) {
             if ( 0 < pData->getNumExamplesPerClass( i ) ) {
                                 
-                //fill( labels.begin(), labels.end(), 0 );
                 AlphaReal mn = numeric_limits< AlphaReal >::max();
                 AlphaReal mx = numeric_limits< AlphaReal >::min();
                                 
-                                
-                                
                 for( int j = 0; j < numExamples; j++ ) {
                     data[j].second = g[j][i];
                                         
@@ -927,14 +979,32 @@ namespace MultiBoost {
                 }
                                 
                 mx -= mn;
-                if ( mx > numeric_limits<AlphaReal>::epsilon() ) {
+                const bool isNormalized = mx > numeric_limits<AlphaReal>::epsilon();
+                if ( isNormalized ) {
                     for( int j = 0; j < numExamples; j++ ) {
                         data[j].second -= mn;
                         data[j].second /= mx; 
                     }
                 }
                                 
-                ROCscores[i] = nor_utils::getROC( data );
+                if ( _numBins > 0 && isNormalized ) {
+                    // the scores are in [0,1]
+                    _posCounts.assign( _numBins, 0 );
+                    _negCounts.assign( _numBins, 0 );
+                    for( int j = 0; j < numExamples; j++ ) {
+                        int bin = static_cast<int>( data[j].second * _numBins );
+                        if ( bin >= _numBins ) bin = _numBins - 1;
+                        if ( bin < 0 ) bin = 0;
+
+                        if ( data[j].first == 1 ) _posCounts[bin]++;
+                        else _negCounts[bin]++;
+                    }
+                    ROCscores[i] = nor_utils::getHistogramROC( _posCounts, _negCounts );
+                }
+                else {
+                    // exact, or all the scores are (nearly) equal
+                    ROCscores[i] = nor_utils::getROC( data );
+                }
             } else {
                 ROCscores[i] = 0.0;
             }
@@ -959,7 +1029,8 @@ namespace MultiBoost {
                                         map<InputData*, table>& gTableMap, 
                                         map<InputData*, table>& marginsTableMap, 
                                         map<InputData*, AlphaReal>& alphaSums,
-                                        BaseLearner* pWeakHypothesis)
+                                        BaseLearner* pWeakHypothesis,
+                                        const AlphaReal* pHypOutputs)
 
     {
         int numClasses = pData->getNumClasses();
@@ -1051,7 +1122,8 @@ namespace MultiBoost {
                                              map<InputData*, table>& gTableMap, 
                                              map<InputData*, table>& marginsTableMap, 
                                              map<InputData*, AlphaReal>& alphaSums,
-                                             BaseLearner* pWeakHypothesis) {
+                                             BaseLearner* pWeakHypothesis,
+                                             const AlphaReal* pHypOutputs) {
         set<int> indices ;
         pData->getIndexSet(indices);
         pData->clearIndexSet();
@@ -1063,17 +1135,12 @@ namespace MultiBoost {
         //resize in case of bootstrapping
         const int newDimension = pData->getNumExamples();
         const int numClasses = pData->getNumClasses();
-        const int oldDimension = (int)g.size();
         
-        assert(newDimension >= oldDimension);
-        g.resize(newDimension);
+        assert(newDimension >= (int)g.size());
+        g.resize(newDimension, numClasses);
         
         _forecast.resize(newDimension);
         
-        for (int i = oldDimension; i < newDimension; ++i) {
-            g[i].resize(numClasses, 0.);
-        }
-        
         if (pWeakHypothesis != NULL) {
             _calibratedWeakHypotheses.push_back(pWeakHypothesis);
         }
@@ -1185,7 +1252,8 @@ namespace MultiBoost {
                                             map<InputData*, table>& gTableMap, 
                                             map<InputData*, table>& marginsTableMap, 
                                             map<InputData*, AlphaReal>& alphaSums,
-                                            BaseLearner* pWeakHypothesis)
+                                            BaseLearner* pWeakHypothesis,
+                                            const AlphaReal* pHypOutputs)
     {
         const int numExamples = pData->getNumExamples();
         
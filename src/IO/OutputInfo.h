@@ -53,6 +53,7 @@ namespace MultiBoost {
     // forward declaration to avoid an include
     class BaseLearner;
     class BaseOutputInfoType;
+    class HypothesisOutputCache;
     
     /**
      * A table representing the votes for each example.
@@ -62,9 +63,67 @@ namespace MultiBoost {
      Ex_2:  Class 0, Class 1, Class 2, .. , Class k
      ..
      Ex_n:  Class 0, Class 1, Class 2, .. , Class k \endverbatim
+     * The rows are stored one after the other in a single vector (one allocation per
+     * dataset), and table[i] returns the pointer to the row of the example i, so 
+     * the elements are accessed as table[i][l].
      * \date 16/11/2005
      */
-    typedef vector< vector<AlphaReal> > table;
+    class ScoreTable
+    {
+    public:
+
+        ScoreTable() : _numRows(0), _numColumns(0) {}
+
+        /**
+         * Set the size of the table, and reset all the values to zero.
+         * \param numRows The number of examples.
+         * \param numColumns The number of classes.
+         * \date 16/10/2026
+         */
+        void reset(const int numRows, const int numColumns)
+        {
+            _numRows = numRows;
+            _numColumns = numColumns;
+            _values.assign( (size_t)numRows * numColumns, 0 );
+        }
+
+        /**
+         * Change the number of rows, keeping the values of the existing rows.
+         * The new rows are set to zero.
+         * \param numRows The new number of examples.
+         * \param numColumns The number of classes. If it is different from the current
+         * one, the table is reset.
+         * \date 16/10/2026
+         */
+        void resize(const int numRows, const int numColumns)
+        {
+            if ( numColumns != _numColumns ) 
+            {
+                reset(numRows, numColumns);
+                return;
+            }
+            _numRows = numRows;
+            _values.resize( (size_t)numRows * numColumns, 0 );
+        }
+
+        int size() const { return _numRows; } //!< The number of rows (examples).
+        int getNumColumns() const { return _numColumns; } //!< The number of columns (classes).
+
+        //! The row of the example \a i.
+        AlphaReal*       operator[](const int i)       { return &_values[ (size_t)i * _numColumns ]; }
+        const AlphaReal* operator[](const int i) const { return &_values[ (size_t)i * _numColumns ]; }
+
+        //! All the values, row by row.
+        AlphaReal*       getValues()       { return _values.empty() ? NULL : &_values[0]; }
+        const AlphaReal* getValues() const { return _values.empty() ? NULL : &_values[0]; }
+
+    private:
+        int _numRows;
+        int _numColumns;
+        vector<AlphaReal> _values; //!< The values, row by row.
+    };
+
+    typedef ScoreTable table;
     typedef map<string, BaseOutputInfoType*>::iterator OutInfIt;
     
 //    template<typename T>
@@ -151,9 +210,21 @@ namespace MultiBoost {
          * the command line or directly through the constructor
          * \param pData The input data.
          * \param pWeakHypothesis The current weak hypothesis.
+         * \remark If a HypothesisOutputCache is set and holds pWeakHypothesis, its outputs
+         * are used instead of classifying the data again.
          * \date 17/06/2011
          */
         void outputCustom(InputData* pData, BaseLearner* pWeakHypothesis = 0);
+
+        /**
+         * Share the outputs of the weak hypotheses with the learner. The tables
+         * and the outputs read the outputs of the current hypothesis from the cache
+         * instead of classifying the data themselves.
+         * \param pCache The cache, which is owned by the caller, or NULL to classify
+         * in OutputInfo as before.
+         * \date 16/10/2026
+         */
+        void setHypothesisOutputCache(HypothesisOutputCache* pCache) { _pHypOutputCache = pCache; }
                 
         /**
          * End of line in the file stream.
@@ -186,22 +257,18 @@ namespace MultiBoost {
             return g;
         }
                 
-        void setTable( InputData* pData, table& tmpTable )
+        void setTable( InputData* pData, const vector< vector<AlphaReal> >& tmpTable )
         {
             table& g = _gTableMap[pData];
             
             // in case the dimensions are different
             const int newDimension = (int)tmpTable.size();
             const int numClasses = pData->getNumClasses();
-            const int oldDimension = (int)g.size();
             
-            g.resize(newDimension);
-            for (int i = oldDimension; i < newDimension; ++i) {
-                g[i].resize(numClasses, 0.);
-            }
+            g.resize(newDimension, numClasses);
 
             for( int i=0; i<g.size(); i++ )
-                copy( tmpTable[i].begin(), tmpTable[i].end(), g[i].begin() ); 
+                copy( tmpTable[i].begin(), tmpTable[i].end(), g[i] ); 
         }
                 
         table& getMargins( InputData* pData )
@@ -212,9 +279,27 @@ namespace MultiBoost {
         
         /*
          * Updates the G and Margin tables and alphaSums vector
+         * \param pHypOutputs The outputs of the weak hypothesis on pData, if they are
+         * already computed, so that it is not classified again. Otherwise NULL.
          * \date 17/06/2011
          */
-        void updateTables(InputData* pData, BaseLearner* pWeakHypothesis);
+        void updateTables(InputData* pData, BaseLearner* pWeakHypothesis, 
+                          const AlphaReal* pHypOutputs = NULL);
+
+        /**
+         * Checks if an example has all the labels, in the order of their indices,
+         * so that its row of the tables can be updated without indirection.
+         * \param labels The labels of the example.
+         * \param numClasses The number of classes.
+         * \date 16/10/2026
+         */
+        static bool isDenseRow(const vector<Label>& labels, const int numClasses)
+        {
+            if ( static_cast<int>(labels.size()) != numClasses ) return false;
+            for (int l = 0; l < numClasses; ++l)
+                if ( labels[l].idx != l ) return false;
+            return true;
+        }
         
         /**
          * Calls the updateSpecificInfo method for each OutputInfoType subclass.
@@ -316,6 +401,8 @@ namespace MultiBoost {
          * \date 04/07/2011
          */
         bool _customTablesUpdate;
+
+        HypothesisOutputCache* _pHypOutputCache; //!< The outputs of the current hypothesis shared with the learner, or NULL.
         
         /**
          * The header output stream
@@ -323,6 +410,8 @@ namespace MultiBoost {
         fstream _headerOutStream;
       
         unsigned int _historyStartingIteration; //to handle fastResume case
+
+        int _currentIteration; //!< The iteration of the current line (see outputIteration()).
     };
     
     //////////////////////////////////////////////////////////////////////////////////////////////
@@ -344,17 +433,57 @@ namespace MultiBoost {
     {
     protected:
         map<InputData*, vector<AlphaReal> >       _outputHistory;
+
+        int _period; //!< The output is computed every _period iterations, and repeated in between.
+        map<InputData*, string> _lastOutput; //!< The last computed output per dataset, if _period > 1.
         
     public:
         
-        BaseOutputInfoType() {};
-        BaseOutputInfoType(const nor_utils::Args& args) {};
+        BaseOutputInfoType() : _period(1) {};
+        BaseOutputInfoType(const nor_utils::Args& args) : _period(1) {};
+
+        /**
+         * Compute the output only every \a period iterations. In between, the last
+         * computed values are output again (and added again to the history).
+         * It is set through the --outputinfo list, by appending the period to the
+         * code of the output (eg. auc10).
+         * \param period The period, 1 (the default) to compute it at every iteration.
+         * \date 16/10/2026
+         */
+        void setPeriod(int period) { _period = period < 1 ? 1 : period; }
+        int getPeriod() const { return _period; }
+
+        /**
+         * Output the values computed at an earlier iteration, when the computation
+         * is skipped (see setPeriod()).
+         * \param outStream The stream where the output is directed to
+         * \param pData The input data.
+         * \return false if nothing has been computed yet on pData.
+         * \date 16/10/2026
+         */
+        bool outputLast(ostream& outStream, InputData* pData)
+        {
+            map<InputData*, string>::const_iterator it = _lastOutput.find(pData);
+            if ( it == _lastOutput.end() ) return false;
+            outStream << it->second;
+            vector<AlphaReal>& history = _outputHistory[pData];
+            if ( !history.empty() ) history.push_back( history.back() );
+            return true;
+        }
+
+        /**
+         * Keep the output computed at this iteration, to be repeated by outputLast().
+         * \date 16/10/2026
+         */
+        void setLastOutput(InputData* pData, const string& output) { _lastOutput[pData] = output; }
         
         /*
           Compute the output it is specialized in and print it.
           * \param outStream The stream where the output is directed to
           * \param pData The input data.
           * \param pWeakHypothesis The current weak hypothesis.
+          * \param pHypOutputs The outputs of pWeakHypothesis on pData (numExamples x numClasses)
+          * if they are available, so that the output need not classify the data again. Otherwise NULL.
           * \see table
           * \see _gTableMap
           * \see _alphaSums
@@ -364,7 +493,8 @@ namespace MultiBoost {
                                       map<InputData*, table>& gTableMap, 
                                       map<InputData*, table>& marginsTableMap, 
                                       map<InputData*, AlphaReal>& alphaSums,
-                                      BaseLearner* pWeakHypothesis = 0) = 0;
+                                      BaseLearner* pWeakHypothesis = 0,
+                                      const AlphaReal* pHypOutputs = NULL) = 0;
         
         /**
          * Print the header 
@@ -456,7 +586,8 @@ namespace MultiBoost {
                               map<InputData*, table>& gTableMap, 
                               map<InputData*, table>& marginsTableMap, 
                               map<InputData*, AlphaReal>& alphaSums,
-                              BaseLearner* pWeakHypothesis = 0);
+                              BaseLearner* pWeakHypothesis = 0,
+                              const AlphaReal* pHypOutputs = NULL);
     };
 
     //////////////////////////////////////////////////////////////////////////////////////////////
@@ -482,7 +613,8 @@ namespace MultiBoost {
                               map<InputData*, table>& gTableMap, 
                               map<InputData*, table>& marginsTableMap, 
                               map<InputData*, AlphaReal>& alphaSums,
-                              BaseLearner* pWeakHypothesis = 0);
+                              BaseLearner* pWeakHypothesis = 0,
+                              const AlphaReal* pHypOutputs = NULL);
     };
         
     //////////////////////////////////////////////////////////////////////////////////////////////
@@ -508,7 +640,8 @@ namespace MultiBoost {
                               map<InputData*, table>& gTableMap, 
                               map<InputData*, table>& marginsTableMap, 
                               map<InputData*, AlphaReal>& alphaSums,
-                              BaseLearner* pWeakHypothesis = 0);
+                              BaseLearner* pWeakHypothesis = 0,
+                              const AlphaReal* pHypOutputs = NULL);
     };
 
     //////////////////////////////////////////////////////////////////////////////////////////////
@@ -534,7 +667,8 @@ namespace MultiBoost {
                               map<InputData*, table>& gTableMap, 
                               map<InputData*, table>& marginsTableMap, 
                               map<InputData*, AlphaReal>& alphaSums,
-                              BaseLearner* pWeakHypothesis = 0);
+                              BaseLearner* pWeakHypothesis = 0,
+                              const AlphaReal* pHypOutputs = NULL);
     };
     //////////////////////////////////////////////////////////////////////////////////////////////
     //////////////////////////////////////////////////////////////////////////////////////////////
@@ -559,7 +693,8 @@ namespace MultiBoost {
                               map<InputData*, table>& gTableMap, 
                               map<InputData*, table>& marginsTableMap, 
                               map<InputData*, AlphaReal>& alphaSums,
-                              BaseLearner* pWeakHypothesis = 0);
+                              BaseLearner* pWeakHypothesis = 0,
+                              const AlphaReal* pHypOutputs = NULL);
     };
         
         
@@ -586,7 +721,8 @@ namespace MultiBoost {
                               map<InputData*, table>& gTableMap, 
                               map<InputData*, table>& marginsTableMap, 
                               map<InputData*, AlphaReal>& alphaSums,
-                              BaseLearner* pWeakHypothesis = 0);
+                              BaseLearner* pWeakHypothesis = 0,
+                              const AlphaReal* pHypOutputs = NULL);
     };
     
     //////////////////////////////////////////////////////////////////////////////////////////////
@@ -621,7 +757,8 @@ namespace MultiBoost {
                               map<InputData*, table>& gTableMap, 
                               map<InputData*, table>& marginsTableMap, 
                               map<InputData*, AlphaReal>& alphaSums,
-                              BaseLearner* pWeakHypothesis = 0);
+                              BaseLearner* pWeakHypothesis = 0,
+                              const AlphaReal* pHypOutputs = NULL);
     };
 
     //////////////////////////////////////////////////////////////////////////////////////////////
@@ -647,7 +784,8 @@ namespace MultiBoost {
                               map<InputData*, table>& gTableMap, 
                               map<InputData*, table>& marginsTableMap, 
                               map<InputData*, AlphaReal>& alphaSums,
-                              BaseLearner* pWeakHypothesis = 0);
+                              BaseLearner* pWeakHypothesis = 0,
+                              const AlphaReal* pHypOutputs = NULL);
     };
 
     //////////////////////////////////////////////////////////////////////////////////////////////
@@ -691,7 +829,8 @@ namespace MultiBoost {
                               map<InputData*, table>& gTableMap, 
                               map<InputData*, table>& marginsTableMap, 
                               map<InputData*, AlphaReal>& alphaSums,
-                              BaseLearner* pWeakHypothesis = 0);
+                              BaseLearner* pWeakHypothesis = 0,
+                              const AlphaReal* pHypOutputs = NULL);
     };
     //////////////////////////////////////////////////////////////////////////////////////////////
     //////////////////////////////////////////////////////////////////////////////////////////////
@@ -720,7 +859,8 @@ namespace MultiBoost {
                               map<InputData*, table>& gTableMap, 
                               map<InputData*, table>& marginsTableMap, 
                               map<InputData*, AlphaReal>& alphaSums,
-                              BaseLearner* pWeakHypothesis = 0);
+                              BaseLearner* pWeakHypothesis = 0,
+                              const AlphaReal* pHypOutputs = NULL);
     };
 
     //////////////////////////////////////////////////////////////////////////////////////////////
@@ -734,19 +874,36 @@ namespace MultiBoost {
     class AUCOutput : public BaseOutputInfoType {
         
     public:
+
+        /**
+         * The constructor.
+         * \param numBins If it is zero, the AUC is computed exactly (nor_utils::getROC).
+         * Otherwise the normalized scores are binned into a histogram of \a numBins bins, 
+         * and the AUC is approximated in linear time (nor_utils::getHistogramROC). The error
+         * is at most the fraction of the (positive, negative) pairs that fall in the same bin.
+         * \date 16/10/2026
+         */
+        explicit AUCOutput(int numBins = 0) : _numBins(numBins) {}
+
+        static const int DEFAULT_NUM_BINS = 1000; //!< The number of bins of the "auh" output.
         
         void outputHeader(ostream& outStream, const NameMap& namemap)
         { 
-            outStream << "auc" ;
+            const char* name = _numBins > 0 ? "auh" : "auc";
+            outStream << name ;
             const int numClasses = namemap.getNumNames();
             for (int i = 0; i < numClasses; ++i ) {
-                outStream << OUTPUT_SEPARATOR << "auc[" << namemap.getNameFromIdx(i) << "]" ;}
+                outStream << OUTPUT_SEPARATOR << name << "[" << namemap.getNameFromIdx(i) << "]" ;}
 
         }
         
         //////////////////////////////////////////////////////////////////////////////////////////////
         
-        void outputDescription(ostream& outStream) { outStream << "auc: Area Under The ROC Curve";} ;
+        void outputDescription(ostream& outStream) 
+        { 
+            if ( _numBins > 0 ) outStream << "auh: Area Under The ROC Curve, approximated with a histogram of the scores";
+            else outStream << "auc: Area Under The ROC Curve";
+        } ;
 
         
         //////////////////////////////////////////////////////////////////////////////////////////////
@@ -755,7 +912,16 @@ namespace MultiBoost {
                               map<InputData*, table>& gTableMap, 
                               map<InputData*, table>& marginsTableMap, 
                               map<InputData*, AlphaReal>& alphaSums,
-                              BaseLearner* pWeakHypothesis = 0);
+                              BaseLearner* pWeakHypothesis = 0,
+                              const AlphaReal* pHypOutputs = NULL);
+
+    protected:
+
+        int _numBins; //!< The number of bins of the histogram, 0 for the exact AUC.
+
+        vector< pair< int, AlphaReal > > _rocData; //!< The (label, score) pairs of a class, reused over the calls.
+        vector< int > _posCounts; //!< The histogram of the positives, reused over the calls.
+        vector< int > _negCounts; //!< The histogram of the negatives, reused over the calls.
     };
 
     //////////////////////////////////////////////////////////////////////////////////////////////
@@ -794,7 +960,8 @@ namespace MultiBoost {
                               map<InputData*, table>& gTableMap, 
                               map<InputData*, table>& marginsTableMap, 
                               map<InputData*, AlphaReal>& alphaSums,
-                              BaseLearner* pWeakHypothesis = 0);
+                              BaseLearner* pWeakHypothesis = 0,
+                              const AlphaReal* pHypOutputs = NULL);
     };
     
     
@@ -855,7 +1022,8 @@ namespace MultiBoost {
                               map<InputData*, table>& gTableMap, 
                               map<InputData*, table>& marginsTableMap, 
                               map<InputData*, AlphaReal>& alphaSums,
-                              BaseLearner* pWeakHypothesis = 0);
+                              BaseLearner* pWeakHypothesis = 0,
+                              const AlphaReal* pHypOutputs = NULL);
         
         
         //////////////////////////////////////////////////////////////////////////////////////////////
@@ -928,7 +1096,8 @@ namespace MultiBoost {
                               map<InputData*, table>& gTableMap, 
                               map<InputData*, table>& marginsTableMap, 
                               map<InputData*, AlphaReal>& alphaSums,
-                              BaseLearner* pWeakHypothesis = 0);
+                              BaseLearner* pWeakHypothesis = 0,
+                              const AlphaReal* pHypOutputs = NULL);
         
         
         //////////////////////////////////////////////////////////////////////////////////////////////
@@ -975,7 +1144,8 @@ namespace MultiBoost {
                               map<InputData*, table>& gTableMap, 
                               map<InputData*, table>& marginsTableMap, 
                               map<InputData*, AlphaReal>& alphaSums,
-                              BaseLearner* pWeakHypothesis = 0);
+                              BaseLearner* pWeakHypothesis = 0,
+                              const AlphaReal* pHypOutputs = NULL);
         
         //////////////////////////////////////////////////////////////////////////////////////////////
         
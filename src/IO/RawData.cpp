@@ -185,6 +185,34 @@ namespace MultiBoost {
                 
         return this;
     }
+
+    // ------------------------------------------------------------------------
+
+    void RawData::copyHeader( const RawData& other )
+    {
+        _hasExampleName = other._hasExampleName;
+        _classInLastColumn = other._classInLastColumn;
+        _sepChars = other._sepChars;
+
+        _numAttributes = other._numAttributes;
+        _numClasses = other._numClasses;
+        _mostFrequentValuePerFeature = other._mostFrequentValuePerFeature;
+        _fileFormat = other._fileFormat;
+        _weightInitType = other._weightInitType;
+        _dataRep = other._dataRep;
+        _labelRep = other._labelRep;
+        _classMap = other._classMap;
+        _enumMaps = other._enumMaps;
+        _attributeNameMap = other._attributeNameMap;
+        _attributeTypes = other._attributeTypes;
+        _headerFile = other._headerFile;
+
+        // no examples
+        _data.clear();
+        _weightedLabels.clear();
+        _numExamples = 0;
+        _nExamplesPerClass.assign( _numClasses, 0 );
+    }
         
         
     // ------------------------------------------------------------------------
@@ -424,6 +452,37 @@ namespace MultiBoost {
                 
     }
         
+    // ------------------------------------------------------------------------
+
+    void RawData::updateWeightedLabels()
+    {
+        _numClasses = _classMap.getNumNames();
+        _weightedLabels.resize( _numExamples * _numClasses );
+
+        for (int i = 0; i < _numExamples; ++i)
+        {
+            const vector<Label>& labels = _data[i].getLabels();
+            AlphaReal* row = &_weightedLabels[ i * _numClasses ];
+
+            if ( static_cast<int>(labels.size()) != _numClasses )
+            {
+                // not a dense label representation
+                _weightedLabels.clear();
+                return;
+            }
+
+            for (int l = 0; l < _numClasses; ++l)
+            {
+                if ( labels[l].idx != l )
+                {
+                    _weightedLabels.clear();
+                    return;
+                }
+                row[l] = labels[l].weight * labels[l].y;
+            }
+        }
+    }
+
     // ------------------------------------------------------------------------
         
     void RawData::outputData()
@@ -122,6 +122,15 @@ namespace MultiBoost {
         virtual RawData* load( const string& fileName, 
                                eInputType inputType = IT_TRAIN, 
                                int verboseLevel = 1);
+
+        /**
+         * Set up an empty data set with the same header as another one: the 
+         * classes, the attributes and the representation of the data, without
+         * reading any file. The examples can then be added with addExample().
+         * \param other The loaded data whose header is copied.
+         * \date 16/10/2026
+         */
+        void copyHeader( const RawData& other );
                 
                 
                 
@@ -173,11 +182,12 @@ namespace MultiBoost {
                 
         /**
          */
-        void clearRawData() { _data.clear(); _numExamples = 0; } 
+        void clearRawData() { _data.clear(); _numExamples = 0; _weightedLabels.clear(); } 
                 
         void addExample( Example example ) { 
             _data.push_back( example ); 
             _numExamples++; 
+            _weightedLabels.clear(); // it would be out of sync
             
             const vector<Label> & labels = example.getLabels();
             vector<Label>::const_iterator lIt;
@@ -246,6 +256,40 @@ namespace MultiBoost {
         vector< int >&  getExamplesPerClass() { return _nExamplesPerClass; }
         vector<FeatureReal>& getMostFrequentValuePerFeature() { return _mostFrequentValuePerFeature; }
 
+        /**
+         * Rebuild the dense matrix of the weighted labels (y * weight) from the labels
+         * of the examples. The matrix is stored row by row (numExamples x numClasses)
+         * in a single contiguous vector, so the edge loops of the stump algorithms can 
+         * stream it instead of going through the label vector of each example.
+         * It is built only if the labels are dense (each example has all the labels,
+         * in the order of their indices), otherwise it is left empty.
+         * \remark The owner of the weights must keep it in sync (see 
+         * AdaBoostMHLearner::updateWeights), or call clearWeightedLabels().
+         * \date 16/10/2026
+         */
+        void updateWeightedLabels();
+
+        /**
+         * Drop the weighted label matrix, the learners will then use the labels.
+         * \date 16/10/2026
+         */
+        void clearWeightedLabels() { _weightedLabels.clear(); }
+
+        //! Is the weighted label matrix available?
+        bool hasWeightedLabels() const { return !_weightedLabels.empty(); }
+
+        /**
+         * Get the row of the weighted label matrix of the example \a idx.
+         * \param idx The (raw) index of the example.
+         * \return The pointer to the numClasses values y * weight of the example, or NULL 
+         * if the matrix is not available.
+         * \date 16/10/2026
+         */
+        inline const AlphaReal* getWeightedLabels(int idx) const
+        { return _weightedLabels.empty() ? NULL : &_weightedLabels[ idx * _numClasses ]; }
+        inline       AlphaReal* getWeightedLabels(int idx)
+        { return _weightedLabels.empty() ? NULL : &_weightedLabels[ idx * _numClasses ]; }
+
         // for debug
         void outputData();
     protected:
@@ -278,6 +322,8 @@ namespace MultiBoost {
         // --------------------------------------------------------------------
                 
         vector<Example> _data; //!< The vector of the data for the examples. 
+
+        vector<AlphaReal> _weightedLabels; //!< The y * weight matrix of the examples (row-major), or empty.
                 
         eDataRep       _dataRep;
         eLabelRep      _labelRep;
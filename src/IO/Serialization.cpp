@@ -32,6 +32,7 @@
 
 
 #include "IO/Serialization.h"
+#include "IO/BinarySerialization.h"
 #include "Utils/Utils.h" // for cmp_nocase
 #include "WeakLearners/BaseLearner.h"
 #include "Bzip2/Bzip2Wrapper.h"
@@ -42,11 +43,18 @@ namespace MultiBoost {
         
     // -----------------------------------------------------------------------
         
-    Serialization::Serialization(const string& shypFileName, bool isComp )
+    Serialization::Serialization(const string& shypFileName, int shypFormat )
+        : _pBinarySerialization(NULL)
     { 
-        _shypFile.open(shypFileName.c_str());
         _shypFileName = shypFileName;
-        _isComp = isComp;
+        _isComp = (shypFormat == SF_XML_BZIP2);
+
+        if ( shypFormat == SF_BINARY ) {
+            _pBinarySerialization = new BinarySerialization(shypFileName);
+            return;
+        }
+
+        _shypFile.open(shypFileName.c_str());
         _bzipFileName = _shypFileName;
         _bzipFileName.append( ".bz2" );
         remove( _bzipFileName.c_str() );
@@ -54,8 +62,20 @@ namespace MultiBoost {
         
     // -----------------------------------------------------------------------
         
-    void Serialization::writeHeader(const string& weakLearnerName)
+    Serialization::~Serialization()
+    {
+        delete _pBinarySerialization;
+    }
+        
+    // -----------------------------------------------------------------------
+        
+    void Serialization::writeHeader(const string& weakLearnerName, InputData* pData)
     {
+        if ( _pBinarySerialization ) {
+            _pBinarySerialization->writeHeader(weakLearnerName, pData);
+            return;
+        }
+
         // print the header
         _shypFile << "<?xml version=\"1.0\"?>" << endl;
         _shypFile << "<multiboost>" << endl;
@@ -81,6 +101,11 @@ namespace MultiBoost {
         
     void Serialization::writeFooter()
     {
+        if ( _pBinarySerialization ) {
+            _pBinarySerialization->writeFooter();
+            return;
+        }
+
         // close tag
         _shypFile << "</multiboost>" << endl;
                 
@@ -166,6 +191,11 @@ namespace MultiBoost {
         
     void  Serialization::appendHypothesis(int iteration, BaseLearner* pWeakHypothesis, int numTab)
     {
+        if ( _pBinarySerialization ) {
+            _pBinarySerialization->appendHypothesis(iteration, pWeakHypothesis);
+            return;
+        }
+
         // just for readability
         string shiftTab = getTabs(numTab);
         
@@ -266,6 +296,34 @@ namespace MultiBoost {
         }
     }
         
+    // -----------------------------------------------------------------------
+
+    void Serialization::convertHypotheses(const string& shypFileName, const string& outShypFileName,
+                                          InputData* pData, int verbose)
+    {
+        const bool isBinary = BinaryUnSerialization::isBinaryShyp(shypFileName);
+        const string weakLearnerName = UnSerialization::getWeakLearnerName(shypFileName);
+
+        if (verbose > 0)
+            cout << "Converting <" << shypFileName << "> to " << (isBinary ? "xml" : "binary")
+                 << " <" << outShypFileName << ">..." << flush;
+
+        vector<BaseLearner*> weakHypotheses;
+        UnSerialization us;
+        us.loadHypotheses(shypFileName, weakHypotheses, pData, verbose);
+
+        Serialization ss(outShypFileName, isBinary ? SF_XML : SF_BINARY);
+        ss.writeHeader(weakLearnerName, pData);
+        ss.saveHypotheses(weakHypotheses);
+        ss.writeFooter();
+
+        for (int t = 0; t < (int)weakHypotheses.size(); ++t)
+            delete weakHypotheses[t];
+
+        if (verbose > 0)
+            cout << "Done!" << endl;
+    }
+        
     // -----------------------------------------------------------------------    
     // -----------------------------------------------------------------------
     // -----------------------------------------------------------------------
@@ -274,6 +332,15 @@ namespace MultiBoost {
                                          vector<BaseLearner*>& weakHypotheses,
                                          InputData* pTrainingData, int verbose)
     {
+        // the binary files are memory mapped and decoded in place
+        if ( BinaryUnSerialization::isBinaryShyp(shypFileName) )
+        {
+            BinaryUnSerialization bus(shypFileName);
+            bus.loadHypotheses(weakHypotheses, pTrainingData, verbose);
+            cout << weakHypotheses.size() << endl;
+            return;
+        }
+
         // open file
         ifstream inFile(shypFileName.c_str());
         if (!inFile.is_open())
@@ -399,6 +466,9 @@ namespace MultiBoost {
         
     string UnSerialization::getWeakLearnerName(const string& shypFileName)
     {
+        if ( BinaryUnSerialization::isBinaryShyp(shypFileName) )
+            return BinaryUnSerialization(shypFileName).getWeakLearnerName();
+
         // open file
         ifstream inFile(shypFileName.c_str());
         if (!inFile.is_open())
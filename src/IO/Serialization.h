@@ -60,6 +60,18 @@ namespace MultiBoost {
         
     // forward declaration to avoid an include
     class BaseLearner;
+    class BinarySerialization;
+
+    /**
+     * The formats of the strong hypothesis file (see --shypcomp).
+     * \date 16/10/2026
+     */
+    enum eShypFormat
+    {
+        SF_XML = 0,       //!< Plain xml
+        SF_XML_BZIP2 = 1, //!< Xml compressed with bzip2
+        SF_BINARY = 2     //!< Fixed binary records (see BinarySerialization)
+    };
         
         
     /**
@@ -75,17 +87,26 @@ namespace MultiBoost {
          * The constructor. Create the serialization object
          * \param shypFileName The name of the serialized strong hypothesis file.
          * hypotheses.
+         * \param shypFormat The format of the file (see eShypFormat).
          * \date 16/11/2005
          */
-        Serialization(const string& shypFileName, bool isComp = false );
+        Serialization(const string& shypFileName, int shypFormat = SF_XML );
+
+        /**
+         * The destructor.
+         * \date 16/10/2026
+         */
+        ~Serialization();
                 
         /**
          * Write the header.
          * \param weakLearnerName The name of the weak learner used to find the weak
          * hypotheses.
+         * \param pData The training data. Needed by the binary format only, for the
+         * names of the classes and of the attributes.
          * \date 16/11/2005
          */
-        void writeHeader(const string& weakLearnerName);
+        void writeHeader(const string& weakLearnerName, InputData* pData = NULL);
                 
         /**
          * Write the footer. Important because it closes the xml file.
@@ -108,6 +129,18 @@ namespace MultiBoost {
          * \date 16/11/2005
          */
         void  appendHypothesis(int iteration, BaseLearner* pWeakHypothesis, int numTab=0);
+
+        /**
+         * Convert a strong hypothesis file between xml and binary: a binary file
+         * is converted into xml and the other way around.
+         * \param shypFileName The strong hypothesis file to convert.
+         * \param outShypFileName The converted strong hypothesis file.
+         * \param pData The data the hypotheses are loaded with (class and attribute names).
+         * \param verbose The level of verbosity.
+         * \date 16/10/2026
+         */
+        static void convertHypotheses(const string& shypFileName, const string& outShypFileName,
+                                      InputData* pData, int verbose = 1);
                 
         //////////////////////////////////////////////////////////////////////////
         // helper functions for creating xml tags
@@ -184,6 +217,7 @@ namespace MultiBoost {
         string  _shypFileName;
         string   _bzipFileName;
         bool            _isComp;
+        BinarySerialization* _pBinarySerialization; //!< The binary writer, if the format is binary.
                 
     };
         
@@ -38,10 +38,33 @@
 #include <algorithm> // for sort
 
 #include <limits>
+#include <cmath> // for log
+#include <cstdlib> // for exit
 
 // ------------------------------------------------------------------------
 namespace MultiBoost {
         
+    const unsigned char SortedData::MISSING_BIN;
+        
+    // ------------------------------------------------------------------------
+        
+    // the order of the sorted columns: on the value first, then on the index of the example
+    static bool compareValueThenIndex( const pair<int, FeatureReal>& el1, const pair<int, FeatureReal>& el2 )
+    {
+        if ( el1.second != el2.second )
+            return el1.second < el2.second;
+        return el1.first < el2.first;
+    }
+        
+    // ------------------------------------------------------------------------
+        
+    static bool isMissingValue( const pair<int, FeatureReal>& el )
+    {
+        return el.second != el.second; // tricky way to test Nan
+    }
+        
+    // ------------------------------------------------------------------------
+        
     void SortedData::load(const string& fileName, eInputType inputType, int verboseLevel)
     {
         InputData::load(fileName, inputType, verboseLevel);
@@ -99,81 +122,258 @@ namespace MultiBoost {
         // For each column
         for (int j = 0; j < _pData->getNumAttributes(); ++j)
         {
+            // the missing values (NaN) are never used by the learners, so they are
+            // removed here once instead of being skipped at each filtering
+            _sortedData[j].erase( remove_if( _sortedData[j].begin(), _sortedData[j].end(), isMissingValue ),
+                                  _sortedData[j].end() );
                         
+            // The ties are broken by the index of the example, so the order of the column
+            // is fully determined (and it is the same with the stable sort). This allows
+            // getFilteredBeginEnd() to rebuild the filtered columns from the used subset.
 #if STABLE_SORT
-            stable_sort( _sortedData[j].begin(), _sortedData[j].end(), 
-                         nor_utils::comparePair<2, int, FeatureReal, less<FeatureReal> >() );
+            stable_sort( _sortedData[j].begin(), _sortedData[j].end(), compareValueThenIndex );
 #else
-            sort( _sortedData[j].begin(), _sortedData[j].end(), 
-                  nor_utils::comparePair< 2, int, FeatureReal, less<FeatureReal> >() );
+            sort( _sortedData[j].begin(), _sortedData[j].end(), compareValueThenIndex );
 #endif
         }
                 
         if (verboseLevel > 0)
             cout << "Done!" << endl;
+
+        if ( _maxNumBins > 0 )
+            computeBins(verboseLevel);
     }
         
     // ------------------------------------------------------------------------
         
-    // XXX fradav "old" optimized filter function cleaned of its O(log n) set::find()
-    // using the new _rawIndices vector and untouched typo ;-)
-    pair<vpIterator,vpIterator> SortedData::getFilteredBeginEnd(int colIdx) {
-        if ( _pData->getDataRep() == DR_DENSE ) {
-            _filteredColumn.clear();
-            for( column::iterator it = _sortedData[colIdx].begin(); it != _sortedData[colIdx].end(); it ++ ) {
-                if ( this->isUsedIndice( it->first ) && ( it->second == it->second ) ) {
-                    int i = this->getOrderBasedOnRawIndex( it->first );
-                    _filteredColumn.push_back( pair<int, FeatureReal>(i, it->second) );
-                }
+    void SortedData::initOptions(const nor_utils::Args& args)
+    {
+        InputData::initOptions(args);
+                
+        if ( args.hasArgument("bins") )
+        {
+            _maxNumBins = args.getValue<int>("bins", 0);
+            if ( _maxNumBins < 2 || _maxNumBins > MISSING_BIN )
+            {
+                cerr << "ERROR: the number of bins must be between 2 and " << static_cast<int>(MISSING_BIN) << "!" << endl;
+                exit(1);
             }
-        } else if ( _pData->getDataRep() == DR_SPARSE )
+        }
+    }
+        
+    // ------------------------------------------------------------------------
+        
+    void SortedData::computeBins(int verboseLevel)
+    {
+        if ( _pData->getDataRep() != DR_DENSE )
         {
-            //this solution is temporary, because this implementation convert dense data from the sparse one
-            _filteredColumn.clear();
-            set< int > tmpUsedIndices;
-            this->getIndexSet(tmpUsedIndices);
-            _filteredColumn.resize( tmpUsedIndices.size() );
-            int i;
-            column::reverse_iterator it;
-            for( i = _filteredColumn.size()-1, it = _sortedData[colIdx].rbegin(); it != _sortedData[colIdx].rend(); it++, i-- ) {
-                set<int>::iterator setIt = tmpUsedIndices.find( (*it).first ); 
-                if ( setIt != tmpUsedIndices.end() ) {
-                    tmpUsedIndices.erase( *setIt );
-                    int order = this->getOrderBasedOnRawIndex( it->first );
-                    _filteredColumn[ i ] =  pair<int, FeatureReal>(order, it->second);
+            if (verboseLevel > 0)
+                cout << "Warning: the binned stump search needs dense data, the exact search is used." << endl;
+            return;
+        }
+                
+        if (verboseLevel > 0)
+            cout << "Binning data..." << flush;
+                
+        const int numColumns = _pData->getNumAttributes();
+        const int numRawExamples = _pData->getNumExample();
+                
+        _binCodes.resize(numColumns);
+        _binLowerValues.resize(numColumns);
+        _binUpperValues.resize(numColumns);
+                
+        for (int j = 0; j < numColumns; ++j)
+        {
+            const column& sortedColumn = _sortedData[j];
+            const int columnSize = static_cast<int>( sortedColumn.size() );
+                        
+            _binCodes[j].assign( numRawExamples, MISSING_BIN );
+            _binLowerValues[j].clear();
+            _binUpperValues[j].clear();
+                        
+            if ( columnSize == 0 )
+                continue;
+                        
+            // the (ideal) number of examples per bin
+            const double binSize = static_cast<double>(columnSize) / _maxNumBins;
+                        
+            int binIdx = -1;
+            for (int i = 0; i < columnSize; ++i)
+            {
+                const FeatureReal val = sortedColumn[i].second;
+                                
+                // a new bin starts at a new value, once the current bin is full
+                if ( binIdx == -1 || 
+                     ( val != _binUpperValues[j][binIdx] && 
+                       i >= (binIdx + 1) * binSize && 
+                       binIdx + 1 < _maxNumBins ) )
+                {
+                    ++binIdx;
+                    _binLowerValues[j].push_back(val);
+                    _binUpperValues[j].push_back(val);
                 }
-
+                                
+                _binUpperValues[j][binIdx] = val;
+                _binCodes[j][ sortedColumn[i].first ] = static_cast<unsigned char>(binIdx);
             }
-
-            //put the zero elements into the column
-            for( set<int>::iterator setIt = tmpUsedIndices.begin(); setIt != tmpUsedIndices.end(); setIt++, i-- ){
-                int order = this->getOrderBasedOnRawIndex( *setIt );
-                _filteredColumn[ i ] =  pair<int, FeatureReal>(order, 0);
+        }
+                
+        if (verboseLevel > 0)
+            cout << "Done!" << endl;
+    }
+        
+    // ------------------------------------------------------------------------
+        
+    void SortedData::getBinnedHistogram(int colIdx, vector<AlphaReal>& histogram, vector<int>& binCounts)
+    {
+        const int numClasses = _pData->getNumClasses();
+        const int numBins = getNumBins(colIdx);
+        const vector<unsigned char>& binCodes = _binCodes[colIdx];
+                
+        histogram.assign( numBins * numClasses, 0 );
+        binCounts.assign( numBins, 0 );
+                
+        for (int i = 0; i < _numExamples; ++i)
+        {
+            const int rawIdx = _indirectIndices[i];
+            const unsigned char binIdx = binCodes[rawIdx];
+            if ( binIdx == MISSING_BIN )
+                continue;
+                        
+            ++binCounts[binIdx];
+            AlphaReal* binHistogram = &histogram[ binIdx * numClasses ];
+                        
+            const AlphaReal* weightedLabels = _pData->getWeightedLabels(rawIdx);
+            if ( weightedLabels )
+            {
+                for (int l = 0; l < numClasses; ++l)
+                    binHistogram[l] += weightedLabels[l];
+            }
+            else
+            {
+                const vector<Label>& labels = _pData->getLabels(rawIdx);
+                for (vector<Label>::const_iterator lIt = labels.begin(); lIt != labels.end(); ++lIt )
+                    binHistogram[ lIt->idx ] += lIt->weight * lIt->y;
+            }
+        }
+    }
+        
+    // ------------------------------------------------------------------------
+        
+    pair<vpIterator,vpIterator> SortedData::getUsedBeginEnd(int colIdx, column& filteredColumn)
+    {
+        column& sortedColumn = _sortedData[colIdx];
+                
+        // no filtering: the sorted column is the filtered column, no need to copy it
+        if ( !isFiltered() )
+            return make_pair(sortedColumn.begin(), sortedColumn.end());
+                
+        const int numUsed = _numExamples;
+        filteredColumn.clear();
+                
+        if ( numUsed * log(static_cast<double>(numUsed) + 1) < sortedColumn.size() && 
+             _pData->getDataRep() == DR_DENSE )
+        {
+            // Only a small subset of the examples is used (deep tree nodes, filtering):
+            // collect their values and sort them, which is proportional to the subset.
+            // Since the sorted columns are ordered on (value, example index), sorting the
+            // subset with the same order gives the same column as the scan below.
+            for (int i = 0; i < numUsed; ++i)
+            {
+                const FeatureReal val = _pData->getValue( _indirectIndices[i], colIdx );
+                if ( val == val ) // tricky way to test Nan
+                    filteredColumn.push_back( pair<int, FeatureReal>(_indirectIndices[i], val) );
+            }
+                        
+            sort( filteredColumn.begin(), filteredColumn.end(), compareValueThenIndex );
+                        
+            // from raw indices to the indices of the filtered data
+            for (column::iterator it = filteredColumn.begin(); it != filteredColumn.end(); ++it)
+                it->first = _rawIndices[ it->first ];
+        }
+        else
+        {
+            // XXX fradav "old" optimized filter function cleaned of its O(log n) set::find()
+            // using the new _rawIndices vector and untouched typo ;-)
+            for( column::iterator it = sortedColumn.begin(); it != sortedColumn.end(); ++it ) {
+                const int i = _rawIndices[ it->first ];
+                if ( i > -1 )
+                    filteredColumn.push_back( pair<int, FeatureReal>(i, it->second) );
             }
+        }
+                
+        return make_pair(filteredColumn.begin(), filteredColumn.end());
+    }
+        
+    // ------------------------------------------------------------------------
+        
+    pair<vpIterator,vpIterator> SortedData::getFilteredBeginEnd(int colIdx) {
+        pair<vpIterator,vpIterator> dataBeginEnd = getFilteredBeginEnd(colIdx, _filteredColumn);
+        _filteredBegin = dataBeginEnd.first;
+        _filteredEnd = dataBeginEnd.second;
+        return dataBeginEnd;
+    }
+
+    // ------------------------------------------------------------------------
 
+    pair<vpIterator,vpIterator> SortedData::getFilteredBeginEnd(int colIdx, column& filteredColumn) {
+        if ( _pData->getDataRep() == DR_DENSE )
+            return getUsedBeginEnd(colIdx, filteredColumn);
+                
+        // DR_SPARSE: this solution is temporary, because this implementation convert 
+        // dense data from the sparse one: the examples without a value in the
+        // column are put into the column with a zero value
+        const column& sortedColumn = _sortedData[colIdx];
+        const int numUsed = _numExamples;
+                
+        filteredColumn.resize( numUsed );
+                
+        // the non-zero elements are at the end of the column
+        int i = numUsed - 1;
+        column::const_reverse_iterator it;
+        for( it = sortedColumn.rbegin(); it != sortedColumn.rend(); ++it ) {
+            const int order = _rawIndices[ it->first ];
+            if ( order > -1 )
+                filteredColumn[ i-- ] = pair<int, FeatureReal>(order, it->second);
+        }
+                
+        //put the zero elements into the column
+        for( int order = 0; order < numUsed; ++order ) {
+            const map<int,int>& valuesIndexes = _pData->getExample( _indirectIndices[order] ).getValuesIndexesMap();
+            if ( valuesIndexes.find( colIdx ) == valuesIndexes.end() )
+                filteredColumn[ i-- ] = pair<int, FeatureReal>(order, 0);
         }
-        return make_pair(_filteredColumn.begin(),_filteredColumn.end());
+                
+        return make_pair(filteredColumn.begin(),filteredColumn.end());
     }
         
     pair<pair<vpIterator,vpIterator>,
          pair<vpReverseIterator,vpReverseIterator> > SortedData::getFilteredandReverseBeginEnd(int colIdx)
     {
-        pair<vpIterator,vpIterator> dataBeginEnd = getFilteredBeginEnd(colIdx);
+        pair<pair<vpIterator,vpIterator>,
+             pair<vpReverseIterator,vpReverseIterator> > dataSR = getFilteredandReverseBeginEnd(colIdx, _filteredColumn);
+        _filteredBegin = dataSR.first.first;
+        _filteredEnd = dataSR.first.second;
+        return dataSR;
+    }
+
+    // ------------------------------------------------------------------------
+
+    pair<pair<vpIterator,vpIterator>,
+         pair<vpReverseIterator,vpReverseIterator> > SortedData::getFilteredandReverseBeginEnd(int colIdx, column& filteredColumn)
+    {
+        pair<vpIterator,vpIterator> dataBeginEnd = getFilteredBeginEnd(colIdx, filteredColumn);
         pair<vpReverseIterator,vpReverseIterator> dataReverseBeginEnd = 
-            make_pair(_filteredColumn.rbegin(),_filteredColumn.rend());
+            make_pair(vpReverseIterator(dataBeginEnd.second), vpReverseIterator(dataBeginEnd.first));
         return make_pair(dataBeginEnd,dataReverseBeginEnd);
     }
     // ------------------------------------------------------------------------
         
     pair<vpReverseIterator,vpReverseIterator> SortedData::getFilteredReverseBeginEnd(int colIdx) {
-        _filteredColumn.clear();
-        for( column::iterator it = _sortedData[colIdx].begin(); it != _sortedData[colIdx].end(); it ++ ) {
-            if ( this->isUsedIndice( it->first ) && ( it->second == it->second ) ) {
-                int i = this->getOrderBasedOnRawIndex( it->first );
-                _filteredColumn.push_back( pair<int, FeatureReal>(i, it->second) );
-            }
-        }
-        return make_pair(_filteredColumn.rbegin(),_filteredColumn.rend());
+        pair<vpIterator,vpIterator> dataBeginEnd = getUsedBeginEnd(colIdx, _filteredColumn);
+        _filteredBegin = dataBeginEnd.first;
+        _filteredEnd = dataBeginEnd.second;
+        return make_pair(vpReverseIterator(dataBeginEnd.second), vpReverseIterator(dataBeginEnd.first));
     }
         
         
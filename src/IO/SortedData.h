@@ -67,11 +67,43 @@ namespace MultiBoost {
     {
     public:
                 
+        /**
+         * A column of the data.
+         * The pair represents the index of the example and the value of the column.
+         * The index of the column is the index of the vector itself.
+         * \remark I am storing both the index and the value because it is a trade off between
+         * speed in a key part of the code (finding the threshold) and the memory consumption.
+         * In case of very large databases, this could be turned into a index only vector.
+         * \date 11/11/2005
+         */
+        typedef vector< pair<int, FeatureReal> > column;
+                
+        /**
+         * The code of the examples with a missing value in the binned columns.
+         * \see getBinCodes
+         */
+        static const unsigned char MISSING_BIN = 255;
+
+        /**
+         * The constructor. By default the columns are not binned (exact mode).
+         * \date 16/10/2026
+         */
+        SortedData() : _maxNumBins(0) {}
+
         /**
          * The destructor. Must be declared (virtual) for the proper destruction of 
          * the object.
          */
         virtual ~SortedData() {}
+
+        /**
+         * Set the options of the data, and the number of bins of the approximate
+         * (histogram-based) stump search (--bins).
+         * \param args The arguments defined by the user in the command line.
+         * \see InputData::initOptions
+         * \date 16/10/2026
+         */
+        virtual void initOptions(const nor_utils::Args& args);
                 
         /**
          * Overloading of the load function to support sorting.
@@ -101,7 +133,7 @@ namespace MultiBoost {
          * \date 01/07/2011              
          */             
         virtual bool isFilteredAttributeEmpty() {
-            return _filteredColumn.empty();
+            return _filteredBegin == _filteredEnd;
         }
 
         /**
@@ -111,10 +143,51 @@ namespace MultiBoost {
          * \date 01/07/2011              
          */                             
         virtual bool isFilteredAttributeHasOneValue() {
-            return ( _filteredColumn[0].second == _filteredColumn[_filteredColumn.size()-1].second );
+            return ( _filteredBegin->second == (_filteredEnd-1)->second );
         }
                 
                 
+        /**
+         * Is the training data quantized for the approximate stump search?
+         * \see computeBins
+         * \date 16/10/2026
+         */
+        bool isBinned() const { return !_binCodes.empty(); }
+
+        /**
+         * The number of bins of a column.
+         * \param colIdx The column index
+         * \date 16/10/2026
+         */
+        int getNumBins(int colIdx) const { return static_cast<int>( _binLowerValues[colIdx].size() ); }
+
+        /**
+         * The smallest and the largest value of each bin of a column. A threshold between 
+         * bin b and the next non-empty bin c is (upper[b] + lower[c]) / 2.
+         * \param colIdx The column index
+         * \date 16/10/2026
+         */
+        const vector<FeatureReal>& getBinLowerValues(int colIdx) const { return _binLowerValues[colIdx]; }
+        const vector<FeatureReal>& getBinUpperValues(int colIdx) const { return _binUpperValues[colIdx]; }
+
+        /**
+         * The bin of each example (indexed by the raw index) in a column, or MISSING_BIN.
+         * \param colIdx The column index
+         * \date 16/10/2026
+         */
+        const vector<unsigned char>& getBinCodes(int colIdx) const { return _binCodes[colIdx]; }
+
+        /**
+         * Build the class-wise histogram of the y * weight values of a column in one pass
+         * over the used examples. The memory is owned by the caller, so several threads
+         * can work on different columns at the same time.
+         * \param colIdx The column index
+         * \param histogram Receives the sums, numBins x numClasses (row-major).
+         * \param binCounts Receives the number of used examples in each bin.
+         * \date 16/10/2026
+         */
+        void getBinnedHistogram(int colIdx, vector<AlphaReal>& histogram, vector<int>& binCounts);
+                
     public: 
         /**
          * Get the first and last elements of the sorted and filtered column of the data. If there is no filtering, the iterator goes over all elements.
@@ -147,23 +220,63 @@ namespace MultiBoost {
         virtual pair<pair<vpIterator,vpIterator>,
             pair<vpReverseIterator,vpReverseIterator> > getFilteredandReverseBeginEnd(int colIdx);
 
+        /**
+         * The same as getFilteredBeginEnd(int) but the filtered column is stored
+         * in a buffer owned by the caller instead of the shared _filteredColumn,
+         * so several threads can work on different columns at the same time.
+         * \param colIdx The column index
+         * \param filteredColumn The buffer that receives the filtered column.
+         * \remark If the data is not filtered (and dense) nothing is copied: the iterators
+         * point directly into the sorted column and \a filteredColumn is left untouched.
+         * If only a small subset of the examples is used, the filtered column is built
+         * from the subset instead of scanning the whole sorted column.
+         * \see getFilteredBeginEnd(int)
+         * \date 16/10/2026
+         */
+        virtual pair<vpIterator,vpIterator> getFilteredBeginEnd(int colIdx, column& filteredColumn);
+
+        /**
+         * The same as getFilteredandReverseBeginEnd(int) with a buffer owned by the caller.
+         * \see getFilteredBeginEnd(int, column&)
+         * \date 16/10/2026
+         */
+        virtual pair<pair<vpIterator,vpIterator>,
+            pair<vpReverseIterator,vpReverseIterator> > getFilteredandReverseBeginEnd(int colIdx, column& filteredColumn);
+
     protected:
                 
         /**
-         * A column of the data.
-         * The pair represents the index of the example and the value of the column.
-         * The index of the column is the index of the vector itself.
-         * \remark I am storing both the index and the value because it is a trade off between
-         * speed in a key part of the code (finding the threshold) and the memory consumption.
-         * In case of very large databases, this could be turned into a index only vector.
-         * \date 11/11/2005
+         * Get the used elements of the sorted column, as getFilteredBeginEnd() does with
+         * dense data: the examples that do not have a value for the column are not included.
+         * \param colIdx The column index
+         * \param filteredColumn The buffer that receives the filtered column if it is needed.
+         * \return A pair containing the iterator to the first and last elements of the column
+         * \date 16/10/2026
          */
-        typedef vector< pair<int, FeatureReal> > column;
+        pair<vpIterator,vpIterator> getUsedBeginEnd(int colIdx, column& filteredColumn);
                 
+        /**
+         * Quantize each column into at most _maxNumBins bins with (roughly) the
+         * same number of examples, using the sorted columns. Equal values always fall
+         * into the same bin, so a column with fewer distinct values than bins gives
+         * the same thresholds as the exact search.
+         * \param verboseLevel The level of verbosity.
+         * \date 16/10/2026
+         */
+        void computeBins(int verboseLevel);
+
         vector<column>    _sortedData; //!< the sorted data.
+
+        int _maxNumBins; //!< The maximum number of bins per column (0: exact mode).
+        vector< vector<unsigned char> > _binCodes; //!< The bin of each example, column by column.
+        vector< vector<FeatureReal> > _binLowerValues; //!< The smallest value of each bin.
+        vector< vector<FeatureReal> > _binUpperValues; //!< The largest value of each bin.
                 
         column _filteredColumn; //!< the sorted filtered data
                 
+        vpIterator _filteredBegin; //!< the beginning of the last column returned by getFilteredBeginEnd(int)
+        vpIterator _filteredEnd; //!< the end of the last column returned by getFilteredBeginEnd(int)
+                
     };
         
         
@@ -268,6 +268,20 @@ namespace MultiBoost
         inline  const map<int,int>&  getValuesIndexesMap() const { return _valIdxsMap; }
         inline             map<int,int>&  getValuesIndexesMap()       { return _valIdxsMap; }
       
+        /**
+         * Exchange the content of two examples, in constant time.
+         * \param other The other example.
+         * \date 16/10/2026
+         */
+        inline void swapWith(Example& other)
+        {
+            _labels.swap(other._labels);
+            _values.swap(other._values);
+            _valIdxs.swap(other._valIdxs);
+            _valIdxsMap.swap(other._valIdxsMap);
+            _name.swap(other._name);
+        }
+
         //////////////////////////////////////////////////////////////////////////
       
     private:
@@ -37,7 +37,7 @@
 #include <limits>
 #include <iomanip> // setprecision
 
-#include "Utils/Utils.h" // for addAndCheckExtension
+#include "Utils/Utils.h" // for addAndCheckExtension, getNumThreads
 #include "Defaults.h" // for defaultLearner
 #include "IO/OutputInfo.h"
 #include "IO/InputData.h"
@@ -69,14 +69,21 @@ namespace MultiBoost {
         else
             _shypFileName = string(SHYP_NAME);
 
-        _shypFileName = nor_utils::addAndCheckExtension(_shypFileName, SHYP_EXTENSION);
-
         ///////////////////////////////////////////////////
-        // get the output strong hypothesis file name, if given
+        // get the format of the output strong hypothesis file, if given
         if ( args.hasArgument("shypcomp") )
-            args.getValue("shypcomp", 0, _isShypCompressed );
+            args.getValue("shypcomp", 0, _shypFormat );
+        else
+            _shypFormat = SF_XML;
+
+        // the binary extension selects the binary format too
+        if ( nor_utils::addAndCheckExtension(_shypFileName, SHYP_BINARY_EXTENSION) == _shypFileName )
+            _shypFormat = SF_BINARY;
+
+        if ( _shypFormat == SF_BINARY )
+            _shypFileName = nor_utils::addAndCheckExtension(_shypFileName, SHYP_BINARY_EXTENSION);
         else
-            _isShypCompressed = false;
+            _shypFileName = nor_utils::addAndCheckExtension(_shypFileName, SHYP_EXTENSION);
 
 
         ///////////////////////////////////////////////////
@@ -180,6 +187,7 @@ namespace MultiBoost {
         if ( !_outputInfoFile.empty() ) 
         {
             pOutInfo = new OutputInfo(args);
+            pOutInfo->setHypothesisOutputCache(&_hypOutputCache);
             pOutInfo->initialize(pTrainingData);
 
             if (pTestData)
@@ -218,12 +226,15 @@ namespace MultiBoost {
         int startingIteration = resumeWeakLearners(pTrainingData);
 
 
-        Serialization ss(_shypFileName, _isShypCompressed );
-        ss.writeHeader(_baseLearnerName); // this must go after resumeProcess has been called
+        Serialization ss(_shypFileName, _shypFormat );
+        ss.writeHeader(_baseLearnerName, pTrainingData); // this must go after resumeProcess has been called
 
         // perform the resuming if necessary. If not it will just return
         resumeProcess(ss, pTrainingData, pTestData, pOutInfo);
 
+        // the stump algorithms stream the y * weight matrix, updateWeights keeps it in sync
+        pTrainingData->updateWeightedLabels();
+
         if (_verbose == 1)
             cout << "Learning in progress..." << endl;
 
@@ -269,11 +280,15 @@ namespace MultiBoost {
 
             if (_verbose > 1)
                 cout << "Weak learner: " << pWeakHypothesis->getName()<< endl;
+            // the weak hypothesis is classified once per dataset, the output
+            // information and the re-weighting share the outputs
+            _hypOutputCache.setHypothesis(pWeakHypothesis);
+
             // Output the step-by-step information
             printOutputInfo(pOutInfo, t, pTrainingData, pTestData, pWeakHypothesis);
 
             // Updates the weights and returns the edge
-            AlphaReal gamma = updateWeights(pTrainingData, pWeakHypothesis);
+            AlphaReal gamma = updateWeights(pTrainingData, pWeakHypothesis, _hypOutputCache.getOutputs(pTrainingData));
 
             if (_verbose > 1)
             {
@@ -357,6 +372,9 @@ namespace MultiBoost {
         printOutWeights( pTrainingData );
 
 
+        // the cached outputs refer to the data
+        _hypOutputCache.clear();
+
         // Free the two input data objects
         if (pTrainingData)
             delete pTrainingData;
@@ -531,6 +549,9 @@ namespace MultiBoost {
             }
         }
                 
+        // the weights have been recomputed from scratch
+        pData->updateWeightedLabels();
+
         //upload the margins 
         pOutInfo->setTable( pData, _hy );
         pOutInfo->setStartingIteration(numIters);
@@ -541,105 +562,70 @@ namespace MultiBoost {
     // -------------------------------------------------------------------------
                 
     AlphaReal AdaBoostMHLearner::updateWeights(InputData* pData, BaseLearner* pWeakHypothesis)
+    {
+        _hypOutputCache.setHypothesis(pWeakHypothesis);
+        return updateWeights(pData, pWeakHypothesis, _hypOutputCache.getOutputs(pData));
+    }
+
+    // -------------------------------------------------------------------------
+
+    AlphaReal AdaBoostMHLearner::updateWeights(InputData* pData, BaseLearner* pWeakHypothesis,
+                                               const vector<AlphaReal>& hypOutputs)
     {
         const int numExamples = pData->getNumExamples();
         const int numClasses = pData->getNumClasses();
 
         const AlphaReal alpha = pWeakHypothesis->getAlpha();
 
-        AlphaReal Z = 0; // The normalization factor
+        const int numThreads = nor_utils::getNumThreads();
 
-        _hy.resize(numExamples);
-        for ( int i = 0; i < numExamples; ++i) {
-            _hy[i].resize(numClasses);
-            fill( _hy[i].begin(), _hy[i].end(), 0.0 );
-        }
-        // recompute weights
-        // computing the normalization factor Z
+        // A single sweep over the labels computes the factor exp( -alpha * h_l(x_i) * y_i ),
+        // accumulates the edge and the normalization factor Z, and stores the
+        // unnormalized weight. It is serial on purpose: the sums are accumulated in
+        // the original order, so they do not depend on the number of threads. The
+        // edge measures the accuracy of the current weak hypothesis relative to
+        // random guessing
+        AlphaReal Z = 0;
+        AlphaReal gamma = 0;
 
-        // for each example
         for (int i = 0; i < numExamples; ++i)
         {
             vector<Label>& labels = pData->getLabels(i);
+            const AlphaReal* hx = &hypOutputs[ (size_t)i * numClasses ];
             vector<Label>::iterator lIt;
 
             for (lIt = labels.begin(); lIt != labels.end(); ++lIt )
             {
-                _hy[i][lIt->idx] = pWeakHypothesis->classify(pData, i, lIt->idx) * // h_l(x_i)
-                    lIt->y;
-                Z += lIt->weight * // w
-                    exp( 
-                        -alpha * _hy[i][lIt->idx] // -alpha * h_l(x_i) * y_i
-                        );
-                // important!
-                // _hy[i] must be a vector with different sizes, depending on the
-                // example!
-                // so it will become:
-                // _hy[i][l] 
-                // where l is NOT the index of the label (lIt->idx), but the index in the 
-                // label vector of the example
+                const AlphaReal hy = hx[lIt->idx] * lIt->y;
+                gamma += lIt->weight * hy;
+                lIt->weight = lIt->weight * exp( -alpha * hy );
+                Z += lIt->weight;
             }
         }
 
-        AlphaReal gamma = 0;
-
-        // Now do the actual re-weight
-        // (and compute the edge at the same time)
-        // for each example
+        // Z is known only now: the normalization is applied in parallel
+#pragma omp parallel for num_threads(numThreads) if (numThreads > 1) schedule(static)
         for (int i = 0; i < numExamples; ++i)
         {
             vector<Label>& labels = pData->getLabels(i);
             vector<Label>::iterator lIt;
 
+            // the row of the y * weight matrix, if it is maintained
+            AlphaReal* weightedLabels = pData->getWeightedLabels(i);
+
             for (lIt = labels.begin(); lIt != labels.end(); ++lIt )
             {
-                AlphaReal w = lIt->weight;
-                gamma += w * _hy[i][lIt->idx];
-                //if ( gamma < -0.8 ) {
-                //      cout << gamma << endl;
-                //}
                 // The new weight is  w * exp( -alpha * h(x_i) * y_i ) / Z
-                lIt->weight = w * exp( -alpha * _hy[i][lIt->idx] ) / Z;
+                lIt->weight = lIt->weight / Z;
+
+                if ( weightedLabels )
+                    weightedLabels[ lIt->idx ] = lIt->weight * lIt->y;
             }
         }
 
-
-        //for (int i = 0; i < numExamples; ++i)
-        //{
-        //   for (int l = 0; l < numClasses; ++l)
-        //   {
-        //      _hy[i][l] = pWeakHypothesis->classify(pData, i, l) * // h_l(x_i)
-        //                  pData->getLabel(i, l); // y_i
-
-        //      Z += pData->getWeight(i, l) * // w
-        //           exp( 
-        //             -alpha * _hy[i][l] // -alpha * h_l(x_i) * y_i
-        //           );
-        //   } // numClasses
-        //} // numExamples
-
-        // The edge. It measures the
-        // accuracy of the current weak hypothesis relative to random guessing
-
-        //// Now do the actual re-weight
-        //// (and compute the edge at the same time)
-        //for (int i = 0; i < numExamples; ++i)
-        //{
-        //   for (int l = 0; l < numClasses; ++l)
-        //   {  
-        //      float w = pData->getWeight(i, l);
-
-        //      gamma += w * _hy[i][l];
-
-        //      // The new weight is  w * exp( -alpha * h(x_i) * y_i ) / Z
-        //      pData->setWeight( i, l, 
-        //                        w * exp( -alpha * _hy[i][l] ) / Z );
-        //   } // numClasses
-        //} // numExamples
-
         return gamma;
     }
-        
+
     // -------------------------------------------------------------------------
 
     int AdaBoostMHLearner::resumeWeakLearners(InputData* pTrainingData)
@@ -716,11 +702,13 @@ namespace MultiBoost {
             {
                 BaseLearner* pWeakHypothesis = *it;
 
+                _hypOutputCache.setHypothesis(pWeakHypothesis);
+
                 // Output the step-by-step information
                 printOutputInfo(pOutInfo, t, pTrainingData, pTestData, pWeakHypothesis);
 
                 // Updates the weights and returns the edge
-                AlphaReal gamma = updateWeights(pTrainingData, pWeakHypothesis);
+                AlphaReal gamma = updateWeights(pTrainingData, pWeakHypothesis, _hypOutputCache.getOutputs(pTrainingData));
 
                 if (_verbose > 1 && (t + 1) % step == 0)
                 {
@@ -824,6 +812,9 @@ namespace MultiBoost {
             BaseLearner::RegisteredLearners().getLearner("ConstantLearner");
                 
                                                         
+        // the stump algorithms stream the y * weight matrix, updateWeights keeps it in sync
+        pTrainingData->updateWeightedLabels();
+
         if (_verbose == 1)
             cout << "Learning in progress... " << flush;
                 
@@ -898,6 +889,9 @@ namespace MultiBoost {
         }  // loop on iterations
         /////////////////////////////////////////////////////////
                 
+        // the caller may change the weights without keeping the matrix in sync
+        pTrainingData->clearWeightedLabels();
+
         if (_verbose > 0)
             cout << "AdaBoost Learning completed." << endl;
     }
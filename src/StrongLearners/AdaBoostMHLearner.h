@@ -42,6 +42,7 @@
 #include "StrongLearners/GenericStrongLearner.h"
 #include "Utils/Args.h"
 #include "Defaults.h"
+#include "IO/HypothesisOutputCache.h"
 
 using namespace std;
 
@@ -144,6 +145,25 @@ namespace MultiBoost {
          * \date 16/11/2005
          */
         AlphaReal updateWeights(InputData* pTrainingData, BaseLearner* pWeakHypothesis);
+
+        /**
+         * Updates the weights of the examples from the already computed outputs of the
+         * weak hypothesis. A single serial sweep over the labels computes the 
+         * exponential factors, sums Z and the edge and stores the unnormalized weights,
+         * then the weights are divided by Z in parallel. The sums are kept serial on
+         * purpose: they are accumulated in the original order, so the weights and the 
+         * edge are bit-identical to the serial update whatever the number of threads.
+         * \param pTrainingData The pointer to the training data.
+         * \param pWeakHypothesis The current weak hypothesis.
+         * \param hypOutputs The outputs of the weak hypothesis on pTrainingData 
+         * (see HypothesisOutputCache).
+         * \return The value of the edge.
+         * \see updateWeights(InputData*, BaseLearner*)
+         * \date 16/10/2026
+         */
+        AlphaReal updateWeights(InputData* pTrainingData, BaseLearner* pWeakHypothesis,
+                                const vector<AlphaReal>& hypOutputs);
+
         
         /**
          * Updates the weights of the examples. If the slowresumeprocess is on, we do not calculate the 
@@ -208,7 +228,7 @@ namespace MultiBoost {
         
         string  _baseLearnerName; //!< The name of the basic learner used by AdaBoost. 
         string  _shypFileName; //!< File name of the strong hypothesis.
-        bool       _isShypCompressed; 
+        int     _shypFormat; //!< The format of the strong hypothesis file (see eShypFormat).
         
         string  _trainFileName;
         string  _testFileName;
@@ -252,6 +272,14 @@ namespace MultiBoost {
                                             //we stop after _earlyStoppingMaxLookaheadRate*Tmin iterations
         int _currentMinT; //!< the iteration where the smoothed error is minimal so far
         ////////////////////////////////////////////////////////////////
+
+        /**
+         * The outputs of the weak hypothesis of the current iteration on the training and 
+         * test data. It is shared with OutputInfo, so that a hypothesis is classified once 
+         * per dataset and iteration.
+         */
+        HypothesisOutputCache _hypOutputCache;
+
     private:
         /**
          * Fake assignment operator to avoid warning.
@@ -260,7 +288,7 @@ namespace MultiBoost {
         AdaBoostMHLearner& operator=( const AdaBoostMHLearner& ) {return *this;}
         
         /**
-         * A temporary variable for h(x)*y. Helps saving time during re-weighting.
+         * A temporary table of the margins, used when the weights are rebuilt by the resume process.
          */
         vector< vector<AlphaReal> > _hy;
         
@@ -99,6 +99,7 @@ namespace MultiBoost {
         if ( !_outputInfoFile.empty() ) 
         {
             pOutInfo = new OutputInfo(args);
+            pOutInfo->setHypothesisOutputCache(&_hypOutputCache);
             pOutInfo->initialize(pTrainingData);
             
             if (pTestData)
@@ -138,13 +139,16 @@ namespace MultiBoost {
         // otherwise just return 0
         int startingIteration = resumeWeakLearners(pTrainingData);
                 
-        Serialization ss(_shypFileName, _isShypCompressed );
-        ss.writeHeader(_baseLearnerName); // this must go after resumeProcess has been called
+        Serialization ss(_shypFileName, _shypFormat );
+        ss.writeHeader(_baseLearnerName, pTrainingData); // this must go after resumeProcess has been called
                 
         // perform the resuming if necessary. If not it will just return
         resumeProcess(ss, pTrainingData, pTestData, pOutInfo);
                 
                 
+        // the stump algorithms stream the y * weight matrix, updateWeights keeps it in sync
+        pTrainingData->updateWeightedLabels();
+
         if (_verbose == 1)
             cout << "Learning in progress..." << endl;
                 
@@ -230,11 +234,13 @@ namespace MultiBoost {
                 cout << "Weak learner: " << pWeakHypothesis->getName()<< endl;
 
                         
+            _hypOutputCache.setHypothesis(pWeakHypothesis);
+
             // Output the step-by-step information
             printOutputInfo(pOutInfo, t, pTrainingData, pTestData, pWeakHypothesis);
                         
             // Updates the weights and returns the edge, and update the alpha
-            AlphaReal gamma = updateWeights(pTrainingData, pWeakHypothesis);
+            AlphaReal gamma = updateWeights(pTrainingData, pWeakHypothesis, _hypOutputCache.getOutputs(pTrainingData));
                         
                         
             if (_verbose > 1)
@@ -296,6 +302,9 @@ namespace MultiBoost {
         printOutWeights( pTrainingData );
                 
                 
+        // the cached outputs refer to the data
+        _hypOutputCache.clear();
+
         // Free the two input data objects
         if (pTrainingData)
             delete pTrainingData;
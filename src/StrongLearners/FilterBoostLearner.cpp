@@ -76,6 +76,13 @@ namespace MultiBoost {
             fill( _margins[i].begin(), _margins[i].end(), 0.0 );
         }
 
+        // the filter follows the seed of the run
+        _randomGenerator.setSeed( static_cast<uint64_t>( rand() ) );
+        _filterOrder.resize( numExamples );
+        for( int i=0; i<numExamples; i++ )
+            _filterOrder[i] = i;
+        _isAccepted.assign( numExamples, 0 );
+
 
         // get the testing input data, and load it
         InputData* pTestData = NULL;
@@ -130,8 +137,8 @@ namespace MultiBoost {
         int startingIteration = resumeWeakLearners(pTrainingData);
 
 
-        Serialization ss(_shypFileName, _isShypCompressed );
-        ss.writeHeader(_baseLearnerName); // this must go after resumeProcess has been called
+        Serialization ss(_shypFileName, _shypFormat );
+        ss.writeHeader(_baseLearnerName, pTrainingData); // this must go after resumeProcess has been called
 
         // perform the resuming if necessary. If not it will just return
         resumeProcess(ss, pTrainingData, pTestData, pOutInfo);
@@ -373,72 +380,65 @@ namespace MultiBoost {
         const int numExamples = pData->getNumExamples();
         const int numClasses = pData->getNumClasses();          
 
-        set<int> indexSet;
         if (size<numExamples) // not whole dataset will be used
         {
-            //random permutation
-            vector< pair<int,int> > tmpRandomArr( numExamples );
-            for( int i=0; i < numExamples; i++ ) 
-            {
-                tmpRandomArr[i].first = rand();
-                tmpRandomArr[i].second = i;
-            }
-                        
-            sort( tmpRandomArr.begin(), tmpRandomArr.end(), nor_utils::comparePair<1, int, int, less<int> >() );
-                        
-            vector< int > randPerm( numExamples );
-            for( int i=0; i<numExamples; i++ )
-            {
-                randPerm[i] = tmpRandomArr[i].second;
-            }
-            //end: random permutation
+            vector<int> indices;
+            indices.reserve( size );
                         
             int iter = 0;
-            int maxIter = 5 * size;
             int wholeIter = 0;
                         
-            indexSet.clear();
             while (1)
             {
-                if ( size<=indexSet.size() ) break;
+                if ( size<=indices.size() ) break;
                 if ( wholeIter > 5 ) rejection = false;
                 if ( numExamples <= iter ) {
                     iter = 0;
                     wholeIter++;
                 }
+
+                // random permutation: the first pass draws the next position
+                // (Fisher-Yates), the following ones visit the same permutation
+                if ( wholeIter == 0 )
+                {
+                    const int j = iter + static_cast<int>( _randomGenerator.nextIndex( numExamples - iter ) );
+                    swap( _filterOrder[iter], _filterOrder[j] );
+                }
+                const int idx = _filterOrder[iter];
+                iter++;
+                                
+                if ( _isAccepted[idx] )
+                    continue;
                                 
                 if ( rejection )
                 {                               
-                    const vector<Label>& labels = pData->getLabels( randPerm[iter] );
+                    const vector<Label>& labels = pData->getLabels( idx );
+                    const vector<AlphaReal>& margins = _margins[ idx ];
                     vector<Label>::const_iterator lIt;
                                         
                     AlphaReal scalar = 0.0;
-                    //float scalar = numeric_limits<float>::max();
                     for ( lIt = labels.begin(); lIt != labels.end(); ++lIt ) 
-                    {
-                        //if ( scalar > _margins[ randPerm[iter] ][lIt->idx] ) scalar = _margins[ randPerm[iter] ][lIt->idx];
-                        //if ( _margins[ randPerm[iter] ][lIt->idx] < 0.0 ) scalar += _margins[ randPerm[iter] ][lIt->idx];
-                        scalar += (1 / ( 1 + exp(_margins[ randPerm[iter] ][lIt->idx])));
-                    }
+                        scalar += (1 / ( 1 + exp(margins[lIt->idx])));
                                         
                     AlphaReal qValue = scalar / (AlphaReal) numClasses;
-                    //AlphaReal qValue = 1 / ( 1 + exp( scalar ) );                                                            
-                    AlphaReal randNum = (AlphaReal)rand() / RAND_MAX;
-                                        
-                                        
-                    if ( randNum < qValue ) indexSet.insert( randPerm[iter] );
+                    if ( _randomGenerator.nextDouble() >= qValue ) 
+                        continue;
                 }
-                else
-                {
-                    indexSet.insert( randPerm[iter] );
-                }
-                iter++;
+
+                _isAccepted[idx] = 1;
+                indices.push_back( idx );
             }
+
+            // the index set is sorted, and the marks are cleared for the next call
+            sort( indices.begin(), indices.end() );
+            vector<int>::iterator sIt;
+            for ( sIt = indices.begin(); sIt != indices.end(); sIt++ )
+                _isAccepted[*sIt] = 0;
+
             // normalize the weights of the labels
-            set<int>::iterator sIt;
             AlphaReal sum = 0.0;
             // for each example are in use
-            for ( sIt = indexSet.begin(); sIt != indexSet.end(); sIt++ )
+            for ( sIt = indices.begin(); sIt != indices.end(); sIt++ )
             {
                 vector<Label>& labels = pData->getLabels(*sIt);
                 vector<Label>::iterator lIt;
@@ -450,7 +450,7 @@ namespace MultiBoost {
                 }
             }
                         
-            for ( sIt = indexSet.begin(); sIt != indexSet.end(); sIt++ )
+            for ( sIt = indices.begin(); sIt != indices.end(); sIt++ )
             {
                 vector<Label>& labels = pData->getLabels(*sIt);
                 vector<Label>::iterator lIt;
@@ -461,7 +461,7 @@ namespace MultiBoost {
                 }
             }
                         
-            pData->loadIndexSet( indexSet );
+            pData->loadIndexSet( indices );
         } else { // the whole dataset is used
             AlphaReal sum = 0.0;
             // for each example are in use
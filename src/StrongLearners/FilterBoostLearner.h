@@ -41,6 +41,7 @@
 #include "StrongLearners/GenericStrongLearner.h"
 #include "StrongLearners/AdaBoostMHLearner.h"
 #include "Utils/Args.h"
+#include "Utils/Utils.h" // for RandomGenerator
 
 using namespace std;
 
@@ -118,8 +119,16 @@ namespace MultiBoost {
                 
         /**
          * The filter function. It draws random instances from the training data WITHOUT replacement.
+         * The examples are visited in a random order and, if \a rejection is set, each
+         * one is accepted with a probability equal to the average of its label weights 
+         * 1 / (1 + exp(margin)). The visiting order is shuffled lazily, so only the 
+         * visited examples are drawn and weighted, not the whole dataset.
          */
         void filter( InputData* pData, int size, bool rejection = true );
+
+        nor_utils::RandomGenerator _randomGenerator; //!< The generator of the filter, seeded from rand() in run().
+        vector<int>  _filterOrder; //!< The visiting order of the examples, shuffled by filter().
+        vector<char> _isAccepted; //!< The examples accepted by the current call of filter().
                                 
         void setWeightToMargins( InputData* pData );
         void updateMargins( InputData* pData, BaseLearner* pWeakHypothesis );
@@ -264,6 +264,106 @@ namespace MultiBoost {
     
     // -----------------------------------------------------------------------------------
 
+    void SoftCascadeLearner::updateContributionCache(InputData* pData, const vector<BaseLearner*>& candidates)
+    {
+        const int numExamples = pData->getNumExamples();
+        const int numCandidates = static_cast<int>(candidates.size());
+
+        _activeIndices.resize(numExamples);
+        _activeLabels.resize(numExamples);
+        _newExamples.clear();
+
+        int numRawExamples = static_cast<int>(_runningPosteriors.size());
+        for (int i = 0; i < numExamples; ++i) {
+            _activeIndices[i] = pData->getRawIndex(i);
+            _activeLabels[i] = getInstanceLabel(pData, i, _positiveLabelIndex);
+            numRawExamples = max(numRawExamples, _activeIndices[i] + 1);
+        }
+
+        // the bootstrapped examples come with new raw indices
+        _runningPosteriors.resize(numRawExamples, 0.);
+        _numAppliedHypotheses.resize(numRawExamples, -1);
+
+        for (int i = 0; i < numExamples; ++i) {
+            if (_numAppliedHypotheses[ _activeIndices[i] ] < 0)
+                _newExamples.push_back(i);
+        }
+
+        if (_newExamples.empty())
+            return;
+
+        const int numNewExamples = static_cast<int>(_newExamples.size());
+        const int numThreads = nor_utils::getNumThreads();
+
+        // each candidate has its own row
+#pragma omp parallel for num_threads(numThreads) if (numThreads > 1) schedule(dynamic)
+        for (int j = 0; j < numCandidates; ++j) {
+            vector<AlphaReal>& contributions = _contributions[j];
+            contributions.resize(numRawExamples, 0.);
+
+            BaseLearner* pCandidate = candidates[j];
+            const AlphaReal alpha = pCandidate->getAlpha();
+
+            for (int k = 0; k < numNewExamples; ++k) {
+                const int i = _newExamples[k];
+                contributions[ _activeIndices[i] ] = alpha * pCandidate->classify(pData, i, _positiveLabelIndex);
+            }
+        }
+
+        for (int k = 0; k < numNewExamples; ++k) {
+            const int rawIdx = _activeIndices[ _newExamples[k] ];
+            _runningPosteriors[rawIdx] = 0.;
+            _numAppliedHypotheses[rawIdx] = 0;
+        }
+    }
+
+    // -----------------------------------------------------------------------------------
+
+    void SoftCascadeLearner::updateRunningPosteriors(const vector<int>& foundIndices, vector<AlphaReal>& oPosteriors)
+    {
+        const int numExamples = static_cast<int>(_activeIndices.size());
+        const int numFound = static_cast<int>(foundIndices.size());
+
+        oPosteriors.resize(numExamples);
+
+        for (int i = 0; i < numExamples; ++i) {
+            const int rawIdx = _activeIndices[i];
+
+            // same order of the sums as computePosteriors()
+            AlphaReal& posterior = _runningPosteriors[rawIdx];
+            for (int s = _numAppliedHypotheses[rawIdx]; s < numFound; ++s)
+                posterior += _contributions[ foundIndices[s] ][rawIdx];
+            _numAppliedHypotheses[rawIdx] = numFound;
+
+            oPosteriors[i] = posterior;
+        }
+    }
+
+    // -----------------------------------------------------------------------------------
+
+    AlphaReal SoftCascadeLearner::computeCandidateSeparationSpan(const vector<AlphaReal>& contributions,
+                                                                 int numPositiveExamples, int numNegativeExamples) const
+    {
+        const int numExamples = static_cast<int>(_activeIndices.size());
+        const AlphaReal* pPosteriors = &_runningPosteriors[0];
+        const AlphaReal* pContributions = &contributions[0];
+
+        AlphaReal edgePos = 0., edgeNeg = 0.;
+
+        for (int i = 0; i < numExamples; ++i) {
+            const int rawIdx = _activeIndices[i];
+            const AlphaReal posterior = pPosteriors[rawIdx] + pContributions[rawIdx];
+            const int label = _activeLabels[i];
+
+            edgePos += (posterior * label);
+            edgeNeg += (posterior * ( 1 - label));
+        }
+
+        return edgePos / numPositiveExamples - edgeNeg / numNegativeExamples;
+    }
+
+    // -----------------------------------------------------------------------------------
+
   
     AlphaReal SoftCascadeLearner::findBestRejectionThreshold(InputData* pData, const vector<AlphaReal> & iPosteriors, const double & iFaceRejectionFraction, double & oMissesFraction)
     {
@@ -517,6 +617,22 @@ namespace MultiBoost {
         // init v_t (see the paper)
         initializeRejectionDistributionVector(_numIterations, rejectionDistributionVector);
 
+        // the contributions of the candidates are computed once, and the posteriors are
+        // updated with the selected one at each iteration
+        const vector<BaseLearner*> candidates(inWeakHypotheses);
+        vector<int> candidateIndices(candidates.size()); // the rows of inWeakHypotheses in the cache
+        for (int j = 0; j < (int)candidates.size(); ++j)
+            candidateIndices[j] = j;
+        vector<int> foundIndices;
+        vector<AlphaReal> candidateGaps;
+        vector<AlphaReal> posteriors;
+
+        _contributions.assign(candidates.size(), vector<AlphaReal>());
+        _runningPosteriors.clear();
+        _numAppliedHypotheses.clear();
+
+        const int numThreads = nor_utils::getNumThreads();
+
         if (_verbose == 1)
             cout << "Learning in progress..." << endl;
 
@@ -537,24 +653,29 @@ namespace MultiBoost {
             //vector<BaseLearner*>::const_iterator whyIt;
             int selectedIndex = 0;
             AlphaReal bestGap = 0;
-            vector<AlphaReal> posteriors;
-            computePosteriors(pTrainingData, _foundHypotheses, posteriors, _positiveLabelIndex);
-            
-            //should use an iterator instead of i
-            
-            vector<BaseLearner*>::iterator whyIt;
-            int i;
-            for (i = 0, whyIt = inWeakHypotheses.begin(); whyIt != inWeakHypotheses.end(); ++whyIt, ++i) {
-            
-                vector<AlphaReal> temporaryPosteriors = posteriors;
-                vector<BaseLearner*> temporaryWeakHyp = _foundHypotheses;
-                temporaryWeakHyp.push_back(*whyIt);
-                updatePosteriors(pTrainingData, *whyIt, temporaryPosteriors, _positiveLabelIndex);
-                
-                AlphaReal gap = computeSeparationSpan(pTrainingData, temporaryPosteriors, _positiveLabelIndex );
 
-                if (gap > bestGap) {
-                    bestGap = gap;
+            // cache the new examples, and update the posteriors of the found hypotheses
+            updateContributionCache(pTrainingData, candidates);
+            updateRunningPosteriors(foundIndices, posteriors);
+
+            const int numPositiveExamples = pTrainingData->getNumExamplesPerClass(_positiveLabelIndex);
+            const int numNegativeExamples = pTrainingData->getNumExamplesPerClass(1 - _positiveLabelIndex);
+            assert(numPositiveExamples > 0 && numNegativeExamples > 0);
+
+            // score the candidates
+            const int numCandidates = static_cast<int>(inWeakHypotheses.size());
+            candidateGaps.resize(numCandidates);
+
+#pragma omp parallel for num_threads(numThreads) if (numThreads > 1) schedule(dynamic)
+            for (int i = 0; i < numCandidates; ++i) {
+                candidateGaps[i] = computeCandidateSeparationSpan(_contributions[ candidateIndices[i] ],
+                                                                  numPositiveExamples, numNegativeExamples);
+            }
+
+            // the first best one, as in a sequential scan
+            for (int i = 0; i < numCandidates; ++i) {
+                if (candidateGaps[i] > bestGap) {
+                    bestGap = candidateGaps[i];
                     selectedIndex = i;
                 }
             }
@@ -567,7 +688,8 @@ namespace MultiBoost {
 
             //update the stages
             _foundHypotheses.push_back(selectedWeakHypothesis);
-            updatePosteriors(pTrainingData, selectedWeakHypothesis, posteriors, _positiveLabelIndex);
+            foundIndices.push_back(candidateIndices[selectedIndex]);
+            updateRunningPosteriors(foundIndices, posteriors);
             
             double missesFraction;
             AlphaReal r = findBestRejectionThreshold(pTrainingData, posteriors, faceRejectionFraction, missesFraction);
@@ -584,6 +706,7 @@ namespace MultiBoost {
             faceRejectionFraction -= missesFraction;
             
             inWeakHypotheses.erase(inWeakHypotheses.begin() + selectedIndex);
+            candidateIndices.erase(candidateIndices.begin() + selectedIndex);
             double whypCost = 1; //just in case there are different costs for each whyp
             estimatedExecutionTime += whypCost * numberOfNegatives;
             
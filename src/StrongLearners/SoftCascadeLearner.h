@@ -167,6 +167,39 @@ namespace MultiBoost {
          * \date 01/07/2011
          */
         void updatePosteriors( InputData* pData, BaseLearner* weakHypotheses, vector<AlphaReal>& oPosteriors, int positiveLabelIndex);
+
+        /**
+         * Gather the current training examples, and cache alpha * h(x) of each candidate
+         * weak hypothesis on the examples that are not cached yet (all of them at the
+         * first iteration, the bootstrapped ones later). The candidates are processed
+         * in parallel.
+         * \param pData The training data.
+         * \param candidates All the candidate weak hypotheses, the index is the row of the cache.
+         * \date 16/10/2026
+         */
+        void updateContributionCache(InputData* pData, const vector<BaseLearner*>& candidates);
+
+        /**
+         * Bring the running posteriors of the current training examples up to date with
+         * the hypotheses found so far, by adding their cached contributions.
+         * \param foundIndices The rows in the cache of the hypotheses found so far, in order.
+         * \param oPosteriors The posteriors of the current training examples.
+         * \date 16/10/2026
+         */
+        void updateRunningPosteriors(const vector<int>& foundIndices, vector<AlphaReal>& oPosteriors);
+
+        /**
+         * The separation span of the running posteriors plus the contribution of one
+         * candidate, in a single pass over the training examples and without copying
+         * the posteriors.
+         * \param contributions The cached contribution of the candidate.
+         * \param numPositiveExamples The number of positive training examples.
+         * \param numNegativeExamples The number of negative training examples.
+         * \see computeSeparationSpan
+         * \date 16/10/2026
+         */
+        AlphaReal computeCandidateSeparationSpan(const vector<AlphaReal>& contributions,
+                                                 int numPositiveExamples, int numNegativeExamples) const;
         
         /**
          * Find the rejection threshold that satisfes the rejection distribution vector while discarding the most possible negatives.
@@ -276,6 +309,13 @@ namespace MultiBoost {
         
         double _bootstrapRate; //!< The pourcentage of negative examples sampled at each iteration and added to the training set
         string _bootstrapFileName; //!< The name of the bootstrap file : a training data set containing the same attributes as the training set and only negatives.
+
+        vector< vector<AlphaReal> > _contributions; //!< alpha * h(x) of each candidate, indexed by raw example index.
+        vector<AlphaReal> _runningPosteriors; //!< The posteriors of the found hypotheses, indexed by raw example index.
+        vector<int> _numAppliedHypotheses; //!< The number of found hypotheses in _runningPosteriors (-1 if the example is not cached).
+        vector<int> _activeIndices; //!< The raw indices of the current training examples.
+        vector<int> _activeLabels; //!< Their labels (1 if positive, 0 otherwise).
+        vector<int> _newExamples; //!< The current training examples that are not in the cache yet.
         
         ////////////////////////////////////////////////////////////////
     private:
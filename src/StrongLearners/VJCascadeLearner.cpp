@@ -563,6 +563,34 @@ namespace MultiBoost {
           }                      
         */
     }
+
+    // -------------------------------------------------------------------------
+
+    long long VJCascadeLearner::calculatePosteriors( InputData* pData, vector<BaseLearner*>& weakHypotheses, const vector<int>& activeIndices,
+                                                     vector<AlphaReal>& posteriors, int positiveLabelIndex )
+    {
+        const int numExamples = pData->getNumExamples();
+        const int numActive = static_cast<int>( activeIndices.size() );
+
+        posteriors.resize(numExamples);
+        fill( posteriors.begin(), posteriors.end(), 0.0 );
+
+        vector<BaseLearner*>::iterator whyIt = weakHypotheses.begin();
+        for (;whyIt != weakHypotheses.end(); ++whyIt )
+        {
+            BaseLearner* currWeakHyp = *whyIt;
+            AlphaReal alpha = currWeakHyp->getAlpha();
+
+            // only for the points that are not rejected yet
+            for (int k = 0; k < numActive; ++k)
+            {
+                const int i = activeIndices[k];
+                posteriors[i] += alpha * currWeakHyp->classify(pData, i, positiveLabelIndex);
+            }
+        }
+
+        return static_cast<long long>( numActive ) * static_cast<long long>( weakHypotheses.size() );
+    }
         
         
     // -------------------------------------------------------------------------                                                     
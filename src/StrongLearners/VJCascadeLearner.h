@@ -139,6 +139,20 @@ namespace MultiBoost {
          * In every stage ut updates the posteriors of the training and validation data.
          */
         static void calculatePosteriors( InputData* pData, vector<BaseLearner*>& weakhyps, vector<AlphaReal>& posteriors, int positiveLabelIndex );
+
+        /**
+         * Calculates the posteriors of a stage on a subset of the examples, the ones still
+         * active in the cascade. The posteriors of the other examples are set to zero.
+         * \param pData The pointer to the data.
+         * \param weakhyps The weak learners of the stage.
+         * \param activeIndices The indices of the examples to be evaluated.
+         * \param posteriors The array of posteriors, resized to the number of examples.
+         * \param positiveLabelIndex The index of the positive class.
+         * \return The number of weak learner calls.
+         * \date 16/10/2026
+         */
+        static long long calculatePosteriors( InputData* pData, vector<BaseLearner*>& weakhyps, const vector<int>& activeIndices,
+                                              vector<AlphaReal>& posteriors, int positiveLabelIndex );
                 
     protected:
         /**
@@ -41,6 +41,7 @@
 
 #include <string>
 #include <iterator>
+#include <istream>
 
 using namespace std;
 
@@ -37,6 +37,19 @@
 #include <algorithm>
 #include <sstream>
 #include <fstream>
+#include <cstdlib> // for strtod
+#include <cstring> // for memcpy
+
+#ifndef _WIN32
+#include <sys/mman.h> // for mmap
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 namespace nor_utils {
         
@@ -321,6 +334,175 @@ namespace nor_utils {
         return true;
     }
         
+    // ----------------------------------------------------------------
+
+    double parse_double( const char* beg, const char* end )
+    {
+        // the powers of ten that are exact in double precision
+        static const double exactPowersOfTen[] = {
+            1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+            1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+        };
+        const int maxExactPower = 22;
+        const uint64_t maxExactMantissa = static_cast<uint64_t>(1) << 53;
+        const int maxDigits = 19;
+
+        const char* p = beg;
+        bool isNegative = false;
+        if ( p != end && (*p == '+' || *p == '-') )
+        {
+            isNegative = (*p == '-');
+            ++p;
+        }
+
+        uint64_t mantissa = 0;
+        int numDigits = 0;
+        int exponent = 0;
+        bool hasDigits = false;
+        bool isFast = true;
+
+        // integer part
+        for ( ; p != end && isdigit(*p); ++p )
+        {
+            hasDigits = true;
+            if ( mantissa == 0 && *p == '0' )
+                continue;
+            if ( numDigits == maxDigits ) { isFast = false; break; }
+            mantissa = mantissa * 10 + (*p - '0');
+            ++numDigits;
+        }
+
+        // fractional part
+        if ( isFast && p != end && *p == '.' )
+        {
+            for ( ++p; p != end && isdigit(*p); ++p )
+            {
+                hasDigits = true;
+                --exponent;
+                if ( mantissa == 0 && *p == '0' )
+                    continue;
+                if ( numDigits == maxDigits ) { isFast = false; break; }
+                mantissa = mantissa * 10 + (*p - '0');
+                ++numDigits;
+            }
+        }
+
+        // exponent
+        if ( isFast && hasDigits && p != end && (*p == 'e' || *p == 'E') )
+        {
+            ++p;
+            bool isNegativeExp = false;
+            if ( p != end && (*p == '+' || *p == '-') )
+            {
+                isNegativeExp = (*p == '-');
+                ++p;
+            }
+            if ( p == end || !isdigit(*p) )
+                isFast = false;
+
+            int exp = 0;
+            for ( ; p != end && isdigit(*p); ++p )
+                if ( exp < 10000 )
+                    exp = exp * 10 + (*p - '0');
+            exponent += isNegativeExp ? -exp : exp;
+        }
+
+        if ( isFast && hasDigits && p == end )
+        {
+            if ( mantissa == 0 )
+                return isNegative ? -0.0 : 0.0;
+
+            if ( mantissa <= maxExactMantissa && 
+                 exponent >= -maxExactPower && exponent <= maxExactPower )
+            {
+                double val = static_cast<double>(mantissa);
+                if ( exponent < 0 )
+                    val /= exactPowersOfTen[-exponent];
+                else
+                    val *= exactPowersOfTen[exponent];
+                return isNegative ? -val : val;
+            }
+        }
+
+        // the general case: strtod on a null terminated copy
+        const size_t length = end - beg;
+        char buffer[64];
+        if ( length < sizeof(buffer) )
+        {
+            memcpy(buffer, beg, length);
+            buffer[length] = '\0';
+            return strtod(buffer, NULL);
+        }
+
+        const string str(beg, end);
+        return strtod(str.c_str(), NULL);
+    }
+
+    // ----------------------------------------------------------------
+
+    bool MappedFile::open( const string& fileName )
+    {
+        close();
+
+#ifndef _WIN32
+        const int fd = ::open(fileName.c_str(), O_RDONLY);
+        if (fd < 0)
+            return false;
+
+        struct stat fileStat;
+        if ( fstat(fd, &fileStat) == 0 && fileStat.st_size > 0 )
+        {
+            void* pMap = mmap(NULL, fileStat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (pMap != MAP_FAILED)
+            {
+#ifdef MADV_SEQUENTIAL
+                madvise(pMap, fileStat.st_size, MADV_SEQUENTIAL);
+#endif
+                _pData = static_cast<const char*>(pMap);
+                _size = fileStat.st_size;
+                _isMapped = true;
+            }
+        }
+        ::close(fd);
+
+        if (_isMapped)
+            return true;
+#endif
+
+        // no mmap: read it at once
+        ifstream inFile(fileName.c_str(), ios::in | ios::binary);
+        if (!inFile.is_open())
+            return false;
+
+        inFile.seekg(0, ios::end);
+        _size = static_cast<size_t>(inFile.tellg());
+        inFile.seekg(0, ios::beg);
+
+        char* pData = new char[_size + 1];
+        inFile.read(pData, _size);
+        _pData = pData;
+        return true;
+    }
+
+    // ----------------------------------------------------------------
+
+    void MappedFile::close()
+    {
+        if (_pData == NULL)
+            return;
+
+#ifndef _WIN32
+        if (_isMapped)
+            munmap(const_cast<char*>(_pData), _size);
+        else
+#endif
+            delete [] _pData;
+
+        _pData = NULL;
+        _size = 0;
+        _isMapped = false;
+    }
+
     // ----------------------------------------------------------------
         
     string getAlphanumeric(int num)
@@ -365,84 +547,210 @@ namespace nor_utils {
     // ----------------------------------------------------------------
         
     AlphaReal getROC( vector< pair< int, AlphaReal > > & data ) {
-                
-        //uni_pred = unique(pred);
-        //[uni_pred, idx] = sort(uni_pred, 'descend');
+
+        // one sort by decreasing score, then the ROC curve is swept group by group
+        // of tied scores, so the points come out in order
         sort( data.begin(), data.end(), nor_utils::comparePair<2, AlphaReal, AlphaReal, greater<AlphaReal> >() );
-                
-                
-        vector< AlphaReal > uni_pred(data.size());
-        vector< AlphaReal >::iterator it;
-                
+
         int posNum = 0;
         int negNum = 0;
-                
+
         for( size_t i = 0; i < data.size(); i++ ) {
-            uni_pred[i] = data[i].second;
             if ( data[i].first == 1 ) posNum++;
             else negNum++;
         }
-                
-        //copy( pred.begin(), pred.end(), uni_pred.begin() );
-        sort( uni_pred.begin(), uni_pred.end() );
-        it=unique_copy (uni_pred.begin(),uni_pred.end(),uni_pred.begin()); 
-        uni_pred.resize( it - uni_pred.begin() ); 
-                
-        reverse( uni_pred.begin(), uni_pred.end() );
-                
-        uni_pred.push_back( 0.0 );
-        int l = uni_pred.size();
-                
-        //Y = zeros(size(testY));
-        vector< int > Y( data.size() ); 
-        vector< pair< AlphaReal, AlphaReal > > M( uni_pred.size() );
-                
-        AlphaReal x,y;
-        int TP = 0;     
+
+        const int numData = static_cast<int>( data.size() );
+
+        AlphaReal x, y;
+        int TP = 0;
         int FP = 0;
-                
+
+        AlphaReal prevX = 0.0;
+        AlphaReal prevY = 0.0;
+        AlphaReal ROCscore = 0.0;
+
         int j = 0;
-        for( int i = 0; i < uni_pred.size(); i++ ) {
-            AlphaReal th = uni_pred[i];
-                        
-                        
-            while ( ( j < data.size() ) && ( data[j].second > th ) ) {
+        while ( j < numData ) {
+            const AlphaReal th = data[j].second;
+
+            // the thresholds are the scores, plus zero: the group of the lowest 
+            // score closes the curve only if that score is positive, otherwise 
+            // the last point stays before it and the curve is closed by the 
+            // rectangle below
+            int k = j;
+            while ( ( k < numData ) && ( data[k].second == th ) ) ++k;
+            if ( k == numData && !( th > 0.0 ) ) break;
+
+            for ( ; j < k; ++j ) {
                 if ( data[j].first == 1 ) TP++;
                 if ( data[j].first == 0 ) FP++;
-                                
-                j++;
             }
-                        
+
             if ( FP == 0 )x = 0;
             else x = ((AlphaReal)FP)/((AlphaReal)negNum);
-                        
+
             if ( TP == 0 )y = 0;
             else y = ((AlphaReal)TP)/((AlphaReal)posNum);
-                        
-                        
-            M[i] = pair<AlphaReal, AlphaReal>(x,y);
+
+            ROCscore += ((((x-prevX)*(y-prevY))/2)+(x-prevX)*prevY);
+            prevX = x;
+            prevY = y;
         }
-                
-        sort( M.begin(), M.end(), nor_utils::comparePair<1, AlphaReal, AlphaReal, less<AlphaReal> >()  );
-        sort( M.begin(), M.end(), nor_utils::comparePair<2, AlphaReal, AlphaReal, less<AlphaReal> >() );
-                
+        ROCscore += (1-prevX)*prevY;
+
+        return ROCscore;
+    }       
+
+    // ----------------------------------------------------------------
+
+    void PairRadixSorter::sort( vector< pair<int, FeatureReal> >& data )
+    {
+        const size_t numData = data.size();
+        if ( numData < 2 )
+            return;
+
+        const int numBytes = sizeof(KeyType);
+        const int numBits = numBytes * 8;
+        const KeyType signBit = static_cast<KeyType>(1) << (numBits - 1);
+
+        _keys.resize(numData);
+        _keysBuffer.resize(numData);
+        _buffer.resize(numData);
+        _counts.assign(numBytes * 256, 0);
+
+        // the bits of a non negative float have its order once the sign bit
+        // is set, the ones of a negative float are reversed
+        for (size_t i = 0; i < numData; ++i)
+        {
+            KeyType key;
+            memcpy( &key, &data[i].second, sizeof(KeyType) );
+            key = ( key & signBit ) ? ~key : ( key | signBit );
+            _keys[i] = key;
+
+            for (int b = 0; b < numBytes; ++b)
+                ++_counts[ b * 256 + ( (key >> (8 * b)) & 0xFF ) ];
+        }
+
+        pair<int, FeatureReal>* pSrc = &data[0];
+        pair<int, FeatureReal>* pDst = &_buffer[0];
+        KeyType* pSrcKeys = &_keys[0];
+        KeyType* pDstKeys = &_keysBuffer[0];
+
+        for (int b = 0; b < numBytes; ++b)
+        {
+            const int shift = 8 * b;
+            size_t* pCounts = &_counts[ b * 256 ];
+
+            // all the keys fall in the same bucket: nothing to move
+            if ( pCounts[ (pSrcKeys[0] >> shift) & 0xFF ] == numData )
+                continue;
+
+            size_t offset = 0;
+            for (int d = 0; d < 256; ++d)
+            {
+                const size_t count = pCounts[d];
+                pCounts[d] = offset;
+                offset += count;
+            }
+
+            for (size_t i = 0; i < numData; ++i)
+            {
+                const size_t pos = pCounts[ (pSrcKeys[i] >> shift) & 0xFF ]++;
+                pDst[pos] = pSrc[i];
+                pDstKeys[pos] = pSrcKeys[i];
+            }
+
+            swap(pSrc, pDst);
+            swap(pSrcKeys, pDstKeys);
+        }
+
+        if ( pSrc != &data[0] )
+            copy( pSrc, pSrc + numData, data.begin() );
+    }
+
+    // ----------------------------------------------------------------
+
+    AlphaReal getHistogramROC( const vector<int>& posCounts, const vector<int>& negCounts ) {
+
+        int posNum = 0;
+        int negNum = 0;
+        int lowestBin = -1;
+
+        const int numBins = static_cast<int>( posCounts.size() );
+        for( int b = 0; b < numBins; b++ ) {
+            posNum += posCounts[b];
+            negNum += negCounts[b];
+            if ( lowestBin < 0 && posCounts[b] + negCounts[b] > 0 ) lowestBin = b;
+        }
+
+        AlphaReal x, y;
+        int TP = 0;
+        int FP = 0;
+
         AlphaReal prevX = 0.0;
         AlphaReal prevY = 0.0;
         AlphaReal ROCscore = 0.0;
-        cout.precision(10);
-        for( int i = 0; i < M.size(); i++ ) {
-            ROCscore += ((((M[i].first-prevX)*(M[i].second-prevY))/2)+(M[i].first-prevX)*prevY);
-            prevX = M[i].first;
-            prevY = M[i].second;
-                        
-            //cout << ROCscore << endl;
+
+        // the bins are the groups of tied scores of getROC, the lowest one is left
+        // to the closing rectangle as there
+        for( int b = numBins - 1; b > lowestBin; b-- ) {
+            if ( posCounts[b] + negCounts[b] == 0 ) continue;
+
+            TP += posCounts[b];
+            FP += negCounts[b];
+
+            if ( FP == 0 )x = 0;
+            else x = ((AlphaReal)FP)/((AlphaReal)negNum);
+
+            if ( TP == 0 )y = 0;
+            else y = ((AlphaReal)TP)/((AlphaReal)posNum);
+
+            ROCscore += ((((x-prevX)*(y-prevY))/2)+(x-prevX)*prevY);
+            prevX = x;
+            prevY = y;
         }
-        ROCscore += (1-prevX)*prevY;    
-                
-                
+        ROCscore += (1-prevX)*prevY;
+
         return ROCscore;
-    }       
+    }
+
     // ----------------------------------------------------------------
         
-} // end of namespace nor_utils
 
+    // the number of threads of the parallel sections, see setNumThreads()
+    static int numOfThreads = 1;
+
+    void setNumThreads(int numThreads)
+    {
+        numOfThreads = max(numThreads, 1);
+#ifdef _OPENMP
+        omp_set_num_threads(numOfThreads);
+#endif
+    }
+
+    // ----------------------------------------------------------------
+
+    int getNumThreads()
+    {
+#ifdef _OPENMP
+        return numOfThreads;
+#else
+        return 1;
+#endif
+    }
+
+    // ----------------------------------------------------------------
+
+    int getThreadIdx()
+    {
+#ifdef _OPENMP
+        return omp_get_thread_num();
+#else
+        return 0;
+#endif
+    }
+
+    // ----------------------------------------------------------------
+        
+} // end of namespace nor_utils
@@ -51,6 +51,7 @@
 #include <sstream>
 #include <algorithm>
 #include <cmath>
+#include <stdint.h> // for uint32_t and uint64_t
 
 #include "Defaults.h"
 using namespace std;
@@ -325,9 +326,67 @@ namespace nor_utils
      * \date 10/2/2006
      */
     bool is_number( const string& str );
-        
+
     // ----------------------------------------------------------------
-        
+
+    /**
+     * Convert the characters [beg, end) to a double, with the same result as
+     * atof() on the same characters. The plain decimal numbers with at most 19
+     * significant digits and a small exponent are converted with a single exact
+     * multiplication or division (correctly rounded, as strtod), the others
+     * (long mantissas, large exponents, inf, nan, hexadecimal, trailing garbage)
+     * are passed to strtod.
+     * \param beg The first character of the number.
+     * \param end One past the last character. It does not need to be a '\\0', so
+     * the number can be read in place from a memory mapped file.
+     * \return The value of the number.
+     * \date 16/10/2026
+     */
+    double parse_double( const char* beg, const char* end );
+
+    // ----------------------------------------------------------------
+
+    /**
+     * A read-only view of a whole file. The file is memory mapped, or read at once
+     * if mmap is not available, so it can be tokenized in place.
+     * \date 16/10/2026
+     */
+    class MappedFile
+    {
+    public:
+
+        //! The constructor, nothing is opened.
+        MappedFile() : _pData(NULL), _size(0), _isMapped(false) {}
+
+        //! The destructor. It unmaps the file.
+        ~MappedFile() { close(); }
+
+        /**
+         * Map the file.
+         * \param fileName The name of the file.
+         * \return \a false if the file cannot be opened.
+         * \date 16/10/2026
+         */
+        bool open( const string& fileName );
+
+        //! Unmap the file.
+        void close();
+
+        const char* begin() const { return _pData; } //!< The first character of the file.
+        const char* end() const { return _pData + _size; } //!< One past the last character.
+        size_t      size() const { return _size; } //!< The size of the file in bytes.
+
+    private:
+        MappedFile(const MappedFile&);
+        MappedFile& operator=(const MappedFile&);
+
+        const char* _pData; //!< The content of the file.
+        size_t      _size; //!< The size of the file.
+        bool        _isMapped; //!< Is _pData mapped, or allocated?
+    };
+
+    // ----------------------------------------------------------------
+
     /**
      * Convert the number from base ten to base 26 that uses only letters, 
      * that is the alphanumeric range A-Z. 
@@ -444,9 +503,156 @@ namespace nor_utils
     //bool comparePairOnSecond( const pair<T1, T2>& el1, const pair<T1, T2>& el2 )
     //{ return Pred()(el1.second, el2.second); }
         
+    // ----------------------------------------------------------------
+
+    /**
+     * Sort (index, value) pairs by increasing value, as sort() with 
+     * comparePair<2, int, FeatureReal, less<FeatureReal> >, but with a stable 
+     * LSD radix sort. The values are mapped to unsigned keys with the same order
+     * and the pairs are distributed byte by byte, skipping the bytes that are the
+     * same for all the keys. It is linear in the number of pairs, which pays off
+     * when the same (large) vector is sorted over and over, as the feature values
+     * of the Haar configurations.
+     * The buffers are kept between the calls, so every thread should reuse its
+     * own sorter.
+     * \remark The pairs with the same value keep their order, which is not the 
+     * case with sort().
+     * \remark NaN values are not supported.
+     * \date 16/10/2026
+     */
+    class PairRadixSorter
+    {
+    public:
+
+        /**
+         * Sort the pairs by increasing value (second element).
+         * \param data The pairs to be sorted in place.
+         * \date 16/10/2026
+         */
+        void sort( vector< pair<int, FeatureReal> >& data );
+
+    private:
+
+#ifndef FEATUREREALDOUBLE
+        typedef uint32_t KeyType; //!< The unsigned integer with the size of FeatureReal.
+#else
+        typedef uint64_t KeyType; //!< The unsigned integer with the size of FeatureReal.
+#endif
+
+        vector< pair<int, FeatureReal> > _buffer; //!< The destination of the odd passes.
+        vector<KeyType> _keys; //!< The keys of the pairs.
+        vector<KeyType> _keysBuffer; //!< The keys of the pairs in _buffer.
+        vector<size_t>  _counts; //!< The histograms of the bytes of the keys.
+    };
         
+    // ----------------------------------------------------------------
+
+    /**
+     * A small and fast pseudo-random generator (xorshift64*), to be used instead of
+     * rand() in the loops that draw many numbers. Unlike rand(), it has a state per 
+     * object, a period of 2^64 - 1 and 64 bits of output, so it can draw indices 
+     * in datasets larger than RAND_MAX.
+     * Seed it from rand() to follow the --seed of the run.
+     * \date 16/10/2026
+     */
+    class RandomGenerator
+    {
+    public:
+
+        /**
+         * The constructor.
+         * \param seed The seed, see setSeed().
+         * \date 16/10/2026
+         */
+        explicit RandomGenerator(uint64_t seed = 0) { setSeed(seed); }
+
+        /**
+         * Set the seed. It is scrambled (splitmix64), so close seeds give unrelated 
+         * sequences, and the zero state is avoided.
+         * \param seed The seed.
+         * \date 16/10/2026
+         */
+        void setSeed(uint64_t seed)
+        {
+            uint64_t z = seed + 0x9E3779B97F4A7C15ULL;
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+            _state = z ^ (z >> 31);
+            if ( _state == 0 )
+                _state = 0x9E3779B97F4A7C15ULL;
+        }
+
+        //! The next 64 random bits.
+        uint64_t next()
+        {
+            _state ^= _state >> 12;
+            _state ^= _state << 25;
+            _state ^= _state >> 27;
+            return _state * 0x2545F4914F6CDD1DULL;
+        }
+
+        //! A uniform random number in [0, 1).
+        double nextDouble() { return static_cast<double>( next() >> 11 ) * (1.0 / 9007199254740992.0); }
+
+        //! A uniform random integer in [0, n), n > 0.
+        size_t nextIndex(size_t n) { return static_cast<size_t>( nextDouble() * n ); }
+
+    private:
+        uint64_t _state; //!< The state, never zero.
+    };
+
+    // ----------------------------------------------------------------
+
+    /**
+     * Set the number of threads used by the parallel sections of the code.
+     * It has no effect if MultiBoost has been compiled without OpenMP.
+     * \param numThreads The number of threads. Values smaller than one are
+     * treated as one (serial run, the default).
+     * \see getNumThreads
+     * \date 16/10/2026
+     */
+    void setNumThreads(int numThreads);
+
+    /**
+     * Get the number of threads set with setNumThreads().
+     * \return The number of threads, 1 if the code runs serially.
+     * \date 16/10/2026
+     */
+    int getNumThreads();
+
+    /**
+     * Get the index of the calling thread in the current parallel section.
+     * \return A value in [0, getNumThreads()), 0 outside parallel sections.
+     * \date 16/10/2026
+     */
+    int getThreadIdx();
+
     // ----------------------------------------------------------------     
+
+    /**
+     * Compute the area under the ROC curve. The data is sorted once by decreasing
+     * score and the curve is swept group by group of tied scores, in linear time
+     * after the sort. As in the original threshold sweep, zero is one of the 
+     * thresholds, so if the lowest score is not positive its group does not add a 
+     * point to the curve and the curve is closed by a rectangle.
+     * \param data The (label, score) pairs, label 1 for the positives. It is sorted
+     * in place, so the caller can reuse the buffer.
+     * \return The area under the curve.
+     */
     AlphaReal getROC( vector< pair< int, AlphaReal > > & data );    
+
+    /**
+     * Compute an approximation of the area under the ROC curve from a histogram
+     * of the scores: the examples falling in the same bin are treated as tied, and
+     * the lowest non-empty bin as the lowest group of getROC(). It is linear in the 
+     * number of bins, and it differs from getROC() on the exact scores by at most the
+     * fraction of the (positive, negative) pairs that share a bin.
+     * \param posCounts The number of positives per bin, bins in increasing score order.
+     * \param negCounts The number of negatives per bin.
+     * \return The approximate area under the curve.
+     * \date 16/10/2026
+     */
+    AlphaReal getHistogramROC( const vector<int>& posCounts, const vector<int>& negCounts );
     // -------------------------------------------------------------------------
         
 } // end of namespace nor_utils
@@ -72,8 +72,9 @@ namespace MultiBoost {
                              1, "<filename>");
 
         args.declareArgument("shypcomp", 
-                             "The shyp file will be compressed", 
-                             1, "<flag 0-1>");
+                             "The format of the shyp file: 0 = xml, 1 = xml compressed with bzip2, 2 = binary (also selected by a ."
+                             + string(SHYP_BINARY_EXTENSION) + " shypname).", 
+                             1, "<format 0-2>");
 
         args.setGroup("Basic Algorithm Options");
         args.declareArgument("resume", 
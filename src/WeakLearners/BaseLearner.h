@@ -55,6 +55,7 @@ namespace MultiBoost {
             
     class InputData;
     class GenericStrongLearner;
+    struct BinaryHypothesis;
         
     /**
      * Generic base learner. 
@@ -349,6 +350,26 @@ namespace MultiBoost {
          * \date 13/11/2005
          */
         virtual void load(nor_utils::StreamTokenizer& st);
+
+        /**
+         * Serialize the object into the fixed record of the binary strong
+         * hypothesis file. Only the learners with a fixed record layout override
+         * it, the others are saved in xml.
+         * \param hypothesis The record to fill.
+         * \return false if the learner cannot be saved in binary (the default).
+         * \see BinarySerialization
+         * \date 16/10/2026
+         */
+        virtual bool saveBinary(BinaryHypothesis& /*hypothesis*/) { return false; }
+
+        /**
+         * Unserialize the object from a record of the binary strong hypothesis file.
+         * \param hypothesis The record, in the index space of the training data.
+         * \see saveBinary
+         * \see BinaryUnSerialization
+         * \date 16/10/2026
+         */
+        virtual void loadBinary(const BinaryHypothesis& /*hypothesis*/) {}
                 
         /**
          * Creates a copy of the learner containing all the info we need in classify()
@@ -34,9 +34,11 @@
 #include "ConstantLearner.h"
 
 #include "IO/Serialization.h"
+#include "IO/BinarySerialization.h"
 #include "Algorithms/ConstantAlgorithm.h"
 
 #include <limits> // for numeric_limits<>
+#include <typeinfo> // for typeid
 
 namespace MultiBoost {
 
@@ -89,6 +91,29 @@ namespace MultiBoost {
         StochasticLearner::subCopyState( pBaseLearner );
         AbstainableLearner::subCopyState( pBaseLearner );
     }
+
+// -----------------------------------------------------------------------      
+    bool ConstantLearner::saveBinary(BinaryHypothesis& hypothesis)
+    {
+        // the subclasses have their own state
+        if ( typeid(*this) != typeid(ConstantLearner) )
+            return false;
+
+        const int numClasses = static_cast<int>(_v.size());
+        hypothesis.type = BHT_CONSTANT;
+        hypothesis.alpha = _alpha;
+        hypothesis.v = _v;
+        hypothesis.columns.assign(numClasses, -1);
+        hypothesis.thresholds.assign(numClasses, 0);
+        return true;
+    }
+
+// -----------------------------------------------------------------------      
+    void ConstantLearner::loadBinary(const BinaryHypothesis& hypothesis)
+    {
+        _alpha = hypothesis.alpha;
+        _v = hypothesis.v;
+    }
         
         
 // -----------------------------------------------------------------------      
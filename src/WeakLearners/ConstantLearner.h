@@ -107,6 +107,24 @@ namespace MultiBoost {
         {
             AbstainableLearner::initLearningOptions( args );
         }
+
+        /**
+         * Save the hypothesis into a record of the binary strong hypothesis file.
+         * It uses no column.
+         * \param hypothesis The record to fill.
+         * \return false for the subclasses, that must be saved in xml.
+         * \see BaseLearner::saveBinary
+         * \date 16/10/2026
+         */
+        virtual bool saveBinary(BinaryHypothesis& hypothesis);
+
+        /**
+         * Load the hypothesis from a record of the binary strong hypothesis file.
+         * \param hypothesis The record, in the index space of the training data.
+         * \see saveBinary
+         * \date 16/10/2026
+         */
+        virtual void loadBinary(const BinaryHypothesis& hypothesis);
                 
         /**
          * Copy all the info we need in classify().
@@ -57,6 +57,12 @@ namespace MultiBoost {
                              "(Turned off for Haar: use -csample instead)",
                              1, "<num>");
                 
+        args.declareArgument("bins",
+                             "Approximate stump search: each feature is quantized once into at most <num> "
+                             "bins (2..255), and the thresholds are searched on the per-bin histograms. "
+                             "Example: -bins 64 (default: exact search)",
+                             1, "<num>");
+                
     }
         
     // ------------------------------------------------------------------------------
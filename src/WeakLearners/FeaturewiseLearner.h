@@ -164,7 +164,10 @@ namespace MultiBoost {
          * \date 25/05/2007
          */
         virtual void subCopyState(BaseLearner *pBaseLearner);
-                
+
+        //! The column of the data the learner is based on.
+        int getSelectedColumn() const { return _selectedColumn; }
+
     protected:
                 
         /**
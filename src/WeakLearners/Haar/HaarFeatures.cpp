@@ -50,32 +50,33 @@ namespace MultiBoost {
     // ------------------------------------------------------------------------------
         
     void HaarFeature::fillHaarData( const vector<Example>& intImages, // in
-                                    vector< pair<int, FeatureReal> >& haarData ) // out
+                                    vector< pair<int, FeatureReal> >& haarData, // out
+                                    const nor_utils::Rect& config ) // in
     {
         switch (_type)
         {
         case FEATURE_2H_RECT: //!< Two horizontal.
-            _fillHaarData<HaarFeature_2H>(intImages, haarData);
+            _fillHaarData<HaarFeature_2H>(intImages, haarData, config);
             break;
                                 
         case FEATURE_2V_RECT: //!< Two vertical. 
                                 
-            _fillHaarData<HaarFeature_2V>(intImages, haarData);
+            _fillHaarData<HaarFeature_2V>(intImages, haarData, config);
             break;
                                 
         case FEATURE_3H_RECT: //!< Three horizontal.
                                 
-            _fillHaarData<HaarFeature_3H>(intImages, haarData);
+            _fillHaarData<HaarFeature_3H>(intImages, haarData, config);
             break;
                                 
         case FEATURE_3V_RECT: //!< Three vertical.
                                 
-            _fillHaarData<HaarFeature_3V>(intImages, haarData);
+            _fillHaarData<HaarFeature_3V>(intImages, haarData, config);
             break;
                                 
         case FEATURE_4SQUARE_RECT: //!< Four square.
                                 
-            _fillHaarData<HaarFeature_4SQ>(intImages, haarData);
+            _fillHaarData<HaarFeature_4SQ>(intImages, haarData, config);
             break;
                                 
         case FEATURE_NO_TYPE:
@@ -86,6 +87,80 @@ namespace MultiBoost {
                 
     }
         
+    // ------------------------------------------------------------------------------
+
+    namespace {
+
+        // The number of examples whose values are computed at once by the
+        // pixel-major fillHaarData
+        const int HAAR_BLOCK_SIZE = 256;
+
+        // Sum the rectangles given by their corner columns, from the example
+        // begin, with the same operations as getValue()
+        void sumRects(const FeatureReal* pCorners[2][4], int numRects, 
+                      int begin, int blockSize, FeatureReal* pSums)
+        {
+            const FeatureReal* p4 = pCorners[0][0] + begin;
+            const FeatureReal* p1 = pCorners[0][1] + begin;
+            const FeatureReal* p2 = pCorners[0][2] + begin;
+            const FeatureReal* p3 = pCorners[0][3] + begin;
+
+            for (int i = 0; i < blockSize; ++i)
+                pSums[i] = p4[i] + p1[i] - (p2[i] + p3[i]);
+
+            for (int r = 1; r < numRects; ++r)
+            {
+                p4 = pCorners[r][0] + begin;
+                p1 = pCorners[r][1] + begin;
+                p2 = pCorners[r][2] + begin;
+                p3 = pCorners[r][3] + begin;
+
+                for (int i = 0; i < blockSize; ++i)
+                    pSums[i] += p4[i] + p1[i] - (p2[i] + p3[i]);
+            }
+        }
+
+    } // end of anonymous namespace
+
+    // ------------------------------------------------------------------------------
+
+    void HaarFeature::fillHaarData( const HaarData* pHaarData, // in
+                                    vector< pair<int, FeatureReal> >& haarData, // out
+                                    const nor_utils::Rect& config ) // in
+    {
+        HaarRects rects;
+        getRects(config, rects);
+
+        // the columns of the corners, for all the examples
+        const FeatureReal* pWhiteCorners[2][4];
+        const FeatureReal* pBlackCorners[2][4];
+        for (int r = 0; r < rects.numWhite; ++r)
+            for (int c = 0; c < 4; ++c)
+                pWhiteCorners[r][c] = pHaarData->getPixelColumn( rects.white[r][c][0], rects.white[r][c][1] );
+        for (int r = 0; r < rects.numBlack; ++r)
+            for (int c = 0; c < 4; ++c)
+                pBlackCorners[r][c] = pHaarData->getPixelColumn( rects.black[r][c][0], rects.black[r][c][1] );
+
+        FeatureReal whiteSums[HAAR_BLOCK_SIZE];
+        FeatureReal blackSums[HAAR_BLOCK_SIZE];
+
+        const int numExamples = static_cast<int>( haarData.size() );
+        for (int begin = 0; begin < numExamples; begin += HAAR_BLOCK_SIZE)
+        {
+            const int blockSize = min(HAAR_BLOCK_SIZE, numExamples - begin);
+
+            sumRects(pWhiteCorners, rects.numWhite, begin, blockSize, whiteSums);
+            sumRects(pBlackCorners, rects.numBlack, begin, blockSize, blackSums);
+
+            vector< pair<int, FeatureReal> >::iterator hIt = haarData.begin() + begin;
+            for (int i = 0; i < blockSize; ++i, ++hIt)
+            {
+                hIt->first = begin + i;
+                hIt->second = blackSums[i] - whiteSums[i];
+            }
+        }
+    }
+        
     // ------------------------------------------------------------------------------
         
     int HaarFeature::precomputeConfigs()
@@ -148,6 +223,17 @@ namespace MultiBoost {
             return intImage[ HaarData::areaWidth() * y + x ]; 
     }   
         
+    // ------------------------------------------------------------------------------
+
+    void HaarFeature::setCorners(int corners[4][2], int x4, int y4, int x1, int y1,
+                                 int x2, int y2, int x3, int y3)
+    {
+        corners[0][0] = x4; corners[0][1] = y4;
+        corners[1][0] = x1; corners[1][1] = y1;
+        corners[2][0] = x2; corners[2][1] = y2;
+        corners[3][0] = x3; corners[3][1] = y3;
+    }
+        
     // ------------------------------------------------------------------------------
         
     void HaarFeature::resetConfigIterator()
@@ -251,6 +337,19 @@ namespace MultiBoost {
     }
         
     // ------------------------------------------------------------------------------
+
+    void HaarFeature_2H::getRects(const nor_utils::Rect& r, HaarRects& rects) const
+    {
+        int xHalfPos = r.x + (r.width / 2);
+        int yEndPos = r.y + r.height;
+
+        rects.numWhite = 1;
+        rects.numBlack = 1;
+        setCorners(rects.white[0], xHalfPos, yEndPos, r.x-1, r.y-1, xHalfPos, r.y-1, r.x-1, yEndPos);
+        setCorners(rects.black[0], r.x+r.width, yEndPos, xHalfPos, r.y-1, r.x+r.width, r.y-1, xHalfPos, yEndPos);
+    }
+        
+    // ------------------------------------------------------------------------------
         
         
     FeatureReal HaarFeature_2V::getValue(const vector<FeatureReal>& intImage, const nor_utils::Rect& r)
@@ -272,6 +371,19 @@ namespace MultiBoost {
         return blackSum - whiteSum;  
     }
         
+    // ------------------------------------------------------------------------------
+
+    void HaarFeature_2V::getRects(const nor_utils::Rect& r, HaarRects& rects) const
+    {
+        int yHalfPos = r.y + (r.height / 2);
+        int xEndPos = r.x + r.width;
+
+        rects.numWhite = 1;
+        rects.numBlack = 1;
+        setCorners(rects.white[0], xEndPos, yHalfPos, r.x-1, r.y-1, xEndPos, r.y-1, r.x-1, yHalfPos);
+        setCorners(rects.black[0], xEndPos, r.y+r.height, r.x-1, yHalfPos, xEndPos, yHalfPos, r.x-1, r.y+r.height);
+    }
+        
     // ------------------------------------------------------------------------------
         
     FeatureReal HaarFeature_3H::getValue(const vector<FeatureReal>& intImage, const nor_utils::Rect& r)
@@ -314,6 +426,22 @@ namespace MultiBoost {
         return blackSum - whiteSum;
     }
         
+    // ------------------------------------------------------------------------------
+
+    void HaarFeature_3H::getRects(const nor_utils::Rect& r, HaarRects& rects) const
+    {
+        int xOneThirdPos = r.x + ( r.width / 3);
+        int xTwoThirdPos = r.x + ( ((r.width+1) / 3) * 2 - 1);
+        int yEndPos = r.y + r.height;
+
+        // left and right white, center black
+        rects.numWhite = 2;
+        rects.numBlack = 1;
+        setCorners(rects.white[0], xOneThirdPos, yEndPos, r.x-1, r.y-1, xOneThirdPos, r.y-1, r.x-1, yEndPos);
+        setCorners(rects.black[0], xTwoThirdPos, yEndPos, xOneThirdPos, r.y-1, xTwoThirdPos, r.y-1, xOneThirdPos, yEndPos);
+        setCorners(rects.white[1], r.x+r.width, yEndPos, xTwoThirdPos, r.y-1, r.x+r.width, r.y-1, xTwoThirdPos, yEndPos);
+    }
+        
     // ------------------------------------------------------------------------------
         
     FeatureReal HaarFeature_3V::getValue(const vector<FeatureReal>& intImage, const nor_utils::Rect& r)
@@ -345,6 +473,22 @@ namespace MultiBoost {
         return blackSum - whiteSum;
     }
         
+    // ------------------------------------------------------------------------------
+
+    void HaarFeature_3V::getRects(const nor_utils::Rect& r, HaarRects& rects) const
+    {
+        int yOneThirdPos = r.y + ( r.height / 3);
+        int yTwoThirdPos = r.y + ( ((r.height+1) / 3) * 2 - 1);
+        int xEndPos = r.x + r.width;
+
+        // top and bottom white, center black
+        rects.numWhite = 2;
+        rects.numBlack = 1;
+        setCorners(rects.white[0], xEndPos, yOneThirdPos, r.x-1, r.y-1, xEndPos, r.y-1, r.x-1, yOneThirdPos);
+        setCorners(rects.black[0], xEndPos, yTwoThirdPos, r.x-1, yOneThirdPos, xEndPos, yOneThirdPos, r.x-1, yTwoThirdPos);
+        setCorners(rects.white[1], xEndPos, r.y+r.height, r.x-1, yTwoThirdPos, xEndPos, yTwoThirdPos, r.x-1, r.y+r.height);
+    }
+        
     // ------------------------------------------------------------------------------
         
     FeatureReal HaarFeature_4SQ::getValue(const vector<FeatureReal>& intImage, const nor_utils::Rect& r)
@@ -389,5 +533,23 @@ namespace MultiBoost {
     }
         
     // ------------------------------------------------------------------------------
+
+    void HaarFeature_4SQ::getRects(const nor_utils::Rect& r, HaarRects& rects) const
+    {
+        int yHalfPos = r.y + (r.height / 2);
+        int yEndPos = r.y + r.height;
+        int xHalfPos = r.x + (r.width / 2);
+        int xEndPos = r.x + r.width;
+
+        // top left and bottom right white, top right and bottom left black
+        rects.numWhite = 2;
+        rects.numBlack = 2;
+        setCorners(rects.white[0], xHalfPos, yHalfPos, r.x-1, r.y-1, xHalfPos, r.y-1, r.x-1, yHalfPos);
+        setCorners(rects.black[0], xEndPos, yHalfPos, xHalfPos, r.y-1, xEndPos, r.y-1, xHalfPos, yHalfPos);
+        setCorners(rects.black[1], xHalfPos, yEndPos, r.x-1, yHalfPos, xHalfPos, yHalfPos, r.x-1, yEndPos);
+        setCorners(rects.white[1], xEndPos, yEndPos, xHalfPos, yHalfPos, xEndPos, yHalfPos, xHalfPos, yEndPos);
+    }
+        
+    // ------------------------------------------------------------------------------
         
 } // end of namespace MultiBoost
@@ -80,6 +80,25 @@ namespace MultiBoost {
         AT_RANDOM_SAMPLING //!< Random sampling of the configurations. 
     };
         
+    /**
+     * The rectangles of a Haar-like feature in a given configuration. Each
+     * rectangle is given by the (x, y) coordinates of its four corners in the 
+     * integral image, in the order of the formula 4+1 - (2+3) (see HaarFeature_2H).
+     * The output of the feature is the sum of the black rectangles minus
+     * the sum of the white ones, both summed in the order of the arrays.
+     * \see HaarFeature::getRects
+     * \date 16/10/2026
+     */
+    struct HaarRects
+    {
+        int numWhite; //!< The number of white rectangles (1 or 2).
+        int numBlack; //!< The number of black rectangles (1 or 2).
+        int white[2][4][2]; //!< The corners of the white rectangles.
+        int black[2][4][2]; //!< The corners of the black rectangles.
+    };
+
+    class HaarData;
+
     //////////////////////////////////////////////////////////////////////////
     //////////////////////////////////////////////////////////////////////////
         
@@ -338,7 +357,53 @@ namespace MultiBoost {
          * \date 27/12/2005
          */
         void fillHaarData( const vector<Example>& intImages, // in
-                           vector< pair<int, FeatureReal> >& haarData ); // out
+                           vector< pair<int, FeatureReal> >& haarData ) // out
+        { fillHaarData(intImages, haarData, getCurrentConfig()); }
+
+        /**
+         * Convert the vector of all the examples (in integral image format) into
+         * a vector of features outputs, using the given configuration.
+         * It does not touch the iterator over the configurations, therefore
+         * several configurations of the same feature can be converted at the 
+         * same time (see HaarSingleStumpLearner::run()).
+         * \param intImages The vector with the examples to be converted.
+         * \param haarData The returned vector of features outputs.
+         * \param config The configuration that will be used to compute the values.
+         * \see fillHaarData
+         * \date 16/10/2026
+         */
+        void fillHaarData( const vector<Example>& intImages, // in
+                           vector< pair<int, FeatureReal> >& haarData, // out
+                           const nor_utils::Rect& config ); // in
+
+        /**
+         * Convert the training examples into a vector of features outputs, using
+         * the given configuration and the pixel-major copy of the integral images
+         * (see HaarData::getPixelColumn). The rectangles of the configuration are
+         * computed once, then the values are computed block by block of examples:
+         * the corners of every rectangle are contiguous columns, which are summed
+         * in straight (vectorizable) loops. The result is the same as the one of 
+         * getValue().
+         * \param pHaarData The training data, which must have the pixel-major copy
+         * (see HaarData::preparePixelMajorImages).
+         * \param haarData The returned vector of features outputs. It must have the
+         * size of the number of examples.
+         * \param config The configuration that will be used to compute the values.
+         * \date 16/10/2026
+         */
+        void fillHaarData( const HaarData* pHaarData, // in
+                           vector< pair<int, FeatureReal> >& haarData, // out
+                           const nor_utils::Rect& config ); // in
+
+        /**
+         * Get the rectangles of the feature in the given configuration.
+         * It will be overridden by the derived classes, consistently with getValue().
+         * \param r The configuration of the feature.
+         * \param rects The returned rectangles.
+         * \see HaarRects
+         * \date 16/10/2026
+         */
+        virtual void getRects(const nor_utils::Rect& r, HaarRects& rects) const = 0;
                 
         /**
          * Get the feature output given a single example (in integral image format).
@@ -369,6 +434,14 @@ namespace MultiBoost {
          * \date 27/12/2005
          */
         FeatureReal getSumAt(const vector<FeatureReal>& intImage, int x, int y);
+
+        /**
+         * Set the four corners of a rectangle, in the order of the formula 4+1 - (2+3).
+         * \see HaarRects
+         * \date 16/10/2026
+         */
+        static void setCorners(int corners[4][2], int x4, int y4, int x1, int y1,
+                               int x2, int y2, int x3, int y3);
                 
         string       _shortName; //!< The short name of the Haar-like feature. 
                 
@@ -426,19 +499,20 @@ namespace MultiBoost {
          * method to avoid the virtual calling.
          * \param intImages The vector with the examples to be converted.
          * \param haarData The returned vector of features outputs.
+         * \param currConfig The configuration used to compute the values.
          * \see fillHaarData.
          * \date 27/12/2005
          */
         template <typename TDeriv>
             void _fillHaarData( const vector<Example>& intImages, // input 
-                                vector< pair<int, FeatureReal> >& haarData ) // output
+                                vector< pair<int, FeatureReal> >& haarData, // output
+                                const nor_utils::Rect& currConfig ) // input
         {
             int i;
             vector<Example>::const_iterator iiIt;
             const vector<Example>::const_iterator iiEnd = intImages.end();
                         
             vector< pair<int, FeatureReal> >::iterator hIt;
-            const nor_utils::Rect& currConfig = getCurrentConfig();
                         
             for (iiIt = intImages.begin(), hIt = haarData.begin(), i = 0;
                  iiIt != iiEnd; ++iiIt, ++hIt, ++i)
@@ -502,6 +576,14 @@ namespace MultiBoost {
          * \date 27/12/2005
          */
         virtual FeatureReal getValue(const vector<FeatureReal>& intImage, const nor_utils::Rect& r);
+
+        /**
+         * Get the rectangles of the feature, as used by getValue().
+         * \param r The configuration of the feature.
+         * \param rects The returned rectangles.
+         * \date 16/10/2026
+         */
+        virtual void getRects(const nor_utils::Rect& r, HaarRects& rects) const;
     };
         
     // ------------------------------------------------------------------------------
@@ -558,6 +640,14 @@ namespace MultiBoost {
          * \date 27/12/2005
          */
         virtual FeatureReal getValue(const vector<FeatureReal>& intImage, const nor_utils::Rect& r);
+
+        /**
+         * Get the rectangles of the feature, as used by getValue().
+         * \param r The configuration of the feature.
+         * \param rects The returned rectangles.
+         * \date 16/10/2026
+         */
+        virtual void getRects(const nor_utils::Rect& r, HaarRects& rects) const;
     };
         
     // ------------------------------------------------------------------------------
@@ -616,6 +706,14 @@ namespace MultiBoost {
          * \date 27/12/2005
          */
         virtual FeatureReal getValue(const vector<FeatureReal>& intImage, const nor_utils::Rect& r);
+
+        /**
+         * Get the rectangles of the feature, as used by getValue().
+         * \param r The configuration of the feature.
+         * \param rects The returned rectangles.
+         * \date 16/10/2026
+         */
+        virtual void getRects(const nor_utils::Rect& r, HaarRects& rects) const;
     };
         
     // ------------------------------------------------------------------------------
@@ -668,6 +766,14 @@ namespace MultiBoost {
          * \date 27/12/2005
          */
         virtual FeatureReal getValue(const vector<FeatureReal>& intImage, const nor_utils::Rect& r);
+
+        /**
+         * Get the rectangles of the feature, as used by getValue().
+         * \param r The configuration of the feature.
+         * \param rects The returned rectangles.
+         * \date 16/10/2026
+         */
+        virtual void getRects(const nor_utils::Rect& r, HaarRects& rects) const;
     };
         
     // ------------------------------------------------------------------------------
@@ -726,6 +832,14 @@ namespace MultiBoost {
          * \date 27/12/2005
          */
         virtual FeatureReal getValue(const vector<FeatureReal>& intImage, const nor_utils::Rect& r);
+
+        /**
+         * Get the rectangles of the feature, as used by getValue().
+         * \param r The configuration of the feature.
+         * \param rects The returned rectangles.
+         * \date 16/10/2026
+         */
+        virtual void getRects(const nor_utils::Rect& r, HaarRects& rects) const;
     };
         
     // ------------------------------------------------------------------------------
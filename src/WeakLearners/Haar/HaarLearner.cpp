@@ -76,6 +76,13 @@ namespace MultiBoost {
                              "Example: -iisize 128x64", 
                              1, "<width>x<height>");
 
+        args.declareArgument("hcache", 
+                             "Keep the sorted outputs of the visited configurations on the training data,\n"
+                             "so that they are not recomputed when a configuration is visited again.\n"
+                             "The least recently used ones are dropped to stay within the given memory.\n"
+                             "Example: -hcache 512 -> Use at most 512 megabytes.", 
+                             1, "<megabytes>");
+
     }
 
 // ------------------------------------------------------------------------------
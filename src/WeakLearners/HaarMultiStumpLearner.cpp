@@ -38,6 +38,7 @@
 #include "WeakLearners/Haar/HaarFeatures.h" // for shortname->type and viceversa (see serialization)
 
 #include "Algorithms/StumpAlgorithm.h"
+#include "Utils/Utils.h" // for getNumThreads and PairRadixSorter
 
 #include <limits> // for numeric_limits
 #include <ctime> // for time
@@ -84,28 +85,19 @@ namespace MultiBoost {
     AlphaReal HaarMultiStumpLearner::run()
     {
         const int numClasses = _pTrainingData->getNumClasses();
+        const int numExamples = _pTrainingData->getNumExamples();
                 
         // set the smoothing value to avoid numerical problem
         // when theta=0.
         setSmoothingVal( 1.0 / (AlphaReal)_pTrainingData->getNumExamples() * 0.01 );
                 
-        vector<sRates> mu(numClasses); // The class-wise rates. See BaseLearner::sRates for more info.
-        vector<AlphaReal> tmpV(numClasses); // The class-wise votes/abstentions
-                
-        vector<FeatureReal> tmpThresholds(numClasses);
-        AlphaReal tmpAlpha;
-                
         AlphaReal bestEnergy = numeric_limits<AlphaReal>::max();
-        AlphaReal tmpEnergy;
                 
         HaarData* pHaarData = static_cast<HaarData*>(_pTrainingData);
                 
         // get the whole data matrix
         //   const vector<int*>& intImages = pHaarData->getIntImageVector();
                 
-        // The data matrix transformed into the feature's space
-        vector< pair<int, FeatureReal> > processedHaarData(_pTrainingData->getNumExamples());
-                
         // I need to prepare both type of sampling
         int numConf; // for ST_NUM
         time_t startTime, currentTime; // for ST_TIME
@@ -113,8 +105,42 @@ namespace MultiBoost {
         long numProcessed;
         bool quitConfiguration;
                 
-        StumpAlgorithm<FeatureReal> sAlgo(numClasses);
-        sAlgo.initSearchLoop(_pTrainingData);
+        StumpAlgorithm<FeatureReal> initAlgo(numClasses);
+        initAlgo.initSearchLoop(_pTrainingData);
+
+        // The examples are transformed from the pixel-major copy of the integral 
+        // images if available, otherwise example by example
+        const bool hasPixelMajorImages = pHaarData->preparePixelMajorImages();
+        const vector<Example>& examples = _pTrainingData->getExamples();
+
+        // The sorted outputs of the configurations visited before, if the cache
+        // is enabled. They depend on the examples, so the cache is not used on subsets.
+        HaarColumnCache& columnCache = pHaarData->getColumnCache();
+        const bool useCache = columnCache.isEnabled() && !pHaarData->isFiltered();
+
+        // The configurations are evaluated in parallel batches, as in
+        // HaarSingleStumpLearner::run()
+        const int numThreads = nor_utils::getNumThreads();
+        const int batchSize = numThreads > 1 ? numThreads * 8 : 1;
+
+        // The scratch buffers of every thread
+        vector< vector< pair<int, FeatureReal> > > processedHaarData( 
+            useCache ? 0 : numThreads, vector< pair<int, FeatureReal> >(numExamples) );
+        vector<nor_utils::PairRadixSorter> sorters(numThreads);
+        vector< StumpAlgorithm<FeatureReal> > sAlgos(numThreads, initAlgo);
+        vector< vector<sRates> > mu( numThreads, vector<sRates>(numClasses) ); // The class-wise rates. See BaseLearner::sRates for more info.
+
+        // The configurations of the batch and their stumps
+        vector<nor_utils::Rect> batchConfigs;
+        batchConfigs.reserve(batchSize);
+        vector<int> batchConfigIndices;
+        batchConfigIndices.reserve(batchSize);
+        vector<const HaarColumnCache::column*> batchCachedColumns(batchSize, NULL);
+        vector<HaarColumnCache::column> batchColumns( useCache ? batchSize : 0, HaarColumnCache::column(numExamples) );
+        vector< vector<FeatureReal> > batchThresholds( batchSize, vector<FeatureReal>(numClasses) );
+        vector<AlphaReal> batchAlphas(batchSize);
+        vector<AlphaReal> batchEnergies(batchSize);
+        vector< vector<AlphaReal> > batchVs( batchSize, vector<AlphaReal>(numClasses) ); // The class-wise votes/abstentions
                 
         // The declared features types
         vector<HaarFeature*>& loadedFeatures = pHaarData->getLoadedFeatures();
@@ -141,70 +167,115 @@ namespace MultiBoost {
                 cout << "Learning type " << pCurrFeature->getName() << ".." << flush;
                         
             // While there is a configuration available
-            while ( pCurrFeature->hasConfigs() ) 
+            while ( !quitConfiguration && pCurrFeature->hasConfigs() ) 
             {
-                // transform the data from intImages to the feature's space
-                pCurrFeature->fillHaarData(_pTrainingData->getExamples(), processedHaarData);
-                // sort the examples in the new space by their coordinate
-                sort( processedHaarData.begin(), processedHaarData.end(), 
-                      nor_utils::comparePair<2, int, float, less<float> >() );
+                // Collect the next batch, serially
+                batchConfigs.clear();
+                batchConfigIndices.clear();
+                while ( pCurrFeature->hasConfigs() && (int)batchConfigs.size() < batchSize )
+                {
+                    batchConfigs.push_back( pCurrFeature->getCurrentConfig() );
+                    batchConfigIndices.push_back( pCurrFeature->getLoadedConfigIndex() );
                                 
-                // find the optimal threshold
-                sAlgo.findMultiThresholdsWithInit(processedHaarData.begin(), processedHaarData.end(), 
-                                                  _pTrainingData, tmpThresholds, &mu, &tmpV);
+                    // Move to the next configuration
+                    pCurrFeature->moveToNextConfig();
                                 
-                tmpEnergy = getEnergy(mu, tmpAlpha, tmpV);
-                ++numProcessed;
+                    // check stopping criterion for random configurations
+                    if (_samplingType == ST_NUM)
+                    {
+                        ++numConf;
+                        if (numConf >= _samplingVal)
+                        {
+                            quitConfiguration = true;
+                            break;
+                        }
+                    }
+                    else if (_samplingType == ST_NO_SAMPLING)
+                        perror("ERROR: st no sampling... not sure what this means");
+                }
+
+                const int numBatchConfigs = (int)batchConfigs.size();
+
+                // the configurations visited before are taken from the cache
+                if (useCache)
+                {
+                    for (int k = 0; k < numBatchConfigs; ++k)
+                        batchCachedColumns[k] = columnCache.find( pCurrFeature->getType(), batchConfigIndices[k] );
+                }
+
+#pragma omp parallel for num_threads(numThreads) if (numThreads > 1) schedule(dynamic)
+                for (int k = 0; k < numBatchConfigs; ++k)
+                {
+                    const int t = nor_utils::getThreadIdx();
+                    const HaarColumnCache::column* pColumn = batchCachedColumns[k];
+
+                    if ( pColumn == NULL )
+                    {
+                        // with the cache, the misses are kept to be stored
+                        vector< pair<int, FeatureReal> >& haarData = 
+                            useCache ? batchColumns[k] : processedHaarData[t];
+
+                        // transform the data from intImages to the feature's space
+                        if (hasPixelMajorImages)
+                            pCurrFeature->fillHaarData( pHaarData, haarData, batchConfigs[k] );
+                        else
+                            pCurrFeature->fillHaarData( examples, haarData, batchConfigs[k] );
+                        // sort the examples in the new space by their coordinate
+                        sorters[t].sort( haarData );
+                        pColumn = &haarData;
+                    }
                                 
-                if (tmpEnergy < bestEnergy)
+                    // find the optimal threshold
+                    sAlgos[t].findMultiThresholdsWithInit(pColumn->begin(), pColumn->end(), 
+                                                          _pTrainingData, batchThresholds[k], 
+                                                          &mu[t], &batchVs[k]);
+                                
+                    batchEnergies[k] = getEnergy(mu[t], batchAlphas[k], batchVs[k]);
+                }
+
+                if (useCache)
+                {
+                    for (int k = 0; k < numBatchConfigs; ++k)
+                    {
+                        if ( batchCachedColumns[k] == NULL )
+                            columnCache.insert( pCurrFeature->getType(), batchConfigIndices[k], batchColumns[k] );
+                    }
+                }
+
+                // keep the first best configuration in the order of the iterator
+                for (int k = 0; k < numBatchConfigs; ++k)
                 {
-                    // Store it in the current weak hypothesis.
-                    // note: I don't really like having so many temp variables
-                    // but the alternative would be a structure, which would need
-                    // to be inheritable to make things more consistent. But this would
-                    // make it less flexible. Therefore, I am still undecided. This
-                    // might change!
-                    _alpha = tmpAlpha;
-                    _v = tmpV;
+                    if (batchEnergies[k] < bestEnergy)
+                    {
+                        // Store it in the current weak hypothesis.
+                        // note: I don't really like having so many temp variables
+                        // but the alternative would be a structure, which would need
+                        // to be inheritable to make things more consistent. But this would
+                        // make it less flexible. Therefore, I am still undecided. This
+                        // might change!
+                        _alpha = batchAlphas[k];
+                        _v = batchVs[k];
                                         
-                    // I need to save the configuration because it changes within the object
-                    _selectedConfig = pCurrFeature->getCurrentConfig();
-                    // I save the object because it contains the informations about the type,
-                    // the name, etc..
-                    _pSelectedFeature = pCurrFeature;
-                    _thresholds = tmpThresholds;
+                        // I need to save the configuration because it changes within the object
+                        _selectedConfig = batchConfigs[k];
+                        // I save the object because it contains the informations about the type,
+                        // the name, etc..
+                        _pSelectedFeature = pCurrFeature;
+                        _thresholds = batchThresholds[k];
                                         
-                    bestEnergy = tmpEnergy;
+                        bestEnergy = batchEnergies[k];
+                    }
                 }
+                numProcessed += numBatchConfigs;
                                 
-                // Move to the next configuration
-                pCurrFeature->moveToNextConfig();
-                                
-                // check stopping criterion for random configurations
-                switch (_samplingType)
-                {
-                case ST_NUM:
-                    ++numConf;
-                    if (numConf >= _samplingVal)
-                        quitConfiguration = true;
-                    break;
-                case ST_TIME:            
+                // check the time limit after every batch
+                if (_samplingType == ST_TIME)
                 {
                     time( &currentTime );
                     float diff = difftime(currentTime, startTime); // difftime is in seconds
                     if (diff >= _samplingVal)
                         quitConfiguration = true;
                 }
-                break;
-                case ST_NO_SAMPLING:
-                    perror("ERROR: st no sampling... not sure what this means");
-                                                
-                    break;
-                                                
-                } // end switch
-                                
-                if (quitConfiguration)
-                    break;
                                 
             } // end while
                         
@@ -229,7 +300,15 @@ namespace MultiBoost {
         else
         {
             if (_verbose > 1)
+            {
                 cout << "Selected type: " << _pSelectedFeature->getName() << endl;
+
+                if (useCache)
+                    cout << "Column cache: " << columnCache.getNumHits() << " hits, "
+                         << columnCache.getNumMisses() << " misses, "
+                         << columnCache.getNumColumns() << " columns ("
+                         << columnCache.getNumBytes() / (1024 * 1024) << " MB)" << endl;
+            }
         }
                 
         return bestEnergy;
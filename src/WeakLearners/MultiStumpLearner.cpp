@@ -33,11 +33,14 @@
 #include "MultiStumpLearner.h"
 
 #include "IO/Serialization.h"
+#include "IO/BinarySerialization.h"
 #include "IO/SortedData.h"
 
 #include "Algorithms/StumpAlgorithm.h"
 
 #include <limits> // for numeric_limits<>
+#include <algorithm> // for replace
+#include <typeinfo> // for typeid
 namespace MultiBoost {
         
 
@@ -54,6 +57,12 @@ namespace MultiBoost {
                              "(Turned off for Haar: use -csample instead)",
                              1, "<num>");
                 
+        args.declareArgument("bins",
+                             "Approximate stump search: each feature is quantized once into at most <num> "
+                             "bins (2..255), and the thresholds are searched on the per-bin histograms. "
+                             "Example: -bins 64 (default: exact search)",
+                             1, "<num>");
+                
     }
         
         
@@ -104,6 +113,10 @@ namespace MultiBoost {
         StumpAlgorithm<FeatureReal> sAlgo(numClasses);
         sAlgo.initSearchLoop(_pTrainingData);
                 
+        SortedData* pSortedData = static_cast<SortedData*>(_pTrainingData);
+        vector<AlphaReal> histogram; // for the binned search
+        vector<int> binCounts;
+                
         int numOfDimensions = _maxNumOfDimensions;
         for (int j = 0; j < numColumns; ++j) {
             // Tricky way to select numOfDimensions columns randomly out of numColumns
@@ -112,15 +125,26 @@ namespace MultiBoost {
                         
             if (static_cast<float> (numOfDimensions) / rest > r) {
                 --numOfDimensions;
-                const pair<vpIterator, vpIterator>
-                    dataBeginEnd =
-                    static_cast<SortedData*> (_pTrainingData)->getFilteredBeginEnd(j);
+                if ( pSortedData->isBinned() )
+                {
+                    // approximate search on the histogram of the column (--bins)
+                    pSortedData->getBinnedHistogram(j, histogram, binCounts);
+                    sAlgo.findMultiThresholdsBinned(histogram, binCounts,
+                                                    pSortedData->getBinLowerValues(j),
+                                                    pSortedData->getBinUpperValues(j),
+                                                    tmpThresholds, &mu, &tmpV);
+                }
+                else
+                {
+                    const pair<vpIterator, vpIterator>
+                        dataBeginEnd = pSortedData->getFilteredBeginEnd(j);
                                 
-                const vpIterator dataBegin = dataBeginEnd.first;
-                const vpIterator dataEnd = dataBeginEnd.second;
+                    const vpIterator dataBegin = dataBeginEnd.first;
+                    const vpIterator dataEnd = dataBeginEnd.second;
                                 
-                sAlgo.findMultiThresholdsWithInit(dataBegin, dataEnd,
-                                                  _pTrainingData, tmpThresholds, &mu, &tmpV);
+                    sAlgo.findMultiThresholdsWithInit(dataBegin, dataEnd,
+                                                      _pTrainingData, tmpThresholds, &mu, &tmpV);
+                }
                                 
                 for ( vector<sRates>::iterator itR = mu.begin(); itR != mu.end(); ++itR )
                 {
@@ -198,6 +222,35 @@ namespace MultiBoost {
         
     // -----------------------------------------------------------------------
         
+    bool MultiStumpLearner::saveBinary(BinaryHypothesis& hypothesis)
+    {
+        // the subclasses have their own state
+        if ( typeid(*this) != typeid(MultiStumpLearner) )
+            return false;
+                
+        hypothesis.type = BHT_MULTI_STUMP;
+        hypothesis.alpha = _alpha;
+        hypothesis.v = _v;
+        hypothesis.columns = _selectedColumnArray;
+        hypothesis.thresholds = _thresholds;
+        return true;
+    }
+        
+    // -----------------------------------------------------------------------
+        
+    void MultiStumpLearner::loadBinary(const BinaryHypothesis& hypothesis)
+    {
+        _alpha = hypothesis.alpha;
+        _v = hypothesis.v;
+        _selectedColumnArray = hypothesis.columns;
+        _thresholds = hypothesis.thresholds;
+                
+        // the classes that are not in the file get the default of load()
+        replace(_selectedColumnArray.begin(), _selectedColumnArray.end(), -1, 0);
+    }
+        
+    // -----------------------------------------------------------------------
+        
     void MultiStumpLearner::subCopyState(BaseLearner *pBaseLearner) {
         AbstainableLearner::subCopyState(pBaseLearner);
                 
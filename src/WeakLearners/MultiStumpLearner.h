@@ -153,6 +153,24 @@ namespace MultiBoost {
          * \date 13/11/2005
          */
         virtual void load(nor_utils::StreamTokenizer& st);
+
+        /**
+         * Save the hypothesis into a record of the binary strong hypothesis file.
+         * Each class has its own column and threshold.
+         * \param hypothesis The record to fill.
+         * \return false for the subclasses, that must be saved in xml.
+         * \see BaseLearner::saveBinary
+         * \date 16/10/2026
+         */
+        virtual bool saveBinary(BinaryHypothesis& hypothesis);
+
+        /**
+         * Load the hypothesis from a record of the binary strong hypothesis file.
+         * \param hypothesis The record, in the index space of the training data.
+         * \see saveBinary
+         * \date 16/10/2026
+         */
+        virtual void loadBinary(const BinaryHypothesis& hypothesis);
                 
         /**
          * Copy all the info we need in classify().
@@ -167,6 +185,12 @@ namespace MultiBoost {
          * \date 25/05/2007
          */
         virtual void subCopyState(BaseLearner *pBaseLearner);
+
+        //! The columns of the stumps, one per class.
+        const vector<int>& getSelectedColumns() const { return _selectedColumnArray; }
+
+        //! The thresholds of the stumps, one per class.
+        const vector<FeatureReal>& getThresholds() const { return _thresholds; }
                 
     protected:
         /**
@@ -36,6 +36,7 @@
 
 #include "IO/Serialization.h"
 #include "Others/Example.h"
+#include "Utils/Utils.h" // for getNumThreads
 
 #include <math.h>
 #include <limits>
@@ -51,6 +52,16 @@ namespace MultiBoost {
     string ParasiteLearner::_nameBaseLearnerFile = "";
     vector<BaseLearner*> ParasiteLearner::_baseLearners;
 
+    InputData* ParasiteLearner::_pPoolData = NULL;
+    unsigned long ParasiteLearner::_poolDataVersion = 0;
+    int ParasiteLearner::_numPoolLearners = 0;
+    int ParasiteLearner::_numPoolOutputs = 0;
+    int ParasiteLearner::_numPoolWords = 0;
+    vector<int> ParasiteLearner::_poolRows;
+    vector<uint64_t> ParasiteLearner::_poolNonZero;
+    vector<uint64_t> ParasiteLearner::_poolPositive;
+    vector<AlphaReal> ParasiteLearner::_poolValues;
+
 // -----------------------------------------------------------------------
 
     void ParasiteLearner::declareArguments(nor_utils::Args& args)
@@ -91,8 +102,165 @@ namespace MultiBoost {
 
 // ------------------------------------------------------------------------------
 
-    AlphaReal ParasiteLearner::run()
+    // the index of the lowest set bit of a non-zero word
+    static inline int getLowestBit(uint64_t word)
+    {
+#ifdef __GNUC__
+        return __builtin_ctzll(word);
+#else
+        int b = 0;
+        for ( ; !(word & 1); word >>= 1)
+            ++b;
+        return b;
+#endif
+    }
+
+// ------------------------------------------------------------------------------
+
+    void ParasiteLearner::computePoolOutputs()
+    {
+        const int numClasses = _pTrainingData->getNumClasses();
+        const int numExamples = _pTrainingData->getNumExamples();
+
+        _numPoolLearners = _numBaseLearners;
+        _numPoolOutputs = numExamples * numClasses;
+        _numPoolWords = (_numPoolOutputs + 63) / 64;
+
+        _poolRows.assign(_numPoolLearners, 0);
+        _poolNonZero.assign(static_cast<size_t>(_numPoolLearners) * _numPoolWords, 0);
+        _poolPositive.assign(static_cast<size_t>(_numPoolLearners) * _numPoolWords, 0);
+        _poolValues.clear();
+
+        const int numThreads = nor_utils::getNumThreads();
+
+#pragma omp parallel num_threads(numThreads) if (numThreads > 1)
+        {
+            vector<AlphaReal> outputs(_numPoolOutputs);
+
+#pragma omp for schedule(dynamic)
+            for (int j = 0; j < _numPoolLearners; ++j) {
+                bool isSign = true;
+                for (int i = 0; i < numExamples; ++i) {
+                    for (int l = 0; l < numClasses; ++l) {
+                        const AlphaReal h = _baseLearners[j]->classify(_pTrainingData, i, l);
+                        outputs[i * numClasses + l] = h;
+                        if ( h != 0 && h != 1 && h != -1 )
+                            isSign = false;
+                    }
+                }
+
+                if (isSign) {
+                    uint64_t* pNonZero = &_poolNonZero[ static_cast<size_t>(j) * _numPoolWords ];
+                    uint64_t* pPositive = &_poolPositive[ static_cast<size_t>(j) * _numPoolWords ];
+                    for (int k = 0; k < _numPoolOutputs; ++k) {
+                        const uint64_t bit = static_cast<uint64_t>(1) << (k & 63);
+                        if (outputs[k] != 0)
+                            pNonZero[k >> 6] |= bit;
+                        if (outputs[k] > 0)
+                            pPositive[k >> 6] |= bit;
+                    }
+                    _poolRows[j] = j;
+                }
+                else {
+#pragma omp critical (poolValues)
+                    {
+                        _poolRows[j] = -1 - static_cast<int>(_poolValues.size() / _numPoolOutputs);
+                        _poolValues.insert(_poolValues.end(), outputs.begin(), outputs.end());
+                    }
+                }
+            }
+        }
+
+        _pPoolData = _pTrainingData;
+        _poolDataVersion = _pTrainingData->getVersion();
+    }
+
+// ------------------------------------------------------------------------------
+
+    AlphaReal ParasiteLearner::getPoolOutput(int j, int k)
+    {
+        const int row = _poolRows[j];
+        if (row < 0)
+            return _poolValues[ static_cast<size_t>(-1 - row) * _numPoolOutputs + k ];
+
+        const size_t w = static_cast<size_t>(row) * _numPoolWords + (k >> 6);
+        const uint64_t bit = static_cast<uint64_t>(1) << (k & 63);
+        if ( !(_poolNonZero[w] & bit) )
+            return 0;
+        return (_poolPositive[w] & bit) ? 1 : -1;
+    }
+
+// ------------------------------------------------------------------------------
+
+    float ParasiteLearner::getPoolEdge(int j, const vector<AlphaReal>& weights, const vector<char>& ys,
+                                       const vector<AlphaReal>& weightedLabels) const
     {
+        float sumGamma = 0;
+        const int row = _poolRows[j];
+
+        if (row < 0) {
+            const AlphaReal* pValues = &_poolValues[ static_cast<size_t>(-1 - row) * _numPoolOutputs ];
+            for (int k = 0; k < _numPoolOutputs; ++k)
+                sumGamma += weights[k] * pValues[k] * ys[k];
+            return sumGamma;
+        }
+
+        // blocks of 64 outputs, only the non-zero ones count: w * h * y = +-w * y
+        const uint64_t* pNonZero = &_poolNonZero[ static_cast<size_t>(row) * _numPoolWords ];
+        const uint64_t* pPositive = &_poolPositive[ static_cast<size_t>(row) * _numPoolWords ];
+        for (int w = 0; w < _numPoolWords; ++w) {
+            const AlphaReal* pWeightedLabels = &weightedLabels[w * 64];
+            const uint64_t positive = pPositive[w];
+            for (uint64_t nonZero = pNonZero[w]; nonZero; nonZero &= nonZero - 1) {
+                const int b = getLowestBit(nonZero);
+                if ( (positive >> b) & 1 )
+                    sumGamma += pWeightedLabels[b];
+                else
+                    sumGamma -= pWeightedLabels[b];
+            }
+        }
+        return sumGamma;
+    }
+
+// ------------------------------------------------------------------------------
+
+    void ParasiteLearner::getPoolRates(int j, const vector<AlphaReal>& weights, const vector<char>& ys,
+                                       const vector<uint64_t>& positiveLabels, float& epsMin, float& epsPls) const
+    {
+        epsPls = epsMin = 0;
+        const int row = _poolRows[j];
+
+        if (row < 0) {
+            const AlphaReal* pValues = &_poolValues[ static_cast<size_t>(-1 - row) * _numPoolOutputs ];
+            for (int k = 0; k < _numPoolOutputs; ++k) {
+                const float gamma = pValues[k] * ys[k];
+                if ( gamma > 0 )
+                    epsPls += weights[k];
+                else if ( gamma < 0 )
+                    epsMin += weights[k];
+            }
+            return;
+        }
+
+        // h * y > 0 where the sign of h is the sign of y
+        const uint64_t* pNonZero = &_poolNonZero[ static_cast<size_t>(row) * _numPoolWords ];
+        const uint64_t* pPositive = &_poolPositive[ static_cast<size_t>(row) * _numPoolWords ];
+        for (int w = 0; w < _numPoolWords; ++w) {
+            const AlphaReal* pWeights = &weights[0] + w * 64;
+            const uint64_t differ = pPositive[w] ^ positiveLabels[w];
+            for (uint64_t correct = pNonZero[w] & ~differ; correct; correct &= correct - 1)
+                epsPls += pWeights[ getLowestBit(correct) ];
+            for (uint64_t wrong = pNonZero[w] & differ; wrong; wrong &= wrong - 1)
+                epsMin += pWeights[ getLowestBit(wrong) ];
+        }
+    }
+
+// ------------------------------------------------------------------------------
+
+    void ParasiteLearner::initPool(InputData* pData)
+    {
+        setTrainingData(pData);
+
         if (_baseLearners.size() == 0) {
             // load the base learners
             if (_verbose >= 2)
@@ -105,143 +273,214 @@ namespace MultiBoost {
    
         if ( _numBaseLearners == -1 || _numBaseLearners > _baseLearners.size())
             _numBaseLearners = _baseLearners.size();
-   
+
+        // the outputs of the pool are computed once per training set, and again
+        // every time the examples in use change (filtering, new examples)
+        if ( _pPoolData != _pTrainingData || _poolDataVersion != _pTrainingData->getVersion() ||
+             _numPoolLearners != _numBaseLearners )
+            computePoolOutputs();
+    }
+
+// ------------------------------------------------------------------------------
+
+    AlphaReal ParasiteLearner::run()
+    {
+        // This is the bottleneck, squeeze out every microsecond:
+        // the outputs of the pool are computed once per training set
+        initPool(_pTrainingData);
    
         const int numClasses = _pTrainingData->getNumClasses();
         const int numExamples = _pTrainingData->getNumExamples();
-        float tmpAlpha;
-        float bestE = numeric_limits<float>::max();
-        float sumGamma, bestSumGamma = -numeric_limits<float>::max();
-        float tmpE, gamma;
         float eps_min,eps_pls;
-        int tmpSignOfAlpha;
 
-        // This is the bottleneck, squeeze out every microsecond
+        // the weights and the labels, example-major as the outputs of the pool
+        const int numOutputs = numExamples * numClasses;
+        vector<AlphaReal> weights(_numPoolWords * 64, 0);
+        vector<AlphaReal> weightedLabels(_numPoolWords * 64, 0);
+        vector<char> ys(numOutputs);
+        vector<uint64_t> positiveLabels(_numPoolWords, 0);
+        for (int i = 0; i < numExamples; ++i) {
+            const vector<Label>& labels = _pTrainingData->getLabels(i);
+            for (int l = 0; l < numClasses; ++l) {
+                const int k = i * numClasses + l;
+                weights[k] = labels[l].weight;
+                ys[k] = labels[l].y;
+                weightedLabels[k] = labels[l].weight * labels[l].y;
+                if ( labels[l].y > 0 )
+                    positiveLabels[k >> 6] |= static_cast<uint64_t>(1) << (k & 63);
+            }
+        }
+
+        // the learners of the pool are independent
+        const int numThreads = nor_utils::getNumThreads();
+
+        if ( nor_utils::is_zero(_theta) ) {
+            _poolEdges.resize(_numBaseLearners);
+#pragma omp parallel for num_threads(numThreads) if (numThreads > 1) schedule(dynamic, 64)
+            for (int j = 0; j < _numBaseLearners; ++j)
+                _poolEdges[j] = getPoolEdge(j, weights, ys, weightedLabels);
+
+            selectByEdge();
+            getPoolRates(_selectedIdx, weights, ys, positiveLabels, eps_min, eps_pls);
+            return setAlphaByRates(eps_min, eps_pls);
+        }
+        else {
+            _poolEpsMin.resize(_numBaseLearners);
+            _poolEpsPls.resize(_numBaseLearners);
+#pragma omp parallel for num_threads(numThreads) if (numThreads > 1) schedule(dynamic, 64)
+            for (int j = 0; j < _numBaseLearners; ++j)
+                getPoolRates(j, weights, ys, positiveLabels, _poolEpsMin[j], _poolEpsPls[j]);
+
+            return selectByRates();
+        }
+    }
+
+// ------------------------------------------------------------------------------
+
+    AlphaReal ParasiteLearner::runOnExample(int idx, const vector<AlphaReal>& weights, const vector<char>& ys)
+    {
+        const int numClasses = static_cast<int>( weights.size() );
+        const int firstOutput = idx * numClasses;
+        float eps_min, eps_pls;
+
+        // as a new learner: if no learner is above the edge offset, alpha is zero
+        _alpha = 0;
+        _signOfAlpha = 1;
+
+        // the same sums as getPoolEdge() and getPoolRates(), restricted to the example
+        if ( nor_utils::is_zero(_theta) ) {
+            _poolEdges.resize(_numBaseLearners);
+            for (int j = 0; j < _numBaseLearners; ++j) {
+                float sumGamma = 0;
+                for (int l = 0; l < numClasses; ++l) {
+                    const AlphaReal h = getPoolOutput(j, firstOutput + l);
+                    if ( h != 0 )
+                        sumGamma += weights[l] * h * ys[l];
+                }
+                _poolEdges[j] = sumGamma;
+            }
+
+            selectByEdge();
+            getExampleRates(_selectedIdx, firstOutput, weights, ys, eps_min, eps_pls);
+            return setAlphaByRates(eps_min, eps_pls);
+        }
+        else {
+            _poolEpsMin.resize(_numBaseLearners);
+            _poolEpsPls.resize(_numBaseLearners);
+            for (int j = 0; j < _numBaseLearners; ++j)
+                getExampleRates(j, firstOutput, weights, ys, _poolEpsMin[j], _poolEpsPls[j]);
+
+            return selectByRates();
+        }
+    }
+
+// ------------------------------------------------------------------------------
+
+    void ParasiteLearner::getExampleRates(int j, int firstOutput, const vector<AlphaReal>& weights,
+                                          const vector<char>& ys, float& epsMin, float& epsPls) const
+    {
+        epsPls = epsMin = 0;
+        for (int l = 0; l < static_cast<int>( weights.size() ); ++l) {
+            const float gamma = getPoolOutput(j, firstOutput + l) * ys[l];
+            if ( gamma > 0 )
+                epsPls += weights[l];
+            else if ( gamma < 0 )
+                epsMin += weights[l];
+        }
+    }
+
+// ------------------------------------------------------------------------------
+
+    void ParasiteLearner::selectByEdge()
+    {
+        float sumGamma, bestSumGamma;
+        _selectedIdx = 0;
+
         if (_closed) {
             bestSumGamma = 0;
-            if ( nor_utils::is_zero(_theta) ) {
-                for (int j = 0; j < _numBaseLearners; ++j) {
-                    sumGamma = 0;
-                    for (int i = 0; i < numExamples; ++i) {
-                        vector<Label> labels = _pTrainingData->getLabels(i);
-                        for (int l = 0; l < numClasses; ++l)
-                            sumGamma += labels[l].weight * 
-                                _baseLearners[j]->classify(_pTrainingData,i,l) * labels[l].y;
-                    }
-                    if (fabs(sumGamma) > fabs(bestSumGamma)) {
-                        _selectedIdx = j;
-                        bestSumGamma = sumGamma;
-                    }
+            for (int j = 0; j < _numBaseLearners; ++j) {
+                sumGamma = _poolEdges[j];
+                if (fabs(sumGamma) > fabs(bestSumGamma)) {
+                    _selectedIdx = j;
+                    bestSumGamma = sumGamma;
                 }
-                eps_pls = eps_min = 0;
-                for (int i = 0; i < numExamples; ++i) {
-                    vector<Label> labels = _pTrainingData->getLabels(i);
-                    for (int l = 0; l < numClasses; ++l) {
-                        gamma = _baseLearners[_selectedIdx]->classify(_pTrainingData,i,l) *
-                            labels[l].y;
-                        if ( gamma > 0 )
-                            eps_pls += labels[l].weight;
-                        else if ( gamma < 0 )
-                            eps_min += labels[l].weight;
-                    }
+            }
+        }
+        else {
+            bestSumGamma = -numeric_limits<float>::max();
+            for (int j = 0; j < _numBaseLearners; ++j) {
+                sumGamma = _poolEdges[j];
+                if (sumGamma > bestSumGamma) {
+                    _selectedIdx = j;
+                    bestSumGamma = sumGamma;
                 }
+            }
+        }
+    }
+
+// ------------------------------------------------------------------------------
+
+    AlphaReal ParasiteLearner::setAlphaByRates(float eps_min, float eps_pls)
+    {
+        if (_closed && eps_min > eps_pls) {
+            float tmpSwap = eps_min;
+            eps_min = eps_pls;
+            eps_pls = tmpSwap;
+            _signOfAlpha = -1;
+        }
+        _alpha = getAlpha(eps_min, eps_pls);
+        const float bestE = BaseLearner::getEnergy( eps_min, eps_pls );
+        return bestE;
+    }
+
+// ------------------------------------------------------------------------------
+
+    AlphaReal ParasiteLearner::selectByRates()
+    {
+        float tmpAlpha;
+        float bestE = numeric_limits<float>::max();
+        float tmpE;
+        float eps_min,eps_pls;
+        int tmpSignOfAlpha;
+        _selectedIdx = 0;
+
+        if (_closed) {
+            for (int j = 0; j < _numBaseLearners; ++j) {
+                eps_min = _poolEpsMin[j];
+                eps_pls = _poolEpsPls[j];
                 if (eps_min > eps_pls) {
                     float tmpSwap = eps_min;
                     eps_min = eps_pls;
                     eps_pls = tmpSwap;
-                    _signOfAlpha = -1;
+                    tmpSignOfAlpha = -1;
                 }
-                _alpha = getAlpha(eps_min, eps_pls);
-                bestE = BaseLearner::getEnergy( eps_min, eps_pls );
-            }
-            else {
-                for (int j = 0; j < _numBaseLearners; ++j) {
-                    eps_pls = eps_min = 0;
-                    for (int i = 0; i < numExamples; ++i) {
-                        vector<Label> labels = _pTrainingData->getLabels(i);
-                        for (int l = 0; l < numClasses; ++l) {
-                            gamma = _baseLearners[j]->classify(_pTrainingData,i,l) * labels[l].y;
-                            if ( gamma > 0 )
-                                eps_pls += labels[l].weight;
-                            else if ( gamma < 0 )
-                                eps_min += labels[l].weight;
-                        }
-                    }
-                    if (eps_min > eps_pls) {
-                        float tmpSwap = eps_min;
-                        eps_min = eps_pls;
-                        eps_pls = tmpSwap;
-                        tmpSignOfAlpha = -1;
-                    }
-                    else
-                        tmpSignOfAlpha = 1;
-                    tmpAlpha = getAlpha(eps_min, eps_pls, _theta);
-                    tmpE = BaseLearner::getEnergy( eps_min, eps_pls, tmpAlpha, _theta );
-                    if (tmpE < bestE && eps_pls > eps_min + _theta) {
-                        _alpha = tmpAlpha;
-                        _selectedIdx = j;
-                        _signOfAlpha = tmpSignOfAlpha;
-                        bestE = tmpE;
-                    }
+                else
+                    tmpSignOfAlpha = 1;
+                tmpAlpha = getAlpha(eps_min, eps_pls, _theta);
+                tmpE = BaseLearner::getEnergy( eps_min, eps_pls, tmpAlpha, _theta );
+                if (tmpE < bestE && eps_pls > eps_min + _theta) {
+                    _alpha = tmpAlpha;
+                    _selectedIdx = j;
+                    _signOfAlpha = tmpSignOfAlpha;
+                    bestE = tmpE;
                 }
             }
         }
         else {
-            if ( nor_utils::is_zero(_theta) ) {
-                for (int j = 0; j < _numBaseLearners; ++j) {
-                    sumGamma = 0;
-                    for (int i = 0; i < numExamples; ++i) {
-                        vector<Label> labels = _pTrainingData->getLabels(i);
-                        for (int l = 0; l < numClasses; ++l)
-                            sumGamma += labels[l].weight * 
-                                _baseLearners[j]->classify(_pTrainingData,i,l) * labels[l].y;
-                    }
-                    if (sumGamma > bestSumGamma) {
-                        _selectedIdx = j;
-                        bestSumGamma = sumGamma;
-                    }
-                }
-                eps_pls = eps_min = 0;
-                for (int i = 0; i < numExamples; ++i) {
-                    vector<Label> labels = _pTrainingData->getLabels(i);
-                    for (int l = 0; l < numClasses; ++l) {
-                        gamma = _baseLearners[_selectedIdx]->classify(_pTrainingData,i,l) *
-                            labels[l].y;
-                        if ( gamma > 0 )
-                            eps_pls += labels[l].weight;
-                        else if ( gamma < 0 )
-                            eps_min += labels[l].weight;
-                    }
-                }
-                _alpha = getAlpha(eps_min, eps_pls);
-                bestE = BaseLearner::getEnergy( eps_min, eps_pls );
-            }
-            else {
-                for (int j = 0; j < _numBaseLearners; ++j) {
-                    eps_pls = eps_min = 0;
-                    for (int i = 0; i < numExamples; ++i) {
-                        vector<Label> labels = _pTrainingData->getLabels(i);
-                        for (int l = 0; l < numClasses; ++l) {
-                            gamma = _baseLearners[j]->classify(_pTrainingData,i,l) * labels[l].y;
-                            if ( gamma > 0 )
-                                eps_pls += labels[l].weight;
-                            else if ( gamma < 0 )
-                                eps_min += labels[l].weight;
-                        }
-                    }
-                    tmpAlpha = getAlpha(eps_min, eps_pls, _theta);
-                    tmpE = BaseLearner::getEnergy( eps_min, eps_pls, tmpAlpha, _theta );
-                    if (tmpE < bestE && eps_pls > eps_min + _theta) {
-                        _alpha = tmpAlpha;
-                        _selectedIdx = j;
-                        bestE = tmpE;
-                    }
-                    //cout << j << ": e- = " << eps_min << "\t e+ = " << eps_pls << "\t edge = " << (eps_pls - eps_min) << "\t energy = " << tmpE << "\t energy* = " << bestE << "\t alpha = " << tmpAlpha << endl << flush;
+            for (int j = 0; j < _numBaseLearners; ++j) {
+                eps_min = _poolEpsMin[j];
+                eps_pls = _poolEpsPls[j];
+                tmpAlpha = getAlpha(eps_min, eps_pls, _theta);
+                tmpE = BaseLearner::getEnergy( eps_min, eps_pls, tmpAlpha, _theta );
+                if (tmpE < bestE && eps_pls > eps_min + _theta) {
+                    _alpha = tmpAlpha;
+                    _selectedIdx = j;
+                    bestE = tmpE;
                 }
+                //cout << j << ": e- = " << eps_min << "\t e+ = " << eps_pls << "\t edge = " << (eps_pls - eps_min) << "\t energy = " << tmpE << "\t energy* = " << bestE << "\t alpha = " << tmpAlpha << endl << flush;
             }
         }
         return bestE;
-   
     }
 
 // -----------------------------------------------------------------------
@@ -46,6 +46,7 @@
 #include <vector>
 #include <fstream>
 #include <string>
+#include <stdint.h> // for uint64_t
 
 using namespace std;
 
@@ -177,12 +178,133 @@ namespace MultiBoost {
          */
         const vector<BaseLearner*>& getBaseLearners() const { return _baseLearners; }
 
+        /**
+         * Set the training data, load the pool if it is not loaded yet, and
+         * compute the outputs of the pool on the data if they are not available.
+         * It is called by run(), and once by the --encode engine before 
+         * runOnExample().
+         * \param pData The training data.
+         * \date 16/10/2026
+         */
+        void initPool(InputData* pData);
+
+        /**
+         * Run the learner on a single example of the data given to initPool(), with 
+         * its own weights. The result (selected learner, alpha and its sign) is the
+         * same as run() on a data set that contains only this example, but the 
+         * outputs of the pool are read from the precomputed ones, and nothing is 
+         * shared but the pool, so the examples can be encoded in parallel with one
+         * learner per thread.
+         * \param idx The index of the example.
+         * \param weights The weights of the classes of the example.
+         * \param ys The labels of the classes of the example.
+         * \return The energy of the weak classifier.
+         * \see DataEncoder
+         * \date 16/10/2026
+         */
+        AlphaReal runOnExample(int idx, const vector<AlphaReal>& weights, const vector<char>& ys);
+
+        /**
+         * The precomputed output h_j(x_i, l) of a learner of the pool.
+         * \param j The index of the learner in the pool.
+         * \param k The index of the output: i * numClasses + l.
+         * \date 16/10/2026
+         */
+        static AlphaReal getPoolOutput(int j, int k);
+
     protected:
 
+        /**
+         * Select the learner of the pool with the best edge (in _poolEdges), the 
+         * one with the largest absolute edge if the set is closed.
+         * \date 16/10/2026
+         */
+        void selectByEdge();
+
+        /**
+         * Set alpha (and its sign if the set is closed) from the rates of the 
+         * selected learner.
+         * \param eps_min The weight of the errors.
+         * \param eps_pls The weight of the correct classifications.
+         * \return The energy.
+         * \date 16/10/2026
+         */
+        AlphaReal setAlphaByRates(float eps_min, float eps_pls);
+
+        /**
+         * Select the learner of the pool with the lowest energy with the edge offset
+         * theta, from the rates in _poolEpsMin and _poolEpsPls, and set alpha.
+         * \return The energy.
+         * \date 16/10/2026
+         */
+        AlphaReal selectByRates();
+
+        /**
+         * The rates of a learner of the pool on a single example, see getPoolRates().
+         * \param j The index of the learner in the pool.
+         * \param firstOutput The index of the first output of the example.
+         * \param weights The weights of the classes of the example.
+         * \param ys The labels of the classes of the example.
+         * \param epsMin The weight of the errors.
+         * \param epsPls The weight of the correct classifications.
+         * \date 16/10/2026
+         */
+        void getExampleRates(int j, int firstOutput, const vector<AlphaReal>& weights,
+                             const vector<char>& ys, float& epsMin, float& epsPls) const;
+
+        /**
+         * Compute the outputs of the first _numBaseLearners learners of the pool on
+         * each example and class of the training data, in parallel across the pool.
+         * The learners with outputs in {-1,0,+1} (the stumps) are bit-packed into
+         * two planes (non-zero and positive), the others are stored as they are.
+         * \date 16/10/2026
+         */
+        void computePoolOutputs();
+
+        /**
+         * The edge sum_{i,l} w_{i,l} h_j(x_i,l) y_{i,l} of a learner of the pool,
+         * summed in the order of the examples and classes.
+         * \param j The index of the learner in the pool.
+         * \param weights The weights w, example-major.
+         * \param ys The labels y, example-major.
+         * \param weightedLabels w * y, example-major.
+         * \date 16/10/2026
+         */
+        float getPoolEdge(int j, const vector<AlphaReal>& weights, const vector<char>& ys,
+                          const vector<AlphaReal>& weightedLabels) const;
+
+        /**
+         * The weights of the examples and classes that a learner of the pool classifies
+         * correctly (h * y > 0) and incorrectly (h * y < 0).
+         * \param j The index of the learner in the pool.
+         * \param weights The weights w, example-major.
+         * \param ys The labels y, example-major.
+         * \param positiveLabels The bits of y > 0, packed as the sign planes.
+         * \param epsMin The weight of the errors.
+         * \param epsPls The weight of the correct classifications.
+         * \date 16/10/2026
+         */
+        void getPoolRates(int j, const vector<AlphaReal>& weights, const vector<char>& ys,
+                          const vector<uint64_t>& positiveLabels, float& epsMin, float& epsPls) const;
+
         static int _numBaseLearners; //!< the user specified number of base learners
         static string _nameBaseLearnerFile; //!< the name of the shyp file with the pool
         static vector<BaseLearner*> _baseLearners; //!< the pool of base learners
 
+        static InputData* _pPoolData; //!< the data the outputs of the pool were computed on
+        static unsigned long _poolDataVersion; //!< the version of _pPoolData when the outputs were computed
+        static int _numPoolLearners; //!< the number of learners of the pool with outputs
+        static int _numPoolOutputs; //!< numExamples * numClasses of _pPoolData
+        static int _numPoolWords; //!< the number of 64 bit words of a row of the sign planes
+        static vector<int> _poolRows; //!< the row of each learner in the sign planes, or -1 - its row in _poolValues
+        static vector<uint64_t> _poolNonZero; //!< the sign planes: h(x,l) != 0
+        static vector<uint64_t> _poolPositive; //!< the sign planes: h(x,l) > 0
+        static vector<AlphaReal> _poolValues; //!< the outputs of the learners that are not in {-1,0,+1}
+
+
+        vector<float> _poolEdges; //!< the edges of the learners of the pool
+        vector<float> _poolEpsMin; //!< the weights of the errors of the learners of the pool
+        vector<float> _poolEpsPls; //!< the weights of the correct classifications of the learners of the pool
 
         int _selectedIdx; //!< the index of the selected base learner
         int _signOfAlpha; //!< to close the set over multiplication by -1
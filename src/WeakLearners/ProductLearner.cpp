@@ -119,6 +119,11 @@ namespace MultiBoost {
             _savedLabels.push_back(exampleLabels);
         }
 
+        // the signs of the labels are changed below, so the y * weight matrix
+        // cannot be used by the base learners
+        const bool hasWeightedLabels = _pTrainingData->hasWeightedLabels();
+        _pTrainingData->clearWeightedLabels();
+
         for(int ib = 0; ib < _numBaseLearners; ++ib)
             _baseLearners[ib]->setTrainingData(_pTrainingData);
 
@@ -222,6 +227,8 @@ namespace MultiBoost {
             for (int l = 0; l < numClasses; ++l)
                 labels[l].y = _savedLabels[i][l];
         }
+        if ( hasWeightedLabels )
+            _pTrainingData->updateWeightedLabels();
 
         _id = _baseLearners[0]->getId();
         for(int ib = 1; ib < _numBaseLearners; ++ib)
@@ -34,12 +34,15 @@
 #include "SingleStumpLearner.h"
 
 #include "IO/Serialization.h"
+#include "IO/BinarySerialization.h"
 #include "IO/SortedData.h"
 #include "Algorithms/StumpAlgorithm.h"
 #include "Algorithms/ConstantAlgorithm.h"
+#include "Utils/Utils.h" // for getNumThreads
 
 #include <limits> // for numeric_limits<>
 #include <sstream> // for _id
+#include <typeinfo> // for typeid
 
 namespace MultiBoost {
         
@@ -57,50 +60,93 @@ namespace MultiBoost {
         // when theta=0.
         setSmoothingVal( 1.0 / (AlphaReal)_pTrainingData->getNumExamples() * 0.01 );
                 
-        vector<sRates> mu(numClasses); // The class-wise rates. See BaseLearner::sRates for more info.
-        vector<AlphaReal> tmpV(numClasses); // The class-wise votes/abstentions
-                
-        FeatureReal tmpThreshold;
-        AlphaReal tmpAlpha;
-                
-        AlphaReal bestEnergy = numeric_limits<AlphaReal>::max();
-        AlphaReal tmpEnergy;
-                
-        StumpAlgorithm<FeatureReal> sAlgo(numClasses);
-        sAlgo.initSearchLoop(_pTrainingData);
-                
         AlphaReal halfTheta;
         if ( _abstention == ABST_REAL || _abstention == ABST_CLASSWISE )
             halfTheta = _theta/2.0;
         else
             halfTheta = 0;
                 
+        // Tricky way to select numOfDimensions columns randomly out of numColumns.
+        // The columns are drawn before the search, so the sequence of rand() calls
+        // does not depend on the number of threads.
+        vector<int> columns;
         int numOfDimensions = _maxNumOfDimensions;
         for (int j = 0; j < numColumns; ++j)
         {
-            // Tricky way to select numOfDimensions columns randomly out of numColumns
             int rest = numColumns - j;
             float r = rand()/static_cast<float>(RAND_MAX);
                         
             if ( static_cast<float>(numOfDimensions) / rest > r ) 
             {
                 --numOfDimensions;
-                //if ( static_cast<SortedData*>(_pTrainingData)->isAttributeEmpty( j ) ) continue;
+                columns.push_back(j);
+            }
+        }
+        const int numSelectedColumns = static_cast<int>(columns.size());
+                
+        SortedData* pSortedData = static_cast<SortedData*>(_pTrainingData);
                 
-                const pair<pair<vpIterator,vpIterator>,
-                           pair<vpReverseIterator,vpReverseIterator> > dataSR = 
-                    static_cast<SortedData*>(_pTrainingData)->getFilteredandReverseBeginEnd(j);
+        StumpAlgorithm<FeatureReal> initAlgo(numClasses);
+        initAlgo.initSearchLoop(_pTrainingData);
                 
-                const vpIterator dataBegin = dataSR.first.first;
-                const vpIterator dataEnd = dataSR.first.second;
-                const vpReverseIterator dataReverseBegin = dataSR.second.first;
-                const vpReverseIterator dataReverseEnd = dataSR.second.second;
+        // The best stump found by each thread. They are reduced below on
+        // (energy, column index), so the result is the same as the serial scan.
+        const int numThreads = nor_utils::getNumThreads();
+        vector<AlphaReal> bestEnergies(numThreads, numeric_limits<AlphaReal>::max());
+        vector<int> bestColumns(numThreads, -1);
+        vector<FeatureReal> bestThresholds(numThreads);
+        vector<AlphaReal> bestAlphas(numThreads);
+        vector< vector<AlphaReal> > bestVs(numThreads);
                 
-                FeatureReal mostFrequentFeatureValue = _pTrainingData->getMostFrequentValuePerFeature()[j];
+#pragma omp parallel num_threads(numThreads) if (numThreads > 1)
+        {
+            const int t = nor_utils::getThreadIdx();
+                        
+            // every thread owns its scratch buffers and its filtered column
+            StumpAlgorithm<FeatureReal> sAlgo(initAlgo);
+            SortedData::column filteredColumn;
+            vector<AlphaReal> histogram; // for the binned search
+            vector<int> binCounts;
+                        
+            vector<sRates> mu(numClasses); // The class-wise rates. See BaseLearner::sRates for more info.
+            vector<AlphaReal> tmpV(numClasses); // The class-wise votes/abstentions
+                        
+            FeatureReal tmpThreshold;
+            AlphaReal tmpAlpha;
+            AlphaReal tmpEnergy;
+                        
+#pragma omp for schedule(dynamic)
+            for (int k = 0; k < numSelectedColumns; ++k)
+            {
+                const int j = columns[k];
+                //if ( static_cast<SortedData*>(_pTrainingData)->isAttributeEmpty( j ) ) continue;
                 
-                // also sets mu, tmpV, and bestHalfEdge
-                tmpThreshold = sAlgo.findSingleThresholdWithInit(dataBegin, dataEnd, dataReverseBegin, dataReverseEnd,
-                                                                 _pTrainingData, halfTheta, &mu, &tmpV,mostFrequentFeatureValue);
+                if ( pSortedData->isBinned() )
+                {
+                    // approximate search on the histogram of the column (--bins)
+                    pSortedData->getBinnedHistogram(j, histogram, binCounts);
+                    tmpThreshold = sAlgo.findSingleThresholdBinned(histogram, binCounts,
+                                                                   pSortedData->getBinLowerValues(j), 
+                                                                   pSortedData->getBinUpperValues(j),
+                                                                   halfTheta, &mu, &tmpV);
+                }
+                else
+                {
+                    const pair<pair<vpIterator,vpIterator>,
+                               pair<vpReverseIterator,vpReverseIterator> > dataSR = 
+                        pSortedData->getFilteredandReverseBeginEnd(j, filteredColumn);
+                    
+                    const vpIterator dataBegin = dataSR.first.first;
+                    const vpIterator dataEnd = dataSR.first.second;
+                    const vpReverseIterator dataReverseBegin = dataSR.second.first;
+                    const vpReverseIterator dataReverseEnd = dataSR.second.second;
+                    
+                    FeatureReal mostFrequentFeatureValue = _pTrainingData->getMostFrequentValuePerFeature()[j];
+                    
+                    // also sets mu, tmpV, and bestHalfEdge
+                    tmpThreshold = sAlgo.findSingleThresholdWithInit(dataBegin, dataEnd, dataReverseBegin, dataReverseEnd,
+                                                                     _pTrainingData, halfTheta, &mu, &tmpV,mostFrequentFeatureValue);
+                }
                                 
                 if (tmpThreshold == tmpThreshold) // tricky way to test Nan
                 { 
@@ -109,26 +155,43 @@ namespace MultiBoost {
                     // fast) but here (among dimensions) we minimize the energy.
                     tmpEnergy = getEnergy(mu, tmpAlpha, tmpV);
                                         
-                    if (tmpEnergy < bestEnergy && tmpAlpha > 0)
+                    if (tmpEnergy < bestEnergies[t] && tmpAlpha > 0)
                     {
-                        // Store it in the current weak hypothesis.
-                        // note: I don't really like having so many temp variables
-                        // but the alternative would be a structure, which would need
-                        // to be inheritable to make things more consistent. But this would
-                        // make it less flexible. Therefore, I am still undecided. This
-                        // might change!
-                                                
-                        _alpha = tmpAlpha;
-                        _v = tmpV;
-                        _selectedColumn = j;
-                        _threshold = tmpThreshold;
-                                                
-                        bestEnergy = tmpEnergy;
+                        bestEnergies[t] = tmpEnergy;
+                        bestColumns[t] = j;
+                        bestThresholds[t] = tmpThreshold;
+                        bestAlphas[t] = tmpAlpha;
+                        bestVs[t] = tmpV;
                     }
                 } // tmpThreshold == tmpThreshold
             }
         }
                 
+        // Store the best one in the current weak hypothesis.
+        // On equal energies the smallest column wins, as in the serial scan.
+        AlphaReal bestEnergy = numeric_limits<AlphaReal>::max();
+        int bestThread = -1;
+        for (int t = 0; t < numThreads; ++t)
+        {
+            if ( bestColumns[t] == -1 )
+                continue;
+                        
+            if ( bestThread == -1 || bestEnergies[t] < bestEnergy ||
+                 ( bestEnergies[t] == bestEnergy && bestColumns[t] < bestColumns[bestThread] ) )
+            {
+                bestEnergy = bestEnergies[t];
+                bestThread = t;
+            }
+        }
+                
+        if ( bestThread != -1 )
+        {
+            _alpha = bestAlphas[bestThread];
+            _v = bestVs[bestThread];
+            _selectedColumn = bestColumns[bestThread];
+            _threshold = bestThresholds[bestThread];
+        }
+                
         if ( _selectedColumn != -1 )
         {
             stringstream thresholdString;
@@ -334,6 +397,47 @@ namespace MultiBoost {
         thresholdString << _threshold;
         _id = _id + thresholdString.str();
     }
+
+    // -----------------------------------------------------------------------
+
+    bool SingleStumpLearner::saveBinary(BinaryHypothesis& hypothesis)
+    {
+        // the subclasses have their own state
+        if ( typeid(*this) != typeid(SingleStumpLearner) )
+            return false;
+
+        const int numClasses = static_cast<int>(_v.size());
+        hypothesis.type = BHT_SINGLE_STUMP;
+        hypothesis.alpha = _alpha;
+        hypothesis.v = _v;
+        hypothesis.columns.assign(numClasses, _selectedColumn);
+        hypothesis.thresholds.assign(numClasses, _threshold);
+        return true;
+    }
+
+    // -----------------------------------------------------------------------
+
+    void SingleStumpLearner::loadBinary(const BinaryHypothesis& hypothesis)
+    {
+        _alpha = hypothesis.alpha;
+        _v = hypothesis.v;
+
+        // all the classes share the column, but some of them may not be in the file
+        for (int l = 0; l < (int)hypothesis.columns.size(); ++l)
+        {
+            if (hypothesis.columns[l] >= 0)
+            {
+                _selectedColumn = hypothesis.columns[l];
+                _threshold = hypothesis.thresholds[l];
+                break;
+            }
+        }
+
+        // the same id as load()
+        stringstream thresholdString;
+        thresholdString << _threshold;
+        _id = _pTrainingData->getAttributeNameMap().getNameFromIdx(_selectedColumn) + thresholdString.str();
+    }
         
     // -----------------------------------------------------------------------
         
@@ -122,6 +122,24 @@ namespace MultiBoost {
          * \date 13/11/2005
          */
         virtual void load(nor_utils::StreamTokenizer& st);
+
+        /**
+         * Save the hypothesis into a record of the binary strong hypothesis file.
+         * All the classes share the column and the threshold.
+         * \param hypothesis The record to fill.
+         * \return false for the subclasses, that must be saved in xml.
+         * \see BaseLearner::saveBinary
+         * \date 16/10/2026
+         */
+        virtual bool saveBinary(BinaryHypothesis& hypothesis);
+
+        /**
+         * Load the hypothesis from a record of the binary strong hypothesis file.
+         * \param hypothesis The record, in the index space of the training data.
+         * \see saveBinary
+         * \date 16/10/2026
+         */
+        virtual void loadBinary(const BinaryHypothesis& hypothesis);
                 
         /**
          * Copy all the info we need in classify().
@@ -136,6 +154,9 @@ namespace MultiBoost {
          * \date 25/05/2007
          */
         virtual void subCopyState(BaseLearner *pBaseLearner);
+
+        //! The threshold of the stump: phi is +1 above it, -1 otherwise.
+        FeatureReal getThreshold() const { return _threshold; }
                 
         /**
          * Returns a vector of float holding any data that the specific weak learner can generate
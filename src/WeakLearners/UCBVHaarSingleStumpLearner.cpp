@@ -276,17 +276,33 @@ namespace MultiBoost {
         if (_verbose > 1)
             cout << "Learning type " << pCurrFeature->getName() << ".." << flush;
 
-        // transform the data from intImages to the feature's space
-        pCurrFeature->fillHaarData( _pTrainingData->getExamples(), processedHaarData );
-        //pCurrFeature->fillHaarData(intImages, processedHaarData);
+        // the configuration may have been visited before
+        HaarColumnCache& columnCache = pHaarData->getColumnCache();
+        const bool useCache = columnCache.isEnabled() && !pHaarData->isFiltered();
+        const HaarColumnCache::column* pColumn = 
+            useCache ? columnCache.find( pCurrFeature->getType(), featureIdx ) : NULL;
 
-        // sort the examples in the new space by their coordinate
-        sort( processedHaarData.begin(), processedHaarData.end(), 
-              nor_utils::comparePair<2, int, float, less<float> >() );
+        if ( pColumn == NULL )
+        {
+            // transform the data from intImages to the feature's space
+            if ( pHaarData->preparePixelMajorImages() )
+                pCurrFeature->fillHaarData( pHaarData, processedHaarData, pCurrFeature->getCurrentConfig() );
+            else
+                pCurrFeature->fillHaarData( _pTrainingData->getExamples(), processedHaarData );
+            //pCurrFeature->fillHaarData(intImages, processedHaarData);
+
+            // sort the examples in the new space by their coordinate
+            sort( processedHaarData.begin(), processedHaarData.end(), 
+                  nor_utils::comparePair<2, int, float, less<float> >() );
+
+            if (useCache)
+                columnCache.insert( pCurrFeature->getType(), featureIdx, processedHaarData );
+            pColumn = &processedHaarData;
+        }
 
         // find the optimal threshold
-        tmpThreshold = sAlgo.findSingleThresholdWithInit(processedHaarData.begin(), 
-                                                         processedHaarData.end(), 
+        tmpThreshold = sAlgo.findSingleThresholdWithInit(pColumn->begin(), 
+                                                         pColumn->end(), 
                                                          _pTrainingData, halfTheta, &mu, &tmpV);
 
         tmpEnergy = getEnergy(mu, tmpAlpha, tmpV);
@@ -140,6 +140,7 @@
 
 #include "Defaults.h"
 #include "Utils/Args.h"
+#include "Utils/Utils.h" // for setNumThreads
 
 #include "StrongLearners/GenericStrongLearner.h"
 #include "WeakLearners/BaseLearner.h" // To get the list of the registered weak learners
@@ -150,6 +151,7 @@
 #include "IO/InputData.h" // for --encode
 #include "WeakLearners/ParasiteLearner.h" // for --encode
 #include "StrongLearners/AdaBoostMHLearner.h" // for --encode
+#include "Classifiers/AdaBoostMHClassifier.h" // for --shypconvert
 #include "StrongLearners/SoftCascadeLearner.h" // for declareBaseArguments
 #include "StrongLearners/VJCascadeLearner.h" // for declareBaseArguments
 #include "StrongLearners/ArcGVLearner.h" // for declareBaseArguments
@@ -345,6 +347,7 @@ int main(int argc, const char* argv[])
     args.declareArgument("posteriors", "Output the posteriors for each class, that is the vector-valued discriminant function for the given dataset and model periodically.", 5, "<dataFile> <shypFile> <outFile> <numIters> <period>");    
                 
     args.declareArgument("encode", "Save the coefficient vector of boosting individually on each point using ParasiteLearner", 6, "<inputDataFile> <autoassociativeDataFile> <outputDataFile> <nIterations> <poolFile> <nBaseLearners>");   
+    args.declareArgument("shypconvert", "Convert the strong hypothesis file between xml and binary (the format is the opposite of the input one).", 3, "<dataFile> <shypFile> <outShypFile>");
     args.declareArgument("ssfeatures", "Print matrix data for SingleStump-Based weak learners (if numIters=0 it means all of them).", 4, "<dataFile> <shypFile> <outFile> <numIters>");
         
     args.declareArgument( "fileformat", "Defines the type of intput file. Available types are:\n" 
@@ -413,9 +416,10 @@ int main(int argc, const char* argv[])
         
     args.declareArgument("verbose", "Set the verbose level 0, 1 or 2 (0=no messages, 1=default, 2=all messages).", 1, "<val>");
     args.declareArgument("outputinfo", "Output informations on the algorithm performances during training, on file <filename>.", 1, "<filename>");
-    args.declareArgument("outputinfo", "Output specific informations on the algorithm performances during training, on file <filename> <outputlist>. <outputlist> must be a concatenated list of three characters abreviation (ex: err for error, fpr for false positive rate)", 2, "<filename> <outputlist>");
+    args.declareArgument("outputinfo", "Output specific informations on the algorithm performances during training, on file <filename> <outputlist>. <outputlist> must be a concatenated list of three characters abreviation (ex: err for error, fpr for false positive rate). An abreviation followed by a number N is computed every N iterations only (ex: e01auc10). auh is a faster, approximate auc", 2, "<filename> <outputlist>");
 
     args.declareArgument("seed", "Defines the seed for the random operations.", 1, "<seedval>");
+    args.declareArgument("threads", "Defines the number of threads used by the parallel parts of the algorithms (default: 1).", 1, "<num>");
         
     //////////////////////////////////////////////////////////////////////////
     // Shows the list of available learners
@@ -504,6 +508,10 @@ int main(int argc, const char* argv[])
         unsigned int seed = args.getValue<unsigned int>("seed", 0);
         srand(seed);
     }
+
+    // defines the number of threads
+    if (args.hasArgument("threads"))
+        nor_utils::setNumThreads( args.getValue<int>("threads", 0) );
         
     //////////////////////////////////////////////////////////////////////////////////////////  
     //////////////////////////////////////////////////////////////////////////////////////////
@@ -574,6 +582,18 @@ int main(int argc, const char* argv[])
     }   
     //////////////////////////////////////////////////////////////////////////////////////////
     //////////////////////////////////////////////////////////////////////////////////////////
+    else if ( args.hasArgument("shypconvert") )
+    {
+        // -shypconvert <dataFile> <shypFile> <outShypFile>
+        string dataFileName = args.getValue<string>("shypconvert", 0);
+        string shypFileName = args.getValue<string>("shypconvert", 1);
+        string outShypFileName = args.getValue<string>("shypconvert", 2);
+
+        AdaBoostMHClassifier classifier(args, verbose);
+        classifier.convertHypotheses(dataFileName, shypFileName, outShypFileName);
+    }
+    //////////////////////////////////////////////////////////////////////////////////////////
+    //////////////////////////////////////////////////////////////////////////////////////////
     else if ( args.hasArgument("ssfeatures") )
     {
         // ONLY for AdaBoostMH classifiers
@@ -602,106 +622,16 @@ int main(int argc, const char* argv[])
         int numIterations = args.getValue<int>("encode", 3);
         string poolFileName = args.getValue<string>("encode", 4);
         int numBaseLearners = args.getValue<int>("encode", 5);
-        string outputInfoFile;
+        const string numBaseLearnersStr = args.getValue<string>("encode", 5);
         const char* tmpArgv1[] = {"bla", // for ParasiteLearner
                                   "--pool",
-                                  args.getValue<string>("encode", 4).c_str(),
-                                  args.getValue<string>("encode", 5).c_str()};
+                                  poolFileName.c_str(),
+                                  numBaseLearnersStr.c_str()};
         args.readArguments(4,tmpArgv1);
                 
-        InputData* pAutoassociativeData = new InputData();
-        pAutoassociativeData->initOptions(args);
-        pAutoassociativeData->load(autoassociativeFileName,IT_TRAIN,verbose);
-                
-        // for the original labels
-        InputData* pLabelsData = new InputData();
-        pLabelsData->initOptions(args);
-        pLabelsData->load(labelsFileName,IT_TRAIN,verbose);
-                
-        // set up all the InputData members identically to pAutoassociativeData
-        EncodeData* pOnePoint = new EncodeData();
-        pOnePoint->initOptions(args);
-        pOnePoint->load(autoassociativeFileName,IT_TRAIN,verbose);
-                
-        const int numExamples = pAutoassociativeData->getNumExamples();
-        BaseLearner* pWeakHypothesisSource = 
-            BaseLearner::RegisteredLearners().getLearner("ParasiteLearner");
-        pWeakHypothesisSource->declareArguments(args);
-                
-        ParasiteLearner* pWeakHypothesis;
-                
-        ofstream outFile(outputFileName.c_str());
-        if (!outFile.is_open())
-        {
-            cerr << "ERROR: Cannot open strong hypothesis file <" << outputFileName << ">!" << endl;
-            exit(1);
-        }
-                
-        for (int i = 0; i < numExamples ; ++i)
-        {
-            vector<float> alphas;
-            alphas.resize(numBaseLearners);
-            fill(alphas.begin(), alphas.end(), 0);
-                        
-            if (verbose >= 1)
-                cout << "--> Encoding example no " << (i+1) << endl;
-            pOnePoint->resetData();
-            pOnePoint->addExample( pAutoassociativeData->getExample(i) );
-            AlphaReal energy = 1;
-                        
-            OutputInfo* pOutInfo = NULL;
-            if ( args.hasArgument("outputinfo") ) 
-            {
-                args.getValue("outputinfo", 0, outputInfoFile);
-                pOutInfo = new OutputInfo(args);
-                pOutInfo->initialize(pOnePoint);
-            }
-                        
-                        
-            for (int t = 0; t < numIterations; ++t)
-            {
-                pWeakHypothesis = (ParasiteLearner*)pWeakHypothesisSource->create();
-                pWeakHypothesis->initLearningOptions(args);
-                pWeakHypothesis->setTrainingData(pOnePoint);
-                energy *= pWeakHypothesis->run();
-                //          if (verbose >= 2)
-                //             cout << "energy = " << energy << endl << flush;
-                AdaBoostMHLearner adaBoostMHLearner;
-                                
-                if (i == 0 && t == 0)
-                {
-                    if ( pWeakHypothesis->getBaseLearners().size() < numBaseLearners )
-                        numBaseLearners = pWeakHypothesis->getBaseLearners().size();
-                    outFile << "%Hidden representation using autoassociative boosting" << endl << endl;
-                    outFile << "@RELATION " << outputFileName << endl << endl;
-                    outFile << "% numBaseLearners" << endl;
-                    for (int j = 0; j < numBaseLearners; ++j) 
-                        outFile << "@ATTRIBUTE " << j << "_" <<
-                            pWeakHypothesis->getBaseLearners()[j]->getId() << " NUMERIC" << endl;
-                    outFile << "@ATTRIBUTE class {" << pLabelsData->getClassMap().getNameFromIdx(0);
-                    for (int l = 1; l < pLabelsData->getClassMap().getNumNames(); ++l)
-                        outFile << ", " << pLabelsData->getClassMap().getNameFromIdx(l);
-                    outFile << "}" << endl<< endl<< "@DATA" << endl;
-                }
-                alphas[pWeakHypothesis->getSelectedIndex()] += 
-                    pWeakHypothesis->getAlpha() * pWeakHypothesis->getSignOfAlpha();
-                if ( pOutInfo )
-                    adaBoostMHLearner.printOutputInfo(pOutInfo, t, pOnePoint, NULL, pWeakHypothesis);
-                adaBoostMHLearner.updateWeights(pOnePoint,pWeakHypothesis);
-            }
-            float sumAlphas = 0;
-            for (int j = 0; j < numBaseLearners; ++j)
-                sumAlphas += alphas[j];
-                        
-            for (int j = 0; j < numBaseLearners; ++j)
-                outFile << alphas[j]/sumAlphas << ",";
-            const vector<Label>& labels = pLabelsData->getLabels(i);
-            for (int l = 0; l < labels.size(); ++l)
-                if (labels[l].y > 0)
-                    outFile << pLabelsData->getClassMap().getNameFromIdx(labels[l].idx) << endl;
-            delete pOutInfo;
-        }
-        outFile.close();
+        DataEncoder encoder(args, verbose);
+        encoder.encode(labelsFileName, autoassociativeFileName, outputFileName, 
+                       numIterations, numBaseLearners);
     }
         
     if (pModel)